@@ -0,0 +1,176 @@
+/**
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "orc/OrcFile.hh"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <list>
+#include <string>
+#include <vector>
+
+namespace {
+
+  class BufferOutputStream : public orc::OutputStream {
+   public:
+    uint64_t getLength() const override {
+      return buffer.size();
+    }
+
+    uint64_t getNaturalWriteSize() const override {
+      return 128 * 1024;
+    }
+
+    void write(const void* buf, size_t length) override {
+      const char* chars = static_cast<const char*>(buf);
+      buffer.insert(buffer.end(), chars, chars + length);
+    }
+
+    const std::string& getName() const override {
+      return name;
+    }
+
+    void close() override {}
+
+    std::vector<char> buffer;
+
+   private:
+    const std::string name = "BufferOutputStream";
+  };
+
+  class BufferInputStream : public orc::InputStream {
+   public:
+    explicit BufferInputStream(const std::vector<char>& _buffer) : buffer(_buffer) {}
+
+    uint64_t getLength() const override {
+      return buffer.size();
+    }
+
+    uint64_t getNaturalReadSize() const override {
+      return 128 * 1024;
+    }
+
+    void read(void* buf, uint64_t length, uint64_t offset) override {
+      memcpy(buf, buffer.data() + offset, length);
+    }
+
+    const std::string& getName() const override {
+      return name;
+    }
+
+   private:
+    const std::vector<char>& buffer;
+    const std::string name = "BufferInputStream";
+  };
+
+  const std::vector<std::string> COLUMN_TYPES = {"boolean", "tinyint", "smallint", "int",
+                                                 "bigint",  "date",    "float",    "double"};
+
+  // write one column per type, with every tenth value null if withNulls
+  std::vector<char> writeFile(uint64_t rows, const orc::FileVersion& version, bool withNulls) {
+    std::string typeStr = "struct<";
+    for (size_t col = 0; col != COLUMN_TYPES.size(); ++col) {
+      typeStr += (col ? ",c" : "c") + std::to_string(col) + ":" + COLUMN_TYPES[col];
+    }
+    std::unique_ptr<orc::Type> type = orc::Type::buildTypeFromString(typeStr + ">");
+
+    BufferOutputStream stream;
+    orc::WriterOptions options;
+    options.setFileVersion(version);
+    options.setCompression(orc::CompressionKind_NONE);
+    auto writer = orc::createWriter(*type, &stream, options);
+    const uint64_t batchSize = 1024;
+    auto batch = writer->createRowBatch(batchSize);
+    auto& structBatch = dynamic_cast<orc::StructVectorBatch&>(*batch);
+    for (uint64_t start = 0; start < rows; start += batchSize) {
+      uint64_t numValues = std::min(batchSize, rows - start);
+      for (size_t col = 0; col != COLUMN_TYPES.size(); ++col) {
+        orc::ColumnVectorBatch* field = structBatch.fields[col];
+        for (uint64_t i = 0; i != numValues; ++i) {
+          uint64_t row = start + i;
+          // short runs mixed with values of a few hundred
+          int64_t value = row % 64 < 8 ? 100 : static_cast<int64_t>((row * 7919) % 1000) - 500;
+          field->notNull[i] = !withNulls || row % 10 != 0;
+          if (auto* longBatch = dynamic_cast<orc::LongVectorBatch*>(field)) {
+            longBatch->data[i] = col == 0 ? (value & 1) : value;
+          } else {
+            dynamic_cast<orc::DoubleVectorBatch&>(*field).data[i] = static_cast<double>(value) / 8;
+          }
+        }
+        field->hasNulls = withNulls;
+        field->numElements = numValues;
+      }
+      structBatch.numElements = numValues;
+      writer->add(*batch);
+    }
+    writer->close();
+    return stream.buffer;
+  }
+
+  // the values per second of reading one column of the file
+  double readColumn(const std::vector<char>& file, uint64_t column, uint64_t iterations) {
+    orc::ReaderOptions readerOptions;
+    auto reader = orc::createReader(std::make_unique<BufferInputStream>(file), readerOptions);
+    orc::RowReaderOptions rowReaderOptions;
+    rowReaderOptions.include(std::list<uint64_t>{column});
+    rowReaderOptions.setUseTightNumericVector(true);
+    uint64_t values = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (uint64_t i = 0; i != iterations; ++i) {
+      auto rowReader = reader->createRowReader(rowReaderOptions);
+      auto batch = rowReader->createRowBatch(1024);
+      while (rowReader->next(*batch)) {
+        values += batch->numElements;
+      }
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    return static_cast<double>(values) / elapsed.count();
+  }
+
+}  // namespace
+
+/**
+ * Measures the decode throughput of the numeric column readers for every
+ * numeric type, with RLE version 1 (file version 0.11) and 2 (file version
+ * 0.12) and with and without nulls.
+ *
+ * Usage: column-reader-benchmark [rows] [iterations]
+ */
+int main(int argc, char* argv[]) {
+  const uint64_t rows = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+  const uint64_t iterations = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 10;
+
+  std::cout << std::left << std::setw(10) << "type" << std::setw(6) << "rle" << std::setw(8)
+            << "nulls" << "M values/s" << std::endl;
+  for (uint32_t minor : {11, 12}) {
+    for (bool withNulls : {false, true}) {
+      std::vector<char> file = writeFile(rows, orc::FileVersion(0, minor), withNulls);
+      for (size_t col = 0; col != COLUMN_TYPES.size(); ++col) {
+        double throughput = readColumn(file, col, iterations);
+        std::cout << std::setw(10) << COLUMN_TYPES[col] << std::setw(6)
+                  << (minor == 11 ? "v1" : "v2") << std::setw(8) << (withNulls ? "yes" : "no")
+                  << std::fixed << std::setprecision(1) << throughput / 1e6 << std::endl;
+      }
+    }
+  }
+  return 0;
+}
@@ -0,0 +1,109 @@
+/**
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "orc/sargs/SearchArgument.hh"
+#include "sargs/SargsApplier.hh"
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+
+/**
+ * Measures SargsApplier::pickRowGroups over a stripe with many row groups and
+ * a search argument with many leaves.
+ *
+ * Usage: sargs-benchmark [rowGroups] [columns] [iterations]
+ */
+int main(int argc, char* argv[]) {
+  const uint64_t rowGroups = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 100000;
+  const uint64_t columns = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 16;
+  const uint64_t iterations = argc > 3 ? std::strtoull(argv[3], nullptr, 10) : 10;
+  const uint64_t rowIndexStride = 10000;
+
+  std::ostringstream typeStr;
+  typeStr << "struct<";
+  for (uint64_t col = 0; col != columns; ++col) {
+    typeStr << (col ? "," : "") << "c" << col << ":" << (col % 2 ? "string" : "bigint");
+  }
+  typeStr << ">";
+  std::unique_ptr<orc::Type> type = orc::Type::buildTypeFromString(typeStr.str());
+
+  // every column gets a sorted, non-overlapping range per row group
+  std::unordered_map<uint64_t, orc::proto::RowIndex> rowIndexes;
+  for (uint64_t col = 0; col != columns; ++col) {
+    orc::proto::RowIndex& rowIndex = rowIndexes[col + 1];
+    for (uint64_t rg = 0; rg != rowGroups; ++rg) {
+      orc::proto::ColumnStatistics* stats = rowIndex.add_entry()->mutable_statistics();
+      stats->set_number_of_values(rowIndexStride);
+      stats->set_has_null(false);
+      int64_t min = static_cast<int64_t>(rg * rowIndexStride);
+      int64_t max = min + static_cast<int64_t>(rowIndexStride) - 1;
+      if (col % 2) {
+        auto* strStats = stats->mutable_string_statistics();
+        strStats->set_minimum(std::to_string(min));
+        strStats->set_maximum(std::to_string(max));
+      } else {
+        auto* intStats = stats->mutable_int_statistics();
+        intStats->set_minimum(min);
+        intStats->set_maximum(max);
+      }
+    }
+  }
+
+  // two leaves per column combined with OR, each selecting a handful of row groups
+  auto builder = orc::SearchArgumentFactory::newBuilder();
+  builder->startOr();
+  for (uint64_t col = 0; col != columns; ++col) {
+    std::string name = "c" + std::to_string(col);
+    int64_t value = static_cast<int64_t>((col * 7919 % rowGroups) * rowIndexStride);
+    if (col % 2) {
+      std::string str = std::to_string(value);
+      builder->equals(name, orc::PredicateDataType::STRING, orc::Literal(str.c_str(), str.size()));
+      builder->lessThan(name, orc::PredicateDataType::STRING, orc::Literal("0", 1));
+    } else {
+      builder->equals(name, orc::PredicateDataType::LONG, orc::Literal(value));
+      builder->between(name, orc::PredicateDataType::LONG, orc::Literal(value),
+                       orc::Literal(value + 1));
+    }
+  }
+  builder->end();
+  std::unique_ptr<orc::SearchArgument> sarg = builder->build();
+
+  orc::ReaderMetrics metrics;
+  orc::SargsApplier applier(*type, sarg.get(), rowIndexStride,
+                            orc::WriterVersion::WriterVersion_ORC_135, &metrics);
+  std::map<uint32_t, orc::BloomFilterIndex> bloomFilters;
+
+  auto start = std::chrono::steady_clock::now();
+  for (uint64_t i = 0; i != iterations; ++i) {
+    applier.pickRowGroups(rowGroups * rowIndexStride, rowIndexes, bloomFilters);
+  }
+  auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                     std::chrono::steady_clock::now() - start)
+                     .count();
+
+  std::cout << "row groups: " << rowGroups << ", leaves: " << 2 * columns
+            << ", iterations: " << iterations << "\n"
+            << "selected row groups per stripe: "
+            << metrics.SelectedRowGroupCount.load() / iterations << "\n"
+            << "ns per row group: "
+            << static_cast<double>(elapsed) / static_cast<double>(rowGroups * iterations)
+            << std::endl;
+  return 0;
+}
@@ -0,0 +1,136 @@
+/**
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ORC_ARROW_EXPORT_HH
+#define ORC_ARROW_EXPORT_HH
+
+#include "orc/Reader.hh"
+#include "orc/Type.hh"
+#include "orc/Vector.hh"
+
+#include <cstdint>
+
+/** /file orc/ArrowExport.hh
+    @brief Export of row batches through the Apache Arrow C data interface.
+*/
+
+// The structures of the Arrow C data interface, as defined by
+// https://arrow.apache.org/docs/format/CDataInterface.html. The guard lets
+// this header be included together with arrow/c/abi.h.
+#ifndef ARROW_C_DATA_INTERFACE
+#define ARROW_C_DATA_INTERFACE
+
+#define ARROW_FLAG_DICTIONARY_ORDERED 1
+#define ARROW_FLAG_NULLABLE 2
+#define ARROW_FLAG_MAP_KEYS_SORTED 4
+
+extern "C" {
+
+struct ArrowSchema {
+  // Array type description
+  const char* format;
+  const char* name;
+  const char* metadata;
+  int64_t flags;
+  int64_t n_children;
+  struct ArrowSchema** children;
+  struct ArrowSchema* dictionary;
+
+  // Release callback
+  void (*release)(struct ArrowSchema*);
+  // Opaque producer-specific data
+  void* private_data;
+};
+
+struct ArrowArray {
+  // Array data description
+  int64_t length;
+  int64_t null_count;
+  int64_t offset;
+  int64_t n_buffers;
+  int64_t n_children;
+  const void** buffers;
+  struct ArrowArray** children;
+  struct ArrowArray* dictionary;
+
+  // Release callback
+  void (*release)(struct ArrowArray*);
+  // Opaque producer-specific data
+  void* private_data;
+};
+}
+
+#endif  // ARROW_C_DATA_INTERFACE
+
+namespace orc {
+
+  /**
+   * Export an ORC type as an Arrow schema. The caller owns the schema and
+   * must call its release callback.
+   *
+   * Strings, chars and varchars map to large utf8, binaries to large binary,
+   * lists to large lists, dates to date32, timestamps to nanosecond
+   * timestamps (in UTC for TIMESTAMP_INSTANT), decimals to decimal128 and
+   * unions to dense unions.
+   * @param type the type to export, usually RowReader::getSelectedType()
+   * @param schema the schema to fill
+   * @param dictionaryStrings whether strings, chars and varchars are exported
+   * as dictionary arrays with int32 indices
+   */
+  void exportArrowSchema(const Type& type, ArrowSchema* schema, bool dictionaryStrings = false);
+
+  /**
+   * Export the rows of a batch as an Arrow array matching the schema
+   * exported by exportArrowSchema(). The array does not reference the batch,
+   * so the batch can be reused once the function returns; the dictionaries
+   * of an EncodedStringVectorBatch are shared instead of copied. The buffers
+   * are allocated from the memory pool of the batch, which must outlive the
+   * array. The caller owns the array and must call its release callback.
+   * Throws InvalidArgument for timestamps outside of the years 1677 to 2262
+   * that nanosecond timestamps cover, and for maps and unions whose offsets
+   * do not fit in 32 bits.
+   * @param type the type of the batch
+   * @param batch the rows to export
+   * @param array the array to fill
+   * @param dictionaryStrings whether strings, chars and varchars are exported
+   * as dictionary arrays with int32 indices
+   */
+  void exportArrowArray(const Type& type, const ColumnVectorBatch& batch, ArrowArray* array,
+                        bool dictionaryStrings = false);
+
+  /**
+   * Read the next rows of a row reader and export them as an Arrow array.
+   * Together with exportArrowSchema() on RowReader::getSelectedType(), it
+   * makes the reader produce Arrow arrays. Readers created with
+   * RowReaderOptions::setEnableLazyDecoding() pass the dictionaries of
+   * dictionary encoded stripes through without decoding them when
+   * dictionaryStrings is set.
+   * @param reader the reader to read from
+   * @param batch the batch to read into, created by the reader
+   * @param array the array to fill if rows were read
+   * @param dictionaryStrings whether strings, chars and varchars are exported
+   * as dictionary arrays with int32 indices
+   * @return false if the end of the file was reached, in which case the
+   * array is not filled
+   */
+  bool readArrowArray(RowReader& reader, ColumnVectorBatch& batch, ArrowArray* array,
+                      bool dictionaryStrings = false);
+
+}  // namespace orc
+
+#endif
@@ -35,6 +35,8 @@ namespace orc {
     std::string& buffer;
     bool hasNulls;
     const char* notNull;
+    // the expanded not null flags of batches that use not null bitmaps
+    std::vector<char> notNullBytes;
 
    public:
     ColumnPrinter(std::string&);
@@ -0,0 +1,128 @@
+/**
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ORC_DATASET_INDEX_HH
+#define ORC_DATASET_INDEX_HH
+
+#include "orc/OrcFile.hh"
+#include "orc/sargs/SearchArgument.hh"
+
+#include <string>
+#include <vector>
+
+/** /file orc/DatasetIndex.hh
+    @brief A side-car index to skip files and stripes of a dataset.
+*/
+
+namespace orc {
+
+  /**
+   * A stripe of an indexed file that may contain rows matching a search
+   * argument.
+   */
+  struct DatasetStripe {
+    // index of the file in the dataset index
+    uint64_t fileIndex;
+    // index of the stripe in the file
+    uint64_t stripeIndex;
+    // the start and length of the stripe in the file
+    uint64_t offset;
+    uint64_t length;
+    uint64_t numberOfRows;
+  };
+
+  /**
+   * Collects the file and stripe statistics and the bloom filters of many
+   * ORC files into a single dataset index.
+   */
+  class DatasetIndexBuilder {
+   public:
+    virtual ~DatasetIndexBuilder();
+
+    /**
+     * Add a file to the index. Besides the file tail and the stripe
+     * statistics, the bloom filters of all row groups are read from the file
+     * and copied into the index.
+     * @param fileName the name recorded for the file, usually its path
+     * @param reader the reader of the file
+     */
+    virtual void addFile(const std::string& fileName, const Reader& reader) = 0;
+
+    /**
+     * Get the number of files added to the index.
+     */
+    virtual uint64_t getNumberOfFiles() const = 0;
+
+    /**
+     * Write the index to the stream. The stream is not closed.
+     * @param stream the stream to write to
+     */
+    virtual void write(OutputStream& stream) const = 0;
+  };
+
+  /**
+   * A dataset index read into memory.
+   */
+  class DatasetIndex {
+   public:
+    virtual ~DatasetIndex();
+
+    /**
+     * Get the number of indexed files.
+     */
+    virtual uint64_t getNumberOfFiles() const = 0;
+
+    /**
+     * Get the name of an indexed file.
+     * @param fileIndex the index of the file
+     */
+    virtual const std::string& getFileName(uint64_t fileIndex) const = 0;
+
+    /**
+     * Get the serialized tail of an indexed file. It can be passed to
+     * ReaderOptions::setSerializedFileTail() to open the file without
+     * reading its tail again.
+     * @param fileIndex the index of the file
+     */
+    virtual std::string getSerializedFileTail(uint64_t fileIndex) const = 0;
+
+    /**
+     * Evaluate a search argument against the file statistics, the stripe
+     * statistics and the row group bloom filters of all indexed files.
+     * @param sarg the search argument, with columns referenced by name or by
+     * column id
+     * @return the stripes that may contain matching rows, ordered by file and
+     * stripe
+     */
+    virtual std::vector<DatasetStripe> findStripes(const SearchArgument& sarg) const = 0;
+  };
+
+  /**
+   * Create a builder of a dataset index.
+   */
+  std::unique_ptr<DatasetIndexBuilder> createDatasetIndexBuilder();
+
+  /**
+   * Read a dataset index written by DatasetIndexBuilder::write().
+   * @param stream the stream to read
+   */
+  std::unique_ptr<DatasetIndex> readDatasetIndex(std::unique_ptr<InputStream> stream);
+
+}  // namespace orc
+
+#endif
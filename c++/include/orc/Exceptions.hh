@@ -59,6 +59,17 @@ namespace orc {
     InvalidArgument& operator=(const InvalidArgument&);
   };
 
+  class MemoryLimitExceeded : public std::runtime_error {
+   public:
+    explicit MemoryLimitExceeded(const std::string& what_arg);
+    explicit MemoryLimitExceeded(const char* what_arg);
+    ~MemoryLimitExceeded() noexcept override;
+    MemoryLimitExceeded(const MemoryLimitExceeded&);
+
+   private:
+    MemoryLimitExceeded& operator=(const MemoryLimitExceeded&);
+  };
+
   class SchemaEvolutionError : public std::logic_error {
    public:
     explicit SchemaEvolutionError(const std::string& what_arg);
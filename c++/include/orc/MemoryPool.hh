@@ -35,6 +35,107 @@ namespace orc {
   };
   MemoryPool* getDefaultPool();
 
+  struct CachingMemoryPoolOptions {
+    // smallest size class
+    uint64_t minBlockSize = 4 * 1024;
+    // largest size class; larger allocations are not cached
+    uint64_t maxBlockSize = 64 * 1024 * 1024;
+    // upper bound of the memory kept in the caches, block headers included
+    uint64_t maxCachedBytes = 256 * 1024 * 1024;
+    // back blocks of 2MB or more with transparent huge pages where supported
+    bool useHugePages = false;
+  };
+
+  /**
+   * A memory pool that rounds allocations up to power-of-two size classes and
+   * keeps freed blocks in per-thread caches instead of returning them to the
+   * system. Decompression buffers, stream buffers and dictionaries freed when
+   * a reader moves to the next stripe are then reused by the next stripe, or
+   * by other readers sharing the pool. The block header is not part of the
+   * size class, so a power-of-two request gets a block of its own size.
+   *
+   * A pool passed to a single reader and destroyed with it acts as a reader
+   * scoped arena: all cached memory is released at once when it is destroyed.
+   * All blocks must be freed before the pool is destroyed.
+   */
+  class CachingMemoryPool : public MemoryPool {
+   public:
+    ~CachingMemoryPool() override;
+
+    /**
+     * Get the number of bytes held in the caches. Each cached block counts
+     * with its full allocation, including its header and the slack of its
+     * size class.
+     */
+    virtual uint64_t getCachedBytes() const = 0;
+
+    /**
+     * Return all cached blocks to the system.
+     */
+    virtual void releaseCache() = 0;
+  };
+
+  std::unique_ptr<CachingMemoryPool> createCachingMemoryPool(
+      const CachingMemoryPoolOptions& options = CachingMemoryPoolOptions());
+
+  struct TrackingMemoryPoolOptions {
+    // allocations that would exceed this many bytes throw MemoryLimitExceeded,
+    // 0 for no limit
+    uint64_t limit = 0;
+    // writers flush their current stripe early above this many bytes, 0 to
+    // never flush early
+    uint64_t flushThreshold = 0;
+  };
+
+  /**
+   * A memory pool that records the current and peak bytes allocated through
+   * it and enforces a limit. Readers and writers using a tracking pool also
+   * charge the memory of each column to a per-column pool, and report the
+   * peak bytes in ReaderMetrics and WriterMetrics.
+   *
+   * Tracking pools can be stacked, e.g. one per reader or writer allocating
+   * from a process-wide one, to cap each of them as well as their total.
+   */
+  class TrackingMemoryPool : public MemoryPool {
+   public:
+    ~TrackingMemoryPool() override;
+
+    virtual uint64_t getCurrentBytes() const = 0;
+    virtual uint64_t getPeakBytes() const = 0;
+    virtual uint64_t getLimit() const = 0;
+
+    /**
+     * Get a pool that charges its allocations to the column as well as to
+     * this pool. It lives as long as this pool.
+     * @param columnId the id of the column in the file schema
+     */
+    virtual MemoryPool& getColumnPool(uint64_t columnId) = 0;
+
+    virtual uint64_t getColumnCurrentBytes(uint64_t columnId) const = 0;
+    virtual uint64_t getColumnPeakBytes(uint64_t columnId) const = 0;
+
+    /**
+     * Whether this pool, or a tracking pool it allocates from, is above its
+     * flush threshold.
+     */
+    virtual bool shouldFlush() const = 0;
+  };
+
+  /**
+   * Create a tracking memory pool.
+   * @param options the limit and flush threshold of the pool
+   * @param parent the pool to allocate from
+   */
+  std::unique_ptr<TrackingMemoryPool> createTrackingMemoryPool(
+      const TrackingMemoryPoolOptions& options = TrackingMemoryPoolOptions(),
+      MemoryPool* parent = getDefaultPool());
+
+  /**
+   * Get the pool that a column should allocate from: the column pool of a
+   * tracking pool, or the pool itself otherwise.
+   */
+  MemoryPool& getColumnMemoryPool(MemoryPool& pool, uint64_t columnId);
+
   template <class T>
   class DataBuffer {
    private:
@@ -82,6 +183,27 @@ namespace orc {
 
     void reserve(uint64_t _size);
     void resize(uint64_t _size);
+
+    /**
+     * Reserve room for at least _size elements. Unlike reserve(), the
+     * capacity grows by at least half of the current capacity, so a buffer
+     * that grows a little at a time is reallocated only a logarithmic number
+     * of times.
+     */
+    void reserveWithGrowth(uint64_t _size);
+
+    /**
+     * Resize the buffer without initializing the elements it grows by, for
+     * callers that overwrite all of them. The capacity grows as in
+     * reserveWithGrowth().
+     */
+    void resizeUninitialized(uint64_t _size);
+
+    /**
+     * Release the memory beyond the current size, freeing the buffer if it
+     * is empty.
+     */
+    void shrinkToFit();
   };
 
   // Specializations for char
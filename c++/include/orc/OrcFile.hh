@@ -20,6 +20,7 @@
 #define ORC_FILE_HH
 
 #include <string>
+#include <vector>
 
 #include "orc/Reader.hh"
 #include "orc/Writer.hh"
@@ -151,6 +152,30 @@ namespace orc {
    */
   std::unique_ptr<Writer> createWriter(const Type& type, OutputStream* stream,
                                        const WriterOptions& options);
+
+  /**
+   * Load timezones ahead of reading or writing timestamps, so that the
+   * readers and writers do not parse their files from the timezone directory
+   * ($TZDIR or /usr/share/zoneinfo) on first use. Loaded timezones are shared
+   * by all readers and writers and looked up without locking once a thread
+   * has used them.
+   * @param zoneNames the names of the timezones (eg. America/Los_Angeles)
+   * @throws an exception if a timezone file is missing or corrupt
+   */
+  void preloadTimezones(const std::vector<std::string>& zoneNames);
+
+  /**
+   * Register a timezone from the contents of its TZif file, such as tzdata
+   * embedded in the application. Readers and writers use it instead of the
+   * file in the timezone directory, which need not exist. Registering other
+   * data for the same name replaces the timezone for later lookups, but the
+   * replaced one stays in memory for the readers that still use it.
+   * Registering data that was registered before reuses its timezone.
+   * @param zoneName the name of the timezone (eg. America/Los_Angeles)
+   * @param data the contents of the TZif file
+   * @throws an exception if the data is not a valid TZif file
+   */
+  void registerTimezone(const std::string& zoneName, const std::vector<unsigned char>& data);
 }  // namespace orc
 
 #endif
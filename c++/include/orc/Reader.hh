@@ -59,9 +59,70 @@ namespace orc {
     std::atomic<uint64_t> IOBlockingLatencyUs{0};
     std::atomic<uint64_t> SelectedRowGroupCount{0};
     std::atomic<uint64_t> EvaluatedRowGroupCount{0};
+    // SkippedIndexBytes counts the row index and bloom filter bytes of the
+    // stripes that predicate pushdown left without reading them.
+    std::atomic<uint64_t> SkippedIndexBytes{0};
+    // PeakMemoryBytes is the peak memory of readers whose pool is a
+    // TrackingMemoryPool, 0 otherwise.
+    std::atomic<uint64_t> PeakMemoryBytes{0};
   };
   ReaderMetrics* getDefaultReaderMetrics();
 
+  /**
+   * Caches the parsed tails of files, so that readers opening a file that
+   * was opened before skip reading and parsing its postscript, footer and
+   * stripe statistics. A cache can be shared by all readers of a process.
+   * Files are told apart by their name, their length and the version set by
+   * ReaderOptions::setFileTailCacheVersion(). When the cached tails exceed
+   * the memory limit, the least recently used ones are evicted.
+   */
+  class FileTailCache {
+   public:
+    virtual ~FileTailCache();
+
+    /**
+     * Get the memory the cached tails may use, in serialized bytes.
+     */
+    virtual uint64_t getMemoryLimit() const = 0;
+
+    /**
+     * Get the serialized size of the cached tails.
+     */
+    virtual uint64_t getMemoryUsage() const = 0;
+
+    /**
+     * Get the number of cached tails.
+     */
+    virtual uint64_t getNumberOfEntries() const = 0;
+
+    /**
+     * Get the number of readers that found their file tail in the cache.
+     */
+    virtual uint64_t getNumberOfHits() const = 0;
+
+    /**
+     * Get the number of readers that read their file tail from the file.
+     */
+    virtual uint64_t getNumberOfMisses() const = 0;
+
+    /**
+     * Get the number of tails evicted to stay within the memory limit.
+     */
+    virtual uint64_t getNumberOfEvictions() const = 0;
+
+    /**
+     * Remove all tails from the cache.
+     */
+    virtual void clear() = 0;
+  };
+
+  /**
+   * Create a file tail cache to share between readers.
+   * @param memoryLimit the memory the cached tails may use, in serialized
+   * bytes
+   */
+  std::shared_ptr<FileTailCache> createFileTailCache(uint64_t memoryLimit);
+
   /**
    * Options for creating a Reader.
    */
@@ -113,6 +174,19 @@ namespace orc {
      */
     ReaderOptions& setTailLocation(uint64_t offset);
 
+    /**
+     * Set the cache to look the file tail up in and to add it to after
+     * reading it. It is not used when a serialized file tail is set.
+     */
+    ReaderOptions& setFileTailCache(std::shared_ptr<FileTailCache> cache);
+
+    /**
+     * Set the version of the file that is part of its key in the file tail
+     * cache, such as its modification time or entity tag. Files that are
+     * rewritten in place with the same length must be given a new version.
+     */
+    ReaderOptions& setFileTailCacheVersion(const std::string& version);
+
     /**
      * Get the stream to write warnings or errors to.
      */
@@ -129,6 +203,18 @@ namespace orc {
      */
     uint64_t getTailLocation() const;
 
+    /**
+     * Get the file tail cache.
+     * @return if not set, return nullptr.
+     */
+    std::shared_ptr<FileTailCache> getFileTailCache() const;
+
+    /**
+     * Get the version of the file in the file tail cache.
+     * @return if not set, return the empty string.
+     */
+    std::string getFileTailCacheVersion() const;
+
     /**
      * Get the memory allocator.
      */
@@ -337,6 +423,35 @@ namespace orc {
      */
     bool getUseTightNumericVector() const;
 
+    /**
+     * Set whether strings, chars, varchars and binaries are read into
+     * OffsetStringVectorBatch instead of StringVectorBatch. It takes
+     * precedence over setEnableLazyDecoding(), and is ignored when a read
+     * type is set for schema evolution.
+     */
+    RowReaderOptions& setUseOffsetStringVector(bool useOffsetStringVector);
+
+    /**
+     * Get whether or not to use OffsetStringVectorBatch for strings.
+     * @return if not set, the default is false
+     */
+    bool getUseOffsetStringVector() const;
+
+    /**
+     * Set whether the batches created by the reader keep their not null
+     * flags in ColumnVectorBatch::notNullBitmap with one bit per value
+     * instead of notNull with one byte per value. The bitmaps are read
+     * straight from the PRESENT streams. It is ignored when a read type is
+     * set for schema evolution.
+     */
+    RowReaderOptions& setUseNotNullBitmap(bool useNotNullBitmap);
+
+    /**
+     * Get whether or not batches keep their not null flags in bitmaps.
+     * @return if not set, the default is false
+     */
+    bool getUseNotNullBitmap() const;
+
     /**
      * Set read type for schema evolution
      */
@@ -658,6 +773,44 @@ namespace orc {
      */
     virtual void seekToRow(uint64_t rowNumber) = 0;
   };
+
+  /**
+   * Recycles the row batches of a row reader. A reader that hands batches
+   * to other threads releases them back to the pool once they are consumed,
+   * so that, once the buffers of the batches have grown to their steady-state
+   * sizes, reading does not allocate new batches. It is safe to share between
+   * threads.
+   */
+  class RowBatchPool {
+   public:
+    virtual ~RowBatchPool();
+
+    /**
+     * Get an idle batch, or create a new one if there is none.
+     */
+    virtual std::unique_ptr<ColumnVectorBatch> acquire() = 0;
+
+    /**
+     * Return a batch to the pool. If the pool already holds its maximum
+     * number of idle batches, the batch is freed.
+     */
+    virtual void release(std::unique_ptr<ColumnVectorBatch> batch) = 0;
+
+    /**
+     * Get the number of idle batches held by the pool.
+     */
+    virtual uint64_t getNumberOfIdleBatches() const = 0;
+  };
+
+  /**
+   * Create a pool of the row batches of a row reader. The reader must
+   * outlive the pool.
+   * @param reader the reader that creates the batches
+   * @param batchSize the capacity of the batches
+   * @param maxIdleBatches the maximum number of idle batches held
+   */
+  std::unique_ptr<RowBatchPool> createRowBatchPool(const RowReader& reader, uint64_t batchSize,
+                                                   uint64_t maxIdleBatches = 8);
 }  // namespace orc
 
 #endif
@@ -292,6 +292,33 @@ namespace orc {
      */
     virtual const std::string& getMaximum() const = 0;
 
+    /**
+     * Check whether column has a lower bound, which is the minimum if it
+     * has one and the minimum truncated by the writer otherwise.
+     * @return true if column has a lower bound
+     */
+    virtual bool hasLowerBound() const = 0;
+
+    /**
+     * Check whether column has an upper bound, which is the maximum if it
+     * has one and the maximum truncated and rounded up by the writer
+     * otherwise.
+     * @return true if column has an upper bound
+     */
+    virtual bool hasUpperBound() const = 0;
+
+    /**
+     * Get the lower bound of the values of the column.
+     * @return lower bound
+     */
+    virtual const std::string& getLowerBound() const = 0;
+
+    /**
+     * Get the upper bound of the values of the column.
+     * @return upper bound
+     */
+    virtual const std::string& getUpperBound() const = 0;
+
     /**
      * Get the total length of all values.
      * @return total length of all the values
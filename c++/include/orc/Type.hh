@@ -82,6 +82,17 @@ namespace orc {
                                                               bool encoded,
                                                               bool useTightNumericVector) const = 0;
 
+    /**
+     * Create a row batch for this type.
+     * @param useOffsetStringVector whether strings, chars, varchars and
+     * binaries use OffsetStringVectorBatch; it takes precedence over encoded.
+     * The default implementation ignores it and calls the overload above.
+     */
+    virtual std::unique_ptr<ColumnVectorBatch> createRowBatch(uint64_t size, MemoryPool& pool,
+                                                              bool encoded,
+                                                              bool useTightNumericVector,
+                                                              bool useOffsetStringVector) const;
+
     /**
      * Add a new field to a struct type.
      * @param fieldName the name of the new field
@@ -49,7 +49,52 @@ namespace orc {
     std::atomic<uint64_t> IOCount{0};
     // Record the lantency of IO blocking
     std::atomic<uint64_t> IOBlockingLatencyUs{0};
+    // Record the peak memory of writers whose pool is a TrackingMemoryPool
+    std::atomic<uint64_t> PeakMemoryBytes{0};
+    // Record the number of stripes flushed early by memory pressure
+    std::atomic<uint64_t> EarlyStripeFlushCount{0};
+    // Record the number of stripes flushed at a stripe size scaled down by a
+    // MemoryManager
+    std::atomic<uint64_t> ScaledStripeFlushCount{0};
   };
+  /**
+   * Shares a memory budget between the writers it is set on. When the stripe
+   * sizes of all open writers add up to more than the budget, each writer
+   * scales its stripe size down by the same factor. When the buffered stripes
+   * still exceed the budget, the writers with the largest stripes write them
+   * out early, on their next call to Writer::add(). Writers report the size
+   * of their stripes to the manager every 5000 rows.
+   *
+   * Create instances with createMemoryManager(); writers do not accept other
+   * implementations.
+   */
+  class MemoryManager {
+   public:
+    virtual ~MemoryManager();
+
+    /**
+     * Get the memory budget shared by the writers.
+     */
+    virtual uint64_t getMemoryBudget() const = 0;
+
+    /**
+     * Get the number of open writers.
+     */
+    virtual uint64_t getNumberOfWriters() const = 0;
+
+    /**
+     * Get the sum of the estimated sizes of the stripes buffered by the open
+     * writers.
+     */
+    virtual uint64_t getTotalEstimatedSize() const = 0;
+  };
+
+  /**
+   * Create a memory manager to share between writers.
+   * @param memoryBudget the memory the buffered stripes may use together
+   */
+  std::shared_ptr<MemoryManager> createMemoryManager(uint64_t memoryBudget);
+
   /**
    * Options for creating a Writer.
    */
@@ -275,6 +320,52 @@ namespace orc {
      * @return if not set, return default value which is 1 MB.
      */
     uint64_t getOutputBufferCapacity() const;
+
+    /**
+     * Set the number of rows per page of the zone map, an optional per-page
+     * min/max index of integer, date, string and timestamp columns that lets
+     * readers skip pages inside a selected row group. The value must divide
+     * the row index stride. Zone maps are not part of the ORC specification;
+     * they are written after each stripe footer, outside of the stripe, where
+     * readers that do not know about them never look. Use value 0, the
+     * default, to disable zone maps.
+     */
+    WriterOptions& setZoneMapGranularity(uint64_t rows);
+
+    /**
+     * Get the number of rows per page of the zone map.
+     * @return if not set, return default value which is 0 (disabled).
+     */
+    uint64_t getZoneMapGranularity() const;
+
+    /**
+     * Set the longest string minimum and maximum kept in the statistics of
+     * string, char and varchar columns. Longer ones are truncated between
+     * UTF-8 characters and stored as a lower bound and an upper bound, whose
+     * last character is rounded up, like Java ORC does. Use value 0 to keep
+     * them whole.
+     */
+    WriterOptions& setStringStatisticsMaxLength(uint64_t bytes);
+
+    /**
+     * Get the longest string minimum and maximum kept in the statistics.
+     * @return if not set, return default value which is 0 (no limit).
+     */
+    uint64_t getStringStatisticsMaxLength() const;
+
+    /**
+     * Set the memory manager that sizes the stripes of this writer together
+     * with the other writers sharing it.
+     * @param manager a manager created by createMemoryManager(); other
+     * implementations of MemoryManager throw InvalidArgument
+     */
+    WriterOptions& setMemoryManager(std::shared_ptr<MemoryManager> manager);
+
+    /**
+     * Get the memory manager of the writer.
+     * @return if not set, return nullptr.
+     */
+    std::shared_ptr<MemoryManager> getMemoryManager() const;
   };
 
   class Writer {
@@ -290,6 +381,13 @@ namespace orc {
 
     /**
      * Add a row batch into current writer.
+     *
+     * String columns may be given as an EncodedStringVectorBatch with
+     * isEncoded set, such as the batches read with lazy decoding. When the
+     * column is dictionary encoded, each dictionary id is then looked up in
+     * the dictionary of the writer only once. Entries may be appended to a
+     * dictionary that was already passed to the writer, but existing entries
+     * must not be changed.
      * @param rowsToAdd the row batch data to write.
      */
     virtual void add(ColumnVectorBatch& rowsToAdd) = 0;
@@ -0,0 +1,619 @@
+/**
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "orc/ArrowExport.hh"
+#include "orc/Exceptions.hh"
+
+#include "Adaptor.hh"
+#include "Bitmap.hh"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace orc {
+
+  namespace {
+
+    struct SchemaPrivate {
+      std::string format;
+      std::string name;
+      std::vector<std::unique_ptr<ArrowSchema>> children;
+      std::vector<ArrowSchema*> childPointers;
+      std::unique_ptr<ArrowSchema> dictionary;
+    };
+
+    void releaseSchema(ArrowSchema* schema) {
+      auto* priv = static_cast<SchemaPrivate*>(schema->private_data);
+      for (ArrowSchema* child : priv->childPointers) {
+        if (child->release != nullptr) {
+          child->release(child);
+        }
+      }
+      if (priv->dictionary && priv->dictionary->release != nullptr) {
+        priv->dictionary->release(priv->dictionary.get());
+      }
+      delete priv;
+      schema->release = nullptr;
+    }
+
+    // fill a schema with its format and name and allocate its children
+    SchemaPrivate* initSchema(ArrowSchema* schema, std::string format, const std::string& name,
+                              uint64_t numChildren, int64_t flags = ARROW_FLAG_NULLABLE) {
+      auto* priv = new SchemaPrivate();
+      priv->format = std::move(format);
+      priv->name = name;
+      for (uint64_t i = 0; i < numChildren; ++i) {
+        priv->children.push_back(std::make_unique<ArrowSchema>());
+        priv->childPointers.push_back(priv->children.back().get());
+      }
+      schema->format = priv->format.c_str();
+      schema->name = priv->name.c_str();
+      schema->metadata = nullptr;
+      schema->flags = flags;
+      schema->n_children = static_cast<int64_t>(numChildren);
+      schema->children = numChildren == 0 ? nullptr : priv->childPointers.data();
+      schema->dictionary = nullptr;
+      schema->release = releaseSchema;
+      schema->private_data = priv;
+      return priv;
+    }
+
+    bool isStringKind(TypeKind kind) {
+      return kind == STRING || kind == VARCHAR || kind == CHAR;
+    }
+
+    std::string getFormat(const Type& type) {
+      switch (type.getKind()) {
+        case BOOLEAN:
+          return "b";
+        case BYTE:
+          return "c";
+        case SHORT:
+          return "s";
+        case INT:
+          return "i";
+        case LONG:
+          return "l";
+        case FLOAT:
+          return "f";
+        case DOUBLE:
+          return "g";
+        case STRING:
+        case VARCHAR:
+        case CHAR:
+          return "U";
+        case BINARY:
+          return "Z";
+        case TIMESTAMP:
+          return "tsn:";
+        case TIMESTAMP_INSTANT:
+          return "tsn:UTC";
+        case DATE:
+          return "tdD";
+        case DECIMAL: {
+          uint64_t precision = type.getPrecision() == 0 ? 38 : type.getPrecision();
+          return "d:" + std::to_string(precision) + "," + std::to_string(type.getScale());
+        }
+        case LIST:
+          return "+L";
+        case MAP:
+          return "+m";
+        case STRUCT:
+          return "+s";
+        case UNION: {
+          std::string format = "+ud:";
+          for (uint64_t i = 0; i < type.getSubtypeCount(); ++i) {
+            format += (i == 0 ? "" : ",") + std::to_string(i);
+          }
+          return format;
+        }
+      }
+      throw NotImplementedYet("Arrow export of " + type.toString());
+    }
+
+    void exportSchema(const Type& type, const std::string& name, ArrowSchema* schema,
+                      bool dictionaryStrings) {
+      if (dictionaryStrings && isStringKind(type.getKind())) {
+        SchemaPrivate* priv = initSchema(schema, "i", name, 0);
+        priv->dictionary = std::make_unique<ArrowSchema>();
+        initSchema(priv->dictionary.get(), "U", "", 0);
+        schema->dictionary = priv->dictionary.get();
+        return;
+      }
+      if (type.getKind() == MAP) {
+        // a map is a list of non-nullable key and value structs
+        SchemaPrivate* priv = initSchema(schema, "+m", name, 1);
+        ArrowSchema* entries = priv->childPointers[0];
+        SchemaPrivate* entriesPriv = initSchema(entries, "+s", "entries", 2, 0);
+        exportSchema(*type.getSubtype(0), "key", entriesPriv->childPointers[0], dictionaryStrings);
+        entriesPriv->childPointers[0]->flags = 0;
+        exportSchema(*type.getSubtype(1), "value", entriesPriv->childPointers[1],
+                     dictionaryStrings);
+        return;
+      }
+      SchemaPrivate* priv = initSchema(schema, getFormat(type), name, type.getSubtypeCount());
+      for (uint64_t i = 0; i < type.getSubtypeCount(); ++i) {
+        std::string childName = type.getKind() == STRUCT ? type.getFieldName(i)
+                                : type.getKind() == LIST ? "item"
+                                                         : std::to_string(i);
+        exportSchema(*type.getSubtype(i), childName, priv->childPointers[i], dictionaryStrings);
+      }
+    }
+
+    struct ArrayPrivate {
+      std::vector<std::unique_ptr<DataBuffer<char>>> buffers;
+      std::vector<const void*> bufferPointers;
+      std::vector<std::unique_ptr<ArrowArray>> children;
+      std::vector<ArrowArray*> childPointers;
+      std::unique_ptr<ArrowArray> dictionary;
+      // keeps the dictionary of an EncodedStringVectorBatch alive
+      std::shared_ptr<StringDictionary> stringDictionary;
+    };
+
+    void releaseArray(ArrowArray* array) {
+      auto* priv = static_cast<ArrayPrivate*>(array->private_data);
+      for (ArrowArray* child : priv->childPointers) {
+        if (child->release != nullptr) {
+          child->release(child);
+        }
+      }
+      if (priv->dictionary && priv->dictionary->release != nullptr) {
+        priv->dictionary->release(priv->dictionary.get());
+      }
+      delete priv;
+      array->release = nullptr;
+    }
+
+    // fill an array with its length and allocate its buffer slots and children
+    ArrayPrivate* initArray(ArrowArray* array, uint64_t length, uint64_t numBuffers,
+                            uint64_t numChildren) {
+      auto* priv = new ArrayPrivate();
+      priv->bufferPointers.resize(numBuffers, nullptr);
+      for (uint64_t i = 0; i < numChildren; ++i) {
+        priv->children.push_back(std::make_unique<ArrowArray>());
+        priv->childPointers.push_back(priv->children.back().get());
+        priv->children.back()->release = nullptr;
+      }
+      array->length = static_cast<int64_t>(length);
+      array->null_count = 0;
+      array->offset = 0;
+      array->n_buffers = static_cast<int64_t>(numBuffers);
+      array->n_children = static_cast<int64_t>(numChildren);
+      array->buffers = priv->bufferPointers.data();
+      array->children = numChildren == 0 ? nullptr : priv->childPointers.data();
+      array->dictionary = nullptr;
+      array->release = releaseArray;
+      array->private_data = priv;
+      return priv;
+    }
+
+    // throw if an offset does not fit the 32-bit offsets of maps and unions
+    void checkOffset(int64_t offset, const std::string& what) {
+      if (offset > std::numeric_limits<int32_t>::max()) {
+        throw InvalidArgument("Too many " + what + " for the 32-bit offsets of Arrow: " +
+                              std::to_string(offset));
+      }
+    }
+
+    class ArrowArrayExporter {
+     public:
+      ArrowArrayExporter(MemoryPool& _pool, bool _dictionaryStrings)
+          : pool(_pool), dictionaryStrings(_dictionaryStrings) {}
+
+      void exportArray(const Type& type, const ColumnVectorBatch& batch, ArrowArray* array);
+
+     private:
+      template <typename T>
+      T* addBuffer(ArrayPrivate& priv, uint64_t slot, uint64_t count) {
+        // allocate at least one byte so that the pointer is never null
+        uint64_t bytes = std::max<uint64_t>(1, count * sizeof(T));
+        priv.buffers.push_back(std::make_unique<DataBuffer<char>>(pool, 0));
+        priv.buffers.back()->resizeUninitialized(bytes);
+        priv.bufferPointers[slot] = priv.buffers.back()->data();
+        return reinterpret_cast<T*>(priv.buffers.back()->data());
+      }
+
+      void exportValidity(const ColumnVectorBatch& batch, ArrayPrivate& priv, ArrowArray* array);
+      void exportBooleans(const ColumnVectorBatch& batch, ArrayPrivate& priv);
+      template <typename T>
+      void exportIntegers(const ColumnVectorBatch& batch, ArrayPrivate& priv);
+      template <typename T>
+      void exportFloats(const ColumnVectorBatch& batch, ArrayPrivate& priv);
+      void exportStrings(const ColumnVectorBatch& batch, ArrayPrivate& priv);
+      void exportOffsetStrings(const OffsetStringVectorBatch& batch, ArrayPrivate& priv);
+      void exportDictionary(const ColumnVectorBatch& batch, ArrayPrivate& priv,
+                            ArrowArray* array);
+      void exportTimestamps(const ColumnVectorBatch& batch, ArrayPrivate& priv);
+      void exportDecimals(const ColumnVectorBatch& batch, ArrayPrivate& priv);
+
+      MemoryPool& pool;
+      const bool dictionaryStrings;
+    };
+
+    void ArrowArrayExporter::exportValidity(const ColumnVectorBatch& batch, ArrayPrivate& priv,
+                                            ArrowArray* array) {
+      if (!batch.hasNulls) {
+        return;
+      }
+      uint64_t numElements = batch.numElements;
+      uint8_t* bitmap = addBuffer<uint8_t>(priv, 0, (numElements + 7) / 8);
+      if (batch.useNotNullBitmap) {
+        // the bits are already in the order of Arrow, copy them a byte at a
+        // time to be independent of the byte order of the words
+        const uint64_t* words = batch.notNullBitmap.data();
+        for (uint64_t i = 0; i < (numElements + 7) / 8; ++i) {
+          bitmap[i] = static_cast<uint8_t>(words[i / 8] >> (8 * (i % 8)));
+        }
+        array->null_count =
+            static_cast<int64_t>(numElements - countSetBits(words, 0, numElements));
+        return;
+      }
+      memset(bitmap, 0, (numElements + 7) / 8);
+      const char* notNull = batch.notNull.data();
+      int64_t nullCount = 0;
+      for (uint64_t i = 0; i < numElements; ++i) {
+        if (notNull[i]) {
+          bitmap[i / 8] = static_cast<uint8_t>(bitmap[i / 8] | (1 << (i % 8)));
+        } else {
+          ++nullCount;
+        }
+      }
+      array->null_count = nullCount;
+    }
+
+    void ArrowArrayExporter::exportBooleans(const ColumnVectorBatch& batch, ArrayPrivate& priv) {
+      uint64_t numElements = batch.numElements;
+      uint8_t* bitmap = addBuffer<uint8_t>(priv, 1, (numElements + 7) / 8);
+      memset(bitmap, 0, (numElements + 7) / 8);
+      auto setBits = [&](const auto* values) {
+        for (uint64_t i = 0; i < numElements; ++i) {
+          if (values[i]) {
+            bitmap[i / 8] = static_cast<uint8_t>(bitmap[i / 8] | (1 << (i % 8)));
+          }
+        }
+      };
+      if (auto* bytes = dynamic_cast<const ByteVectorBatch*>(&batch)) {
+        setBits(bytes->data.data());
+      } else {
+        setBits(dynamic_cast<const LongVectorBatch&>(batch).data.data());
+      }
+    }
+
+    template <typename T>
+    void ArrowArrayExporter::exportIntegers(const ColumnVectorBatch& batch, ArrayPrivate& priv) {
+      uint64_t numElements = batch.numElements;
+      T* values = addBuffer<T>(priv, 1, numElements);
+      // batches of readers that use tight numeric vectors have the exact type
+      if (auto* tight = dynamic_cast<const IntegerVectorBatch<T>*>(&batch)) {
+        memcpy(values, tight->data.data(), numElements * sizeof(T));
+      } else {
+        const int64_t* longs = dynamic_cast<const LongVectorBatch&>(batch).data.data();
+        for (uint64_t i = 0; i < numElements; ++i) {
+          values[i] = static_cast<T>(longs[i]);
+        }
+      }
+    }
+
+    template <typename T>
+    void ArrowArrayExporter::exportFloats(const ColumnVectorBatch& batch, ArrayPrivate& priv) {
+      uint64_t numElements = batch.numElements;
+      T* values = addBuffer<T>(priv, 1, numElements);
+      if (auto* tight = dynamic_cast<const FloatingVectorBatch<T>*>(&batch)) {
+        memcpy(values, tight->data.data(), numElements * sizeof(T));
+      } else {
+        const double* doubles = dynamic_cast<const DoubleVectorBatch&>(batch).data.data();
+        for (uint64_t i = 0; i < numElements; ++i) {
+          values[i] = static_cast<T>(doubles[i]);
+        }
+      }
+    }
+
+    void ArrowArrayExporter::exportOffsetStrings(const OffsetStringVectorBatch& batch,
+                                                 ArrayPrivate& priv) {
+      // the layout matches, so both buffers are copied in one go
+      uint64_t numElements = batch.numElements;
+      int64_t* offsets = addBuffer<int64_t>(priv, 1, numElements + 1);
+      memcpy(offsets, batch.offsets.data(), (numElements + 1) * sizeof(int64_t));
+      uint64_t dataLength = static_cast<uint64_t>(offsets[numElements] - offsets[0]);
+      char* data = addBuffer<char>(priv, 2, dataLength);
+      memcpy(data, batch.blob.data() + offsets[0], dataLength);
+      if (offsets[0] != 0) {
+        for (uint64_t i = 0; i <= numElements; ++i) {
+          offsets[i] -= batch.offsets[0];
+        }
+      }
+    }
+
+    void ArrowArrayExporter::exportStrings(const ColumnVectorBatch& rowBatch, ArrayPrivate& priv) {
+      if (auto* offsetBatch = dynamic_cast<const OffsetStringVectorBatch*>(&rowBatch)) {
+        exportOffsetStrings(*offsetBatch, priv);
+        return;
+      }
+      const auto& batch = dynamic_cast<const StringVectorBatch&>(rowBatch);
+      uint64_t numElements = batch.numElements;
+      int64_t* offsets = addBuffer<int64_t>(priv, 1, numElements + 1);
+      auto* encoded = batch.isEncoded ? dynamic_cast<const EncodedStringVectorBatch*>(&batch)
+                                      : nullptr;
+      const int64_t* dictionaryOffsets =
+          encoded ? encoded->dictionary->dictionaryOffset.data() : nullptr;
+
+      offsets[0] = 0;
+      for (uint64_t i = 0; i < numElements; ++i) {
+        int64_t length = 0;
+        if (batch.isNotNull(i)) {
+          length = encoded ? dictionaryOffsets[encoded->index[i] + 1] -
+                                 dictionaryOffsets[encoded->index[i]]
+                           : batch.length[i];
+        }
+        offsets[i + 1] = offsets[i] + length;
+      }
+
+      char* data = addBuffer<char>(priv, 2, static_cast<uint64_t>(offsets[numElements]));
+      for (uint64_t i = 0; i < numElements; ++i) {
+        uint64_t length = static_cast<uint64_t>(offsets[i + 1] - offsets[i]);
+        if (length > 0) {
+          const char* value = encoded ? encoded->dictionary->dictionaryBlob.data() +
+                                            dictionaryOffsets[encoded->index[i]]
+                                      : batch.data[i];
+          memcpy(data + offsets[i], value, length);
+        }
+      }
+    }
+
+    void ArrowArrayExporter::exportDictionary(const ColumnVectorBatch& batch, ArrayPrivate& priv,
+                                              ArrowArray* array) {
+      uint64_t numElements = batch.numElements;
+      int32_t* indexes = addBuffer<int32_t>(priv, 1, numElements);
+      priv.dictionary = std::make_unique<ArrowArray>();
+      array->dictionary = priv.dictionary.get();
+
+      auto* encoded = batch.isEncoded ? dynamic_cast<const EncodedStringVectorBatch*>(&batch)
+                                      : nullptr;
+      if (encoded) {
+        // share the dictionary of the stripe instead of copying it
+        memcpy(indexes, encoded->index.data(), numElements * sizeof(int32_t));
+        for (uint64_t i = 0; batch.hasNulls && i < numElements; ++i) {
+          if (!batch.isNotNull(i)) {
+            indexes[i] = 0;
+          }
+        }
+        const std::shared_ptr<StringDictionary>& dictionary = encoded->dictionary;
+        uint64_t dictionarySize = dictionary->dictionaryOffset.size() - 1;
+        ArrayPrivate* dictionaryPriv = initArray(array->dictionary, dictionarySize, 3, 0);
+        dictionaryPriv->stringDictionary = dictionary;
+        dictionaryPriv->bufferPointers[1] = dictionary->dictionaryOffset.data();
+        dictionaryPriv->bufferPointers[2] = dictionary->dictionaryBlob.data();
+        return;
+      }
+
+      // a direct encoded batch is its own dictionary
+      for (uint64_t i = 0; i < numElements; ++i) {
+        indexes[i] = static_cast<int32_t>(i);
+      }
+      ArrayPrivate* dictionaryPriv = initArray(array->dictionary, numElements, 3, 0);
+      exportStrings(batch, *dictionaryPriv);
+    }
+
+    void ArrowArrayExporter::exportTimestamps(const ColumnVectorBatch& batch,
+                                              ArrayPrivate& priv) {
+      const auto& timestamps = dynamic_cast<const TimestampVectorBatch&>(batch);
+      uint64_t numElements = batch.numElements;
+      int64_t* values = addBuffer<int64_t>(priv, 1, numElements);
+      for (uint64_t i = 0; i < numElements; ++i) {
+        int64_t seconds = timestamps.data[i];
+        int64_t nanos = timestamps.nanoseconds[i];
+        if (seconds < 0 && nanos > 0) {
+          // keep the earliest second of the range representable
+          seconds += 1;
+          nanos -= 1000000000;
+        }
+        if (!multiplyExact(seconds, 1000000000, &values[i]) ||
+            !addExact(values[i], nanos, &values[i])) {
+          if (batch.hasNulls && !batch.isNotNull(i)) {
+            values[i] = 0;
+            continue;
+          }
+          throw InvalidArgument("Timestamp " + std::to_string(timestamps.data[i]) +
+                                " is out of the range of Arrow nanosecond timestamps");
+        }
+      }
+    }
+
+    void ArrowArrayExporter::exportDecimals(const ColumnVectorBatch& batch, ArrayPrivate& priv) {
+      uint64_t numElements = batch.numElements;
+      // little endian 128-bit two's complement values
+      uint64_t* values = addBuffer<uint64_t>(priv, 1, 2 * numElements);
+      if (auto* decimal64s = dynamic_cast<const Decimal64VectorBatch*>(&batch)) {
+        for (uint64_t i = 0; i < numElements; ++i) {
+          values[2 * i] = static_cast<uint64_t>(decimal64s->values[i]);
+          values[2 * i + 1] = decimal64s->values[i] < 0 ? ~0ULL : 0;
+        }
+      } else {
+        const auto& decimals = dynamic_cast<const Decimal128VectorBatch&>(batch);
+        for (uint64_t i = 0; i < numElements; ++i) {
+          values[2 * i] = decimals.values[i].getLowBits();
+          values[2 * i + 1] = static_cast<uint64_t>(decimals.values[i].getHighBits());
+        }
+      }
+    }
+
+    void ArrowArrayExporter::exportArray(const Type& type, const ColumnVectorBatch& batch,
+                                         ArrowArray* array) {
+      uint64_t numElements = batch.numElements;
+      switch (type.getKind()) {
+        case BOOLEAN: {
+          ArrayPrivate* priv = initArray(array, numElements, 2, 0);
+          exportValidity(batch, *priv, array);
+          exportBooleans(batch, *priv);
+          break;
+        }
+        case BYTE: {
+          ArrayPrivate* priv = initArray(array, numElements, 2, 0);
+          exportValidity(batch, *priv, array);
+          exportIntegers<int8_t>(batch, *priv);
+          break;
+        }
+        case SHORT: {
+          ArrayPrivate* priv = initArray(array, numElements, 2, 0);
+          exportValidity(batch, *priv, array);
+          exportIntegers<int16_t>(batch, *priv);
+          break;
+        }
+        case INT:
+        case DATE: {
+          ArrayPrivate* priv = initArray(array, numElements, 2, 0);
+          exportValidity(batch, *priv, array);
+          exportIntegers<int32_t>(batch, *priv);
+          break;
+        }
+        case LONG: {
+          ArrayPrivate* priv = initArray(array, numElements, 2, 0);
+          exportValidity(batch, *priv, array);
+          exportIntegers<int64_t>(batch, *priv);
+          break;
+        }
+        case FLOAT: {
+          ArrayPrivate* priv = initArray(array, numElements, 2, 0);
+          exportValidity(batch, *priv, array);
+          exportFloats<float>(batch, *priv);
+          break;
+        }
+        case DOUBLE: {
+          ArrayPrivate* priv = initArray(array, numElements, 2, 0);
+          exportValidity(batch, *priv, array);
+          exportFloats<double>(batch, *priv);
+          break;
+        }
+        case STRING:
+        case VARCHAR:
+        case CHAR:
+        case BINARY: {
+          if (dictionaryStrings && type.getKind() != BINARY) {
+            ArrayPrivate* priv = initArray(array, numElements, 2, 0);
+            exportValidity(batch, *priv, array);
+            exportDictionary(batch, *priv, array);
+          } else {
+            ArrayPrivate* priv = initArray(array, numElements, 3, 0);
+            exportValidity(batch, *priv, array);
+            exportStrings(batch, *priv);
+          }
+          break;
+        }
+        case TIMESTAMP:
+        case TIMESTAMP_INSTANT: {
+          ArrayPrivate* priv = initArray(array, numElements, 2, 0);
+          exportValidity(batch, *priv, array);
+          exportTimestamps(batch, *priv);
+          break;
+        }
+        case DECIMAL: {
+          ArrayPrivate* priv = initArray(array, numElements, 2, 0);
+          exportValidity(batch, *priv, array);
+          exportDecimals(batch, *priv);
+          break;
+        }
+        case STRUCT: {
+          const auto& structs = dynamic_cast<const StructVectorBatch&>(batch);
+          ArrayPrivate* priv = initArray(array, numElements, 1, type.getSubtypeCount());
+          exportValidity(batch, *priv, array);
+          for (uint64_t i = 0; i < type.getSubtypeCount(); ++i) {
+            exportArray(*type.getSubtype(i), *structs.fields[i], priv->childPointers[i]);
+          }
+          break;
+        }
+        case LIST: {
+          const auto& lists = dynamic_cast<const ListVectorBatch&>(batch);
+          ArrayPrivate* priv = initArray(array, numElements, 2, 1);
+          exportValidity(batch, *priv, array);
+          int64_t* offsets = addBuffer<int64_t>(*priv, 1, numElements + 1);
+          memcpy(offsets, lists.offsets.data(), (numElements + 1) * sizeof(int64_t));
+          exportArray(*type.getSubtype(0), *lists.elements, priv->childPointers[0]);
+          break;
+        }
+        case MAP: {
+          const auto& maps = dynamic_cast<const MapVectorBatch&>(batch);
+          ArrayPrivate* priv = initArray(array, numElements, 2, 1);
+          exportValidity(batch, *priv, array);
+          // Arrow maps have 32-bit offsets
+          checkOffset(maps.offsets[numElements], "map entries");
+          int32_t* offsets = addBuffer<int32_t>(*priv, 1, numElements + 1);
+          for (uint64_t i = 0; i <= numElements; ++i) {
+            offsets[i] = static_cast<int32_t>(maps.offsets[i]);
+          }
+          ArrowArray* entries = priv->childPointers[0];
+          ArrayPrivate* entriesPriv = initArray(entries, maps.keys->numElements, 1, 2);
+          exportArray(*type.getSubtype(0), *maps.keys, entriesPriv->childPointers[0]);
+          exportArray(*type.getSubtype(1), *maps.elements, entriesPriv->childPointers[1]);
+          break;
+        }
+        case UNION: {
+          const auto& unions = dynamic_cast<const UnionVectorBatch&>(batch);
+          if (unions.hasNulls) {
+            throw NotImplementedYet("Arrow unions have no validity bitmap to export nulls");
+          }
+          // Arrow unions have no validity bitmap
+          ArrayPrivate* priv = initArray(array, numElements, 2, type.getSubtypeCount());
+          int8_t* typeIds = addBuffer<int8_t>(*priv, 0, numElements);
+          int32_t* offsets = addBuffer<int32_t>(*priv, 1, numElements);
+          for (uint64_t i = 0; i < numElements; ++i) {
+            checkOffset(static_cast<int64_t>(unions.offsets[i]), "union children rows");
+            typeIds[i] = static_cast<int8_t>(unions.tags[i]);
+            offsets[i] = static_cast<int32_t>(unions.offsets[i]);
+          }
+          for (uint64_t i = 0; i < type.getSubtypeCount(); ++i) {
+            exportArray(*type.getSubtype(i), *unions.children[i], priv->childPointers[i]);
+          }
+          break;
+        }
+      }
+    }
+
+  }  // namespace
+
+  void exportArrowSchema(const Type& type, ArrowSchema* schema, bool dictionaryStrings) {
+    exportSchema(type, "", schema, dictionaryStrings);
+  }
+
+  void exportArrowArray(const Type& type, const ColumnVectorBatch& batch, ArrowArray* array,
+                        bool dictionaryStrings) {
+    ArrowArrayExporter exporter(batch.memoryPool, dictionaryStrings);
+    array->release = nullptr;
+    try {
+      exporter.exportArray(type, batch, array);
+    } catch (...) {
+      if (array->release != nullptr) {
+        array->release(array);
+      }
+      throw;
+    }
+  }
+
+  bool readArrowArray(RowReader& reader, ColumnVectorBatch& batch, ArrowArray* array,
+                      bool dictionaryStrings) {
+    if (!reader.next(batch)) {
+      return false;
+    }
+    exportArrowArray(reader.getSelectedType(), batch, array, dictionaryStrings);
+    return true;
+  }
+
+}  // namespace orc
@@ -0,0 +1,118 @@
+/**
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ORC_BITMAP_HH
+#define ORC_BITMAP_HH
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+
+// Helpers for the not null bitmaps of ColumnVectorBatch, which keep the flag
+// of value i in bit i % 64 of word i / 64.
+
+namespace orc {
+
+  // the number of words of a bitmap with the given number of bits
+  inline uint64_t bitmapWords(uint64_t numBits) {
+    return (numBits + 63) / 64;
+  }
+
+  inline uint64_t popcount64(uint64_t word) {
+#if defined(__GNUC__) || defined(__clang__)
+    return static_cast<uint64_t>(__builtin_popcountll(word));
+#else
+    word = word - ((word >> 1) & 0x5555555555555555ULL);
+    word = (word & 0x3333333333333333ULL) + ((word >> 2) & 0x3333333333333333ULL);
+    word = (word + (word >> 4)) & 0x0f0f0f0f0f0f0f0fULL;
+    return (word * 0x0101010101010101ULL) >> 56;
+#endif
+  }
+
+  inline void clearBit(uint64_t* bitmap, uint64_t index) {
+    bitmap[index / 64] &= ~(uint64_t(1) << (index % 64));
+  }
+
+  // set bits [0, numBits) and clear the rest of their last word
+  inline void setAllBits(uint64_t* bitmap, uint64_t numBits) {
+    uint64_t words = bitmapWords(numBits);
+    if (words == 0) {
+      return;
+    }
+    memset(bitmap, 0xff, words * sizeof(uint64_t));
+    if (numBits % 64 != 0) {
+      bitmap[words - 1] = (uint64_t(1) << (numBits % 64)) - 1;
+    }
+  }
+
+  // count the set bits in [offset, offset + numBits) a word at a time
+  inline uint64_t countSetBits(const uint64_t* bitmap, uint64_t offset, uint64_t numBits) {
+    uint64_t count = 0;
+    uint64_t end = offset + numBits;
+    while (offset < end) {
+      uint64_t shift = offset % 64;
+      uint64_t bits = std::min<uint64_t>(64 - shift, end - offset);
+      uint64_t word = bitmap[offset / 64] >> shift;
+      if (bits < 64) {
+        word &= (uint64_t(1) << bits) - 1;
+      }
+      count += popcount64(word);
+      offset += bits;
+    }
+    return count;
+  }
+
+  // expand bits [offset, offset + numBits) to one byte per bit, filling the
+  // bytes of words that are all set or all clear at once
+  inline void expandBits(const uint64_t* bitmap, uint64_t offset, uint64_t numBits, char* bytes) {
+    uint64_t position = 0;
+    while (position < numBits) {
+      uint64_t shift = (offset + position) % 64;
+      uint64_t bits = std::min<uint64_t>(64 - shift, numBits - position);
+      uint64_t mask = bits < 64 ? (uint64_t(1) << bits) - 1 : ~uint64_t(0);
+      uint64_t word = (bitmap[(offset + position) / 64] >> shift) & mask;
+      if (word == mask) {
+        memset(bytes + position, 1, bits);
+      } else if (word == 0) {
+        memset(bytes + position, 0, bits);
+      } else {
+        for (uint64_t i = 0; i < bits; ++i) {
+          bytes[position + i] = static_cast<char>((word >> i) & 1);
+        }
+      }
+      position += bits;
+    }
+  }
+
+  // pack one byte per value into bits [0, numValues), clearing the rest of
+  // their last word
+  inline void packBits(const char* bytes, uint64_t numValues, uint64_t* bitmap) {
+    for (uint64_t w = 0; w < bitmapWords(numValues); ++w) {
+      uint64_t bits = std::min<uint64_t>(64, numValues - w * 64);
+      const char* values = bytes + w * 64;
+      uint64_t word = 0;
+      for (uint64_t i = 0; i < bits; ++i) {
+        word |= static_cast<uint64_t>(values[i] != 0) << i;
+      }
+      bitmap[w] = word;
+    }
+  }
+
+}  // namespace orc
+
+#endif
@@ -21,6 +21,7 @@
 #include <iostream>
 #include <utility>
 
+#include "Bitmap.hh"
 #include "ByteRLE.hh"
 #include "Utils.hh"
 #include "orc/Exceptions.hh"
@@ -309,6 +310,10 @@ namespace orc {
     // PASS
   }
 
+  void ByteRleDecoder::nextBits(uint64_t*, uint64_t) {
+    throw NotImplementedYet("Bitmaps can only be read from boolean RLE streams");
+  }
+
   class ByteRleDecoderImpl : public ByteRleDecoder {
    public:
     ByteRleDecoderImpl(std::unique_ptr<SeekableInputStream> input, ReaderMetrics* metrics);
@@ -520,6 +525,11 @@ namespace orc {
      */
     virtual void next(char* data, uint64_t numValues, char* notNull) override;
 
+    /**
+     * Read a number of values into a bitmap without expanding them.
+     */
+    virtual void nextBits(uint64_t* bitmap, uint64_t numValues) override;
+
    protected:
     size_t remainingBits;
     char lastByte;
@@ -632,6 +642,55 @@ namespace orc {
     }
   }
 
+  // ORC stores the first value of a byte in its most significant bit
+  static inline uint64_t reverseBits(char value) {
+    uint32_t b = static_cast<unsigned char>(value);
+    b = ((b & 0xf0) >> 4) | ((b & 0x0f) << 4);
+    b = ((b & 0xcc) >> 2) | ((b & 0x33) << 2);
+    b = ((b & 0xaa) >> 1) | ((b & 0x55) << 1);
+    return b;
+  }
+
+  void BooleanRleDecoderImpl::nextBits(uint64_t* bitmap, uint64_t numValues) {
+    SCOPED_STOPWATCH(metrics, ByteDecodingLatencyUs, ByteDecodingCall);
+    const uint64_t words = bitmapWords(numValues);
+    memset(bitmap, 0, words * sizeof(uint64_t));
+    uint64_t position = 0;
+
+    // use up any remaining bits
+    while (remainingBits > 0 && position < numValues) {
+      remainingBits -= 1;
+      uint64_t bit = (static_cast<unsigned char>(lastByte) >> remainingBits) & 0x1;
+      bitmap[position / 64] |= bit << (position % 64);
+      position += 1;
+    }
+
+    // copy the following bytes eight values at a time
+    const uint64_t BUFFER_SIZE = 1024;
+    char buffer[BUFFER_SIZE];
+    while (position < numValues) {
+      uint64_t bytesRead = std::min(BUFFER_SIZE, (numValues - position + 7) / 8);
+      ByteRleDecoderImpl::nextInternal(buffer, bytesRead, nullptr);
+      for (uint64_t i = 0; i < bytesRead; ++i, position += 8) {
+        uint64_t bits = reverseBits(buffer[i]);
+        uint64_t shift = position % 64;
+        bitmap[position / 64] |= bits << shift;
+        if (shift > 56 && position / 64 + 1 < words) {
+          bitmap[position / 64 + 1] |= bits >> (64 - shift);
+        }
+      }
+      lastByte = buffer[bytesRead - 1];
+    }
+
+    // keep the values of the last byte that were not requested
+    if (position > numValues) {
+      remainingBits = position - numValues;
+      if (numValues % 64 != 0) {
+        bitmap[words - 1] &= (uint64_t(1) << (numValues % 64)) - 1;
+      }
+    }
+  }
+
   std::unique_ptr<ByteRleDecoder> createBooleanRleDecoder(
       std::unique_ptr<SeekableInputStream> input, ReaderMetrics* metrics) {
     return std::make_unique<BooleanRleDecoderImpl>(std::move(input), metrics);
@@ -83,6 +83,15 @@ namespace orc {
      *    pointer is not null, positions that are false are skipped.
      */
     virtual void next(char* data, uint64_t numValues, char* notNull) = 0;
+
+    /**
+     * Read a number of boolean values as a bitmap, with value i in bit
+     * i % 64 of bitmap[i / 64]. The bits after the last value in its word
+     * are cleared. Only boolean decoders support it.
+     * @param bitmap the words to read into
+     * @param numValues the number of values to read
+     */
+    virtual void nextBits(uint64_t* bitmap, uint64_t numValues);
   };
 
   /**
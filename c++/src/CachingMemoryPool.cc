@@ -0,0 +1,233 @@
+/**
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "orc/Exceptions.hh"
+#include "orc/MemoryPool.hh"
+
+#include "Adaptor.hh"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <mutex>
+#include <vector>
+
+#ifdef HAS_MADV_HUGEPAGE
+#include <sys/mman.h>
+#endif
+
+namespace orc {
+
+  // the header in front of each block, which keeps the payload 16-byte aligned
+  static const uint64_t BLOCK_HEADER_SIZE = 16;
+  // Every size class holds this many bytes beyond its power of two, so that
+  // the 16-byte headers of tracking pools stacked on this one don't push the
+  // power-of-two requests of buffers into the next class.
+  static const uint64_t CLASS_SLACK = 64;
+  // size class recorded for blocks that are not cached
+  static const uint64_t UNCACHED_CLASS = ~static_cast<uint64_t>(0);
+  static const uint64_t HUGE_PAGE_SIZE = 2 * 1024 * 1024;
+  // number of caches; threads are spread over them round robin
+  static const size_t CACHE_COUNT = 8;
+
+  CachingMemoryPool::~CachingMemoryPool() {
+    // PASS
+  }
+
+  class CachingMemoryPoolImpl : public CachingMemoryPool {
+   public:
+    explicit CachingMemoryPoolImpl(const CachingMemoryPoolOptions& options);
+    ~CachingMemoryPoolImpl() override;
+
+    char* malloc(uint64_t size) override;
+    void free(char* p) override;
+
+    uint64_t getCachedBytes() const override {
+      return cachedBytes.load();
+    }
+
+    void releaseCache() override;
+
+   private:
+    struct Cache {
+      std::mutex mutex;
+      // free blocks of each size class
+      std::vector<std::vector<char*>> blocks;
+    };
+
+    uint64_t getBlockSize(uint64_t sizeClass) const {
+      return minBlockSize << sizeClass;
+    }
+
+    // the bytes allocated for a block of a size class, with header and slack
+    uint64_t getAllocationSize(uint64_t sizeClass) const {
+      return BLOCK_HEADER_SIZE + getBlockSize(sizeClass) + CLASS_SLACK;
+    }
+
+    char* allocateBlock(uint64_t blockSize) const;
+    Cache& getCache();
+    char* takeCachedBlock(uint64_t sizeClass);
+
+    uint64_t minBlockSize;
+    uint64_t maxBlockSize;
+    uint64_t maxCachedBytes;
+    bool useHugePages;
+    uint64_t sizeClasses;
+    // the largest request that fits in a size class
+    uint64_t maxClassSize;
+    std::atomic<uint64_t> cachedBytes;
+    Cache caches[CACHE_COUNT];
+  };
+
+  static uint64_t roundUpToPowerOfTwo(uint64_t value) {
+    uint64_t result = 1;
+    while (result < value) {
+      result <<= 1;
+    }
+    return result;
+  }
+
+  CachingMemoryPoolImpl::CachingMemoryPoolImpl(const CachingMemoryPoolOptions& options)
+      : minBlockSize(roundUpToPowerOfTwo(std::max(options.minBlockSize, BLOCK_HEADER_SIZE))),
+        maxBlockSize(options.maxBlockSize),
+        maxCachedBytes(options.maxCachedBytes),
+        useHugePages(options.useHugePages),
+        sizeClasses(0),
+        maxClassSize(0),
+        cachedBytes(0) {
+    if (maxBlockSize < minBlockSize) {
+      throw InvalidArgument("maxBlockSize of a caching memory pool is smaller than minBlockSize");
+    }
+    while (getBlockSize(sizeClasses) <= maxBlockSize) {
+      ++sizeClasses;
+    }
+    maxClassSize = getBlockSize(sizeClasses - 1) + CLASS_SLACK;
+    for (Cache& cache : caches) {
+      cache.blocks.resize(sizeClasses);
+    }
+  }
+
+  CachingMemoryPoolImpl::~CachingMemoryPoolImpl() {
+    releaseCache();
+  }
+
+  char* CachingMemoryPoolImpl::allocateBlock(uint64_t blockSize) const {
+    if (useHugePages && blockSize >= HUGE_PAGE_SIZE) {
+#ifdef HAS_MADV_HUGEPAGE
+      void* block = nullptr;
+      if (posix_memalign(&block, HUGE_PAGE_SIZE, blockSize) != 0) {
+        throw std::bad_alloc();
+      }
+      // only a hint, so a failure leaves the block on regular pages
+      madvise(block, blockSize, MADV_HUGEPAGE);
+      return static_cast<char*>(block);
+#endif
+    }
+    char* block = static_cast<char*>(std::malloc(blockSize));
+    if (block == nullptr) {
+      throw std::bad_alloc();
+    }
+    return block;
+  }
+
+  CachingMemoryPoolImpl::Cache& CachingMemoryPoolImpl::getCache() {
+    static std::atomic<size_t> nextThread{0};
+    thread_local size_t threadIndex = nextThread.fetch_add(1) % CACHE_COUNT;
+    return caches[threadIndex];
+  }
+
+  char* CachingMemoryPoolImpl::takeCachedBlock(uint64_t sizeClass) {
+    if (cachedBytes.load() == 0) {
+      return nullptr;
+    }
+    // look in the cache of this thread first, then in the others
+    Cache* own = &getCache();
+    for (size_t i = 0; i < CACHE_COUNT; ++i) {
+      Cache& cache = i == 0 ? *own : caches[(static_cast<size_t>(own - caches) + i) % CACHE_COUNT];
+      std::lock_guard<std::mutex> lock(cache.mutex);
+      std::vector<char*>& blocks = cache.blocks[sizeClass];
+      if (!blocks.empty()) {
+        char* block = blocks.back();
+        blocks.pop_back();
+        cachedBytes.fetch_sub(getAllocationSize(sizeClass));
+        return block;
+      }
+    }
+    return nullptr;
+  }
+
+  char* CachingMemoryPoolImpl::malloc(uint64_t size) {
+    uint64_t sizeClass = 0;
+    char* block = nullptr;
+    if (size > maxClassSize) {
+      sizeClass = UNCACHED_CLASS;
+      block = allocateBlock(size + BLOCK_HEADER_SIZE);
+    } else {
+      // the classes are sized by their payload and the header comes on top
+      while (getBlockSize(sizeClass) + CLASS_SLACK < size) {
+        ++sizeClass;
+      }
+      block = takeCachedBlock(sizeClass);
+      if (block == nullptr) {
+        block = allocateBlock(getAllocationSize(sizeClass));
+      }
+    }
+    *reinterpret_cast<uint64_t*>(block) = sizeClass;
+    return block + BLOCK_HEADER_SIZE;
+  }
+
+  void CachingMemoryPoolImpl::free(char* p) {
+    if (p == nullptr) {
+      return;
+    }
+    char* block = p - BLOCK_HEADER_SIZE;
+    uint64_t sizeClass = *reinterpret_cast<uint64_t*>(block);
+    if (sizeClass == UNCACHED_CLASS) {
+      std::free(block);
+      return;
+    }
+    uint64_t allocationSize = getAllocationSize(sizeClass);
+    if (cachedBytes.fetch_add(allocationSize) + allocationSize > maxCachedBytes) {
+      cachedBytes.fetch_sub(allocationSize);
+      std::free(block);
+      return;
+    }
+    Cache& cache = getCache();
+    std::lock_guard<std::mutex> lock(cache.mutex);
+    cache.blocks[sizeClass].push_back(block);
+  }
+
+  void CachingMemoryPoolImpl::releaseCache() {
+    for (Cache& cache : caches) {
+      std::lock_guard<std::mutex> lock(cache.mutex);
+      for (uint64_t sizeClass = 0; sizeClass < sizeClasses; ++sizeClass) {
+        for (char* block : cache.blocks[sizeClass]) {
+          cachedBytes.fetch_sub(getAllocationSize(sizeClass));
+          std::free(block);
+        }
+        cache.blocks[sizeClass].clear();
+      }
+    }
+  }
+
+  std::unique_ptr<CachingMemoryPool> createCachingMemoryPool(
+      const CachingMemoryPoolOptions& options) {
+    return std::make_unique<CachingMemoryPoolImpl>(options);
+  }
+
+}  // namespace orc
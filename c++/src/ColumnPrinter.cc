@@ -20,6 +20,7 @@
 #include "orc/orc-config.hh"
 
 #include "Adaptor.hh"
+#include "Bitmap.hh"
 
 #include <time.h>
 #include <limits>
@@ -122,28 +123,42 @@ namespace orc {
     void reset(const ColumnVectorBatch& batch) override;
   };
 
-  class StringColumnPrinter : public ColumnPrinter {
+  // prints the values of a StringVectorBatch or an OffsetStringVectorBatch
+  class BytesColumnPrinter : public ColumnPrinter {
    private:
     const char* const* start;
     const int64_t* length;
+    // set instead of start and length for an OffsetStringVectorBatch
+    const char* blob;
+    const int64_t* offsets;
+
+   protected:
+    const char* getValue(uint64_t rowId) const {
+      return offsets != nullptr ? blob + offsets[rowId] : start[rowId];
+    }
+
+    int64_t getLength(uint64_t rowId) const {
+      return offsets != nullptr ? offsets[rowId + 1] - offsets[rowId] : length[rowId];
+    }
+
+   public:
+    BytesColumnPrinter(std::string&);
+    virtual ~BytesColumnPrinter() override {}
+    void reset(const ColumnVectorBatch& batch) override;
+  };
 
+  class StringColumnPrinter : public BytesColumnPrinter {
    public:
     StringColumnPrinter(std::string&);
     virtual ~StringColumnPrinter() override {}
     void printRow(uint64_t rowId) override;
-    void reset(const ColumnVectorBatch& batch) override;
   };
 
-  class BinaryColumnPrinter : public ColumnPrinter {
-   private:
-    const char* const* start;
-    const int64_t* length;
-
+  class BinaryColumnPrinter : public BytesColumnPrinter {
    public:
     BinaryColumnPrinter(std::string&);
     virtual ~BinaryColumnPrinter() override {}
     void printRow(uint64_t rowId) override;
-    void reset(const ColumnVectorBatch& batch) override;
   };
 
   class ListColumnPrinter : public ColumnPrinter {
@@ -214,7 +229,11 @@ namespace orc {
 
   void ColumnPrinter::reset(const ColumnVectorBatch& batch) {
     hasNulls = batch.hasNulls;
-    if (hasNulls) {
+    if (hasNulls && batch.useNotNullBitmap) {
+      notNullBytes.resize(batch.numElements);
+      expandBits(batch.notNullBitmap.data(), 0, batch.numElements, notNullBytes.data());
+      notNull = notNullBytes.data();
+    } else if (hasNulls) {
       notNull = batch.notNull.data();
     } else {
       notNull = nullptr;
@@ -410,15 +429,26 @@ namespace orc {
     }
   }
 
-  StringColumnPrinter::StringColumnPrinter(std::string& _buffer)
-      : ColumnPrinter(_buffer), start(nullptr), length(nullptr) {
+  BytesColumnPrinter::BytesColumnPrinter(std::string& _buffer)
+      : ColumnPrinter(_buffer), start(nullptr), length(nullptr), blob(nullptr), offsets(nullptr) {
     // PASS
   }
 
-  void StringColumnPrinter::reset(const ColumnVectorBatch& batch) {
+  void BytesColumnPrinter::reset(const ColumnVectorBatch& batch) {
     ColumnPrinter::reset(batch);
-    start = dynamic_cast<const StringVectorBatch&>(batch).data.data();
-    length = dynamic_cast<const StringVectorBatch&>(batch).length.data();
+    if (auto* offsetBatch = dynamic_cast<const OffsetStringVectorBatch*>(&batch)) {
+      blob = offsetBatch->blob.data();
+      offsets = offsetBatch->offsets.data();
+    } else {
+      start = dynamic_cast<const StringVectorBatch&>(batch).data.data();
+      length = dynamic_cast<const StringVectorBatch&>(batch).length.data();
+      blob = nullptr;
+      offsets = nullptr;
+    }
+  }
+
+  StringColumnPrinter::StringColumnPrinter(std::string& _buffer) : BytesColumnPrinter(_buffer) {
+    // PASS
   }
 
   void StringColumnPrinter::printRow(uint64_t rowId) {
@@ -426,8 +456,10 @@ namespace orc {
       writeString(buffer, "null");
     } else {
       writeChar(buffer, '"');
-      for (int64_t i = 0; i < length[rowId]; ++i) {
-        char ch = static_cast<char>(start[rowId][i]);
+      const char* value = getValue(rowId);
+      int64_t valueLength = getLength(rowId);
+      for (int64_t i = 0; i < valueLength; ++i) {
+        char ch = value[i];
         switch (ch) {
           case '\\':
             writeString(buffer, "\\\\");
@@ -625,8 +657,7 @@ namespace orc {
     data = dynamic_cast<const LongVectorBatch&>(batch).data.data();
   }
 
-  BinaryColumnPrinter::BinaryColumnPrinter(std::string& _buffer)
-      : ColumnPrinter(_buffer), start(nullptr), length(nullptr) {
+  BinaryColumnPrinter::BinaryColumnPrinter(std::string& _buffer) : BytesColumnPrinter(_buffer) {
     // PASS
   }
 
@@ -635,23 +666,19 @@ namespace orc {
       writeString(buffer, "null");
     } else {
       writeChar(buffer, '[');
-      for (int64_t i = 0; i < length[rowId]; ++i) {
+      const char* value = getValue(rowId);
+      int64_t valueLength = getLength(rowId);
+      for (int64_t i = 0; i < valueLength; ++i) {
         if (i != 0) {
           writeString(buffer, ", ");
         }
-        const auto numBuffer = std::to_string(static_cast<const int>(start[rowId][i]) & 0xff);
+        const auto numBuffer = std::to_string(static_cast<const int>(value[i]) & 0xff);
         writeString(buffer, numBuffer.c_str());
       }
       writeChar(buffer, ']');
     }
   }
 
-  void BinaryColumnPrinter::reset(const ColumnVectorBatch& batch) {
-    ColumnPrinter::reset(batch);
-    start = dynamic_cast<const StringVectorBatch&>(batch).data.data();
-    length = dynamic_cast<const StringVectorBatch&>(batch).length.data();
-  }
-
   TimestampColumnPrinter::TimestampColumnPrinter(std::string& _buffer)
       : ColumnPrinter(_buffer), seconds(nullptr), nanoseconds(nullptr) {
     // PASS
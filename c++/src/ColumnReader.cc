@@ -19,11 +19,13 @@
 #include "orc/Int128.hh"
 
 #include "Adaptor.hh"
+#include "Bitmap.hh"
 #include "ByteRLE.hh"
 #include "ColumnReader.hh"
 #include "ConvertColumnReader.hh"
 #include "RLE.hh"
 #include "SchemaEvolution.hh"
+#include "TimestampCodec.hh"
 #include "orc/Exceptions.hh"
 
 #include <math.h>
@@ -50,8 +52,9 @@ namespace orc {
 
   ColumnReader::ColumnReader(const Type& type, StripeStreams& stripe)
       : columnId(type.getColumnId()),
-        memoryPool(stripe.getMemoryPool()),
-        metrics(stripe.getReaderMetrics()) {
+        memoryPool(getColumnMemoryPool(stripe.getMemoryPool(), columnId)),
+        metrics(stripe.getReaderMetrics()),
+        notNullBytes(memoryPool) {
     std::unique_ptr<SeekableInputStream> stream =
         stripe.getStream(columnId, proto::Stream_Kind_PRESENT, true);
     if (stream.get()) {
@@ -92,6 +95,23 @@ namespace orc {
     }
     rowBatch.numElements = numValues;
     ByteRleDecoder* decoder = notNullDecoder.get();
+    if (rowBatch.useNotNullBitmap) {
+      uint64_t* bitmap = rowBatch.notNullBitmap.data();
+      if (decoder && !incomingMask) {
+        decoder->nextBits(bitmap, numValues);
+      } else if (decoder) {
+        // the stream only has the values that the parent marks as not null
+        notNullBytes.resize(numValues);
+        decoder->next(notNullBytes.data(), numValues, incomingMask);
+        packBits(notNullBytes.data(), numValues, bitmap);
+      } else if (incomingMask) {
+        packBits(incomingMask, numValues, bitmap);
+      } else {
+        setAllBits(bitmap, numValues);
+      }
+      rowBatch.hasNulls = countSetBits(bitmap, 0, numValues) != numValues;
+      return;
+    }
     if (decoder) {
       char* notNullArray = rowBatch.notNull.data();
       decoder->next(notNullArray, numValues, incomingMask);
@@ -111,6 +131,18 @@ namespace orc {
     rowBatch.hasNulls = false;
   }
 
+  char* ColumnReader::getNotNull(ColumnVectorBatch& rowBatch) {
+    if (!rowBatch.hasNulls) {
+      return nullptr;
+    }
+    if (!rowBatch.useNotNullBitmap) {
+      return rowBatch.notNull.data();
+    }
+    notNullBytes.resize(rowBatch.numElements);
+    expandBits(rowBatch.notNullBitmap.data(), 0, rowBatch.numElements, notNullBytes.data());
+    return notNullBytes.data();
+  }
+
   void ColumnReader::seekToRowGroup(std::unordered_map<uint64_t, PositionProvider>& positions) {
     if (notNullDecoder.get()) {
       notNullDecoder->seek(positions.at(columnId));
@@ -181,7 +213,7 @@ namespace orc {
     // and then expand it in a second pass..
     auto* ptr = dynamic_cast<BatchType&>(rowBatch).data.data();
     rle->next(reinterpret_cast<char*>(ptr), numValues,
-              rowBatch.hasNulls ? rowBatch.notNull.data() : nullptr);
+              getNotNull(rowBatch));
     expandBytesToIntegers(ptr, numValues);
   }
 
@@ -219,7 +251,7 @@ namespace orc {
       // we cheat here and use the long* and then expand it in a second pass.
       auto* ptr = dynamic_cast<BatchType&>(rowBatch).data.data();
       rle->next(reinterpret_cast<char*>(ptr), numValues,
-                rowBatch.hasNulls ? rowBatch.notNull.data() : nullptr);
+                getNotNull(rowBatch));
       expandBytesToIntegers(ptr, numValues);
     }
 
@@ -256,7 +288,7 @@ namespace orc {
     void next(ColumnVectorBatch& rowBatch, uint64_t numValues, char* notNull) override {
       ColumnReader::next(rowBatch, numValues, notNull);
       rle->next(dynamic_cast<BatchType&>(rowBatch).data.data(), numValues,
-                rowBatch.hasNulls ? rowBatch.notNull.data() : nullptr);
+                getNotNull(rowBatch));
     }
 
     void seekToRowGroup(std::unordered_map<uint64_t, PositionProvider>& positions) override {
@@ -273,6 +305,8 @@ namespace orc {
     const Timezone& readerTimezone;
     const int64_t epochOffset;
     const bool sameTimezone;
+    TimezoneVariantCache writerVariants;
+    TimezoneVariantCache readerVariants;
 
    public:
     TimestampColumnReader(const Type& type, StripeStreams& stripe, bool isInstantType);
@@ -291,7 +325,9 @@ namespace orc {
         writerTimezone(isInstantType ? getTimezoneByName("GMT") : stripe.getWriterTimezone()),
         readerTimezone(isInstantType ? getTimezoneByName("GMT") : stripe.getReaderTimezone()),
         epochOffset(writerTimezone.getEpoch()),
-        sameTimezone(&writerTimezone == &readerTimezone) {
+        sameTimezone(&writerTimezone == &readerTimezone),
+        writerVariants(writerTimezone),
+        readerVariants(readerTimezone) {
     RleVersion vers = convertRleVersion(stripe.getEncoding(columnId).kind());
     std::unique_ptr<SeekableInputStream> stream =
         stripe.getStream(columnId, proto::Stream_Kind_DATA, true);
@@ -315,7 +351,7 @@ namespace orc {
 
   void TimestampColumnReader::next(ColumnVectorBatch& rowBatch, uint64_t numValues, char* notNull) {
     ColumnReader::next(rowBatch, numValues, notNull);
-    notNull = rowBatch.hasNulls ? rowBatch.notNull.data() : nullptr;
+    notNull = getNotNull(rowBatch);
     TimestampVectorBatch& timestampBatch = dynamic_cast<TimestampVectorBatch&>(rowBatch);
     int64_t* secsBuffer = timestampBatch.data.data();
     secondsRle->next(secsBuffer, numValues, notNull);
@@ -323,28 +359,24 @@ namespace orc {
     nanoRle->next(nanoBuffer, numValues, notNull);
 
     // Construct the values
+    if (sameTimezone) {
+      decodeTimestamps(secsBuffer, nanoBuffer, epochOffset, notNull, numValues);
+      return;
+    }
+    decodeNanos(nanoBuffer, notNull, numValues);
     for (uint64_t i = 0; i < numValues; i++) {
       if (notNull == nullptr || notNull[i]) {
-        uint64_t zeros = nanoBuffer[i] & 0x7;
-        nanoBuffer[i] >>= 3;
-        if (zeros != 0) {
-          for (uint64_t j = 0; j <= zeros; ++j) {
-            nanoBuffer[i] *= 10;
-          }
-        }
         int64_t writerTime = secsBuffer[i] + epochOffset;
-        if (!sameTimezone) {
-          // adjust timestamp value to same wall clock time if writer and reader
-          // time zones have different rules, which is required for Apache Orc.
-          const auto& wv = writerTimezone.getVariant(writerTime);
-          const auto& rv = readerTimezone.getVariant(writerTime);
-          if (!wv.hasSameTzRule(rv)) {
-            // If the timezone adjustment moves the millis across a DST boundary,
-            // we need to reevaluate the offsets.
-            int64_t adjustedTime = writerTime + wv.gmtOffset - rv.gmtOffset;
-            const auto& adjustedReader = readerTimezone.getVariant(adjustedTime);
-            writerTime = writerTime + wv.gmtOffset - adjustedReader.gmtOffset;
-          }
+        // adjust timestamp value to same wall clock time if writer and reader
+        // time zones have different rules, which is required for Apache Orc.
+        const auto& wv = writerVariants.getVariant(writerTime);
+        const auto& rv = readerVariants.getVariant(writerTime);
+        if (!wv.hasSameTzRule(rv)) {
+          // If the timezone adjustment moves the millis across a DST boundary,
+          // we need to reevaluate the offsets.
+          int64_t adjustedTime = writerTime + wv.gmtOffset - rv.gmtOffset;
+          const auto& adjustedReader = readerVariants.getVariant(adjustedTime);
+          writerTime = writerTime + wv.gmtOffset - adjustedReader.gmtOffset;
         }
         secsBuffer[i] = writerTime;
         if (secsBuffer[i] < 0 && nanoBuffer[i] > 999999) {
@@ -375,7 +407,7 @@ namespace orc {
 
    private:
     std::unique_ptr<SeekableInputStream> inputStream;
-    const uint64_t bytesPerValue = (columnKind == FLOAT) ? 4 : 8;
+    static constexpr uint64_t bytesPerValue = (columnKind == FLOAT) ? 4 : 8;
     const char* bufferPointer;
     const char* bufferEnd;
 
@@ -440,6 +472,8 @@ namespace orc {
       }
       return static_cast<FloatType>(*result);
     }
+
+    void readValues(ValueType* outArray, uint64_t numValues);
   };
 
   template <TypeKind columnKind, bool isLittleEndian, typename ValueType, typename BatchType>
@@ -473,48 +507,63 @@ namespace orc {
     return numValues;
   }
 
+  // Read consecutive values. On little-endian machines the stream already
+  // holds them in the layout of the batch, so they are copied a whole chunk
+  // at a time and only a value split between two chunks is read bytewise.
+  template <TypeKind columnKind, bool isLittleEndian, typename ValueType, typename BatchType>
+  void DoubleColumnReader<columnKind, isLittleEndian, ValueType, BatchType>::readValues(
+      ValueType* outArray, uint64_t numValues) {
+    uint64_t i = 0;
+    while (i < numValues) {
+      uint64_t available = static_cast<uint64_t>(bufferEnd - bufferPointer) / bytesPerValue;
+      if (!isLittleEndian || available == 0) {
+        if constexpr (columnKind == FLOAT) {
+          outArray[i++] = readFloat<ValueType>();
+        } else {
+          outArray[i++] = readDouble<ValueType>();
+        }
+        continue;
+      }
+      uint64_t count = std::min(numValues - i, available);
+      if constexpr (sizeof(ValueType) == bytesPerValue) {
+        memcpy(outArray + i, bufferPointer, count * bytesPerValue);
+      } else {
+        // floats read into a batch of doubles
+        for (uint64_t j = 0; j < count; ++j) {
+          float value;
+          memcpy(&value, bufferPointer + j * bytesPerValue, sizeof(float));
+          outArray[i + j] = value;
+        }
+      }
+      bufferPointer += count * bytesPerValue;
+      i += count;
+    }
+  }
+
   template <TypeKind columnKind, bool isLittleEndian, typename ValueType, typename BatchType>
   void DoubleColumnReader<columnKind, isLittleEndian, ValueType, BatchType>::next(
       ColumnVectorBatch& rowBatch, uint64_t numValues, char* notNull) {
     ColumnReader::next(rowBatch, numValues, notNull);
     // update the notNull from the parent class
-    notNull = rowBatch.hasNulls ? rowBatch.notNull.data() : nullptr;
+    notNull = getNotNull(rowBatch);
     ValueType* outArray =
         reinterpret_cast<ValueType*>(dynamic_cast<BatchType&>(rowBatch).data.data());
 
-    if constexpr (columnKind == FLOAT) {
-      if (notNull) {
-        for (size_t i = 0; i < numValues; ++i) {
-          if (notNull[i]) {
-            outArray[i] = readFloat<ValueType>();
-          }
-        }
-      } else {
-        for (size_t i = 0; i < numValues; ++i) {
-          outArray[i] = readFloat<ValueType>();
-        }
-      }
-    } else {
-      if (notNull) {
-        for (size_t i = 0; i < numValues; ++i) {
-          if (notNull[i]) {
-            outArray[i] = readDouble<ValueType>();
-          }
-        }
-      } else {
-        // Number of values in the buffer that we can copy directly.
-        // Only viable when the machine is little-endian.
-        uint64_t bufferNum = 0;
-        if (isLittleEndian) {
-          bufferNum =
-              std::min(numValues, static_cast<size_t>(bufferEnd - bufferPointer) / bytesPerValue);
-          uint64_t bufferBytes = bufferNum * bytesPerValue;
-          memcpy(outArray, bufferPointer, bufferBytes);
-          bufferPointer += bufferBytes;
-        }
-        for (size_t i = bufferNum; i < numValues; ++i) {
-          outArray[i] = readDouble<ValueType>();
-        }
+    if (!notNull) {
+      readValues(outArray, numValues);
+      return;
+    }
+    // read the non-null values to the front of the batch and then move them
+    // to their rows, back to front so that none is overwritten before it moves
+    uint64_t numNotNull = 0;
+    for (uint64_t i = 0; i < numValues; ++i) {
+      numNotNull += notNull[i] != 0;
+    }
+    readValues(outArray, numNotNull);
+    for (uint64_t i = numValues, j = numNotNull; j > 0;) {
+      --i;
+      if (notNull[i]) {
+        outArray[i] = outArray[--j];
       }
     }
   }
@@ -545,10 +594,31 @@ namespace orc {
     }
   }
 
+  static bool isSameDictionary(const StringDictionary& left, const StringDictionary& right) {
+    return left.dictionaryOffset.size() == right.dictionaryOffset.size() &&
+           left.dictionaryBlob.size() == right.dictionaryBlob.size() &&
+           memcmp(left.dictionaryOffset.data(), right.dictionaryOffset.data(),
+                  left.dictionaryOffset.size() * sizeof(int64_t)) == 0 &&
+           memcmp(left.dictionaryBlob.data(), right.dictionaryBlob.data(),
+                  left.dictionaryBlob.size()) == 0;
+  }
+
   class StringDictionaryColumnReader : public ColumnReader {
    private:
     std::shared_ptr<StringDictionary> dictionary;
     std::unique_ptr<RleDecoder> rle;
+    // the dictionary is read on first use, so that batches that are never
+    // read don't pay for it
+    uint32_t dictSize;
+    std::unique_ptr<RleDecoder> lengthDecoder;
+    std::unique_ptr<SeekableInputStream> blobStream;
+    // the dictionary of the column in the previous stripe, shared when
+    // this stripe has the same one
+    std::shared_ptr<StringDictionary>* sharedDictionary;
+
+    void ensureDictionaryLoaded();
+
+    void nextOffsets(OffsetStringVectorBatch& batch, uint64_t numValues, const char* notNull);
 
    public:
     StringDictionaryColumnReader(const Type& type, StripeStreams& stipe);
@@ -565,9 +635,14 @@ namespace orc {
 
   StringDictionaryColumnReader::StringDictionaryColumnReader(const Type& type,
                                                              StripeStreams& stripe)
-      : ColumnReader(type, stripe), dictionary(new StringDictionary(stripe.getMemoryPool())) {
+      : ColumnReader(type, stripe),
+        dictionary(new StringDictionary(memoryPool)),
+        sharedDictionary(stripe.getSharedDictionary(columnId)) {
     RleVersion rleVersion = convertRleVersion(stripe.getEncoding(columnId).kind());
-    uint32_t dictSize = stripe.getEncoding(columnId).dictionary_size();
+    dictSize = stripe.getEncoding(columnId).dictionary_size();
+    if (dictSize > static_cast<uint32_t>(std::numeric_limits<int32_t>::max())) {
+      throw ParseError("Dictionary too large in StringDictionaryColumn");
+    }
     std::unique_ptr<SeekableInputStream> stream =
         stripe.getStream(columnId, proto::Stream_Kind_DATA, true);
     if (stream == nullptr) {
@@ -578,9 +653,15 @@ namespace orc {
     if (dictSize > 0 && stream == nullptr) {
       throw ParseError("LENGTH stream not found in StringDictionaryColumn");
     }
-    std::unique_ptr<RleDecoder> lengthDecoder =
-        createRleDecoder(std::move(stream), false, rleVersion, memoryPool, metrics);
-    dictionary->dictionaryOffset.resize(dictSize + 1);
+    lengthDecoder = createRleDecoder(std::move(stream), false, rleVersion, memoryPool, metrics);
+    blobStream = stripe.getStream(columnId, proto::Stream_Kind_DICTIONARY_DATA, false);
+  }
+
+  void StringDictionaryColumnReader::ensureDictionaryLoaded() {
+    if (lengthDecoder == nullptr) {
+      return;
+    }
+    dictionary->dictionaryOffset.resizeUninitialized(dictSize + 1);
     int64_t* lengthArray = dictionary->dictionaryOffset.data();
     lengthDecoder->next(lengthArray + 1, dictSize, nullptr);
     lengthArray[0] = 0;
@@ -591,13 +672,21 @@ namespace orc {
       lengthArray[i] += lengthArray[i - 1];
     }
     int64_t blobSize = lengthArray[dictSize];
-    dictionary->dictionaryBlob.resize(static_cast<uint64_t>(blobSize));
-    std::unique_ptr<SeekableInputStream> blobStream =
-        stripe.getStream(columnId, proto::Stream_Kind_DICTIONARY_DATA, false);
+    dictionary->dictionaryBlob.resizeUninitialized(static_cast<uint64_t>(blobSize));
     if (blobSize > 0 && blobStream == nullptr) {
       throw ParseError("DICTIONARY_DATA stream not found in StringDictionaryColumn");
     }
     readFully(dictionary->dictionaryBlob.data(), blobSize, blobStream.get());
+    lengthDecoder.reset();
+    blobStream.reset();
+
+    if (sharedDictionary) {
+      if (*sharedDictionary && isSameDictionary(**sharedDictionary, *dictionary)) {
+        dictionary = *sharedDictionary;
+      } else {
+        *sharedDictionary = dictionary;
+      }
+    }
   }
 
   StringDictionaryColumnReader::~StringDictionaryColumnReader() {
@@ -614,7 +703,12 @@ namespace orc {
                                           char* notNull) {
     ColumnReader::next(rowBatch, numValues, notNull);
     // update the notNull from the parent class
-    notNull = rowBatch.hasNulls ? rowBatch.notNull.data() : nullptr;
+    notNull = getNotNull(rowBatch);
+    ensureDictionaryLoaded();
+    if (auto* offsetBatch = dynamic_cast<OffsetStringVectorBatch*>(&rowBatch)) {
+      nextOffsets(*offsetBatch, numValues, notNull);
+      return;
+    }
     StringVectorBatch& byteBatch = dynamic_cast<StringVectorBatch&>(rowBatch);
     char* blob = dictionary->dictionaryBlob.data();
     int64_t* dictionaryOffsets = dictionary->dictionaryOffset.data();
@@ -645,17 +739,65 @@ namespace orc {
     }
   }
 
+  void StringDictionaryColumnReader::nextOffsets(OffsetStringVectorBatch& batch,
+                                                 uint64_t numValues, const char* notNull) {
+    const int64_t* dictionaryOffsets = dictionary->dictionaryOffset.data();
+    uint64_t dictionaryCount = dictionary->dictionaryOffset.size() - 1;
+    // read the entry ids after the first offset and replace each one with
+    // the end of its value once the value is copied
+    int64_t* offsets = batch.offsets.data();
+    rle->next(offsets + 1, numValues, notNull);
+    offsets[0] = 0;
+    // size the blob once for the whole batch
+    uint64_t totalLength = 0;
+    for (uint64_t i = 0; i < numValues; ++i) {
+      if (!notNull || notNull[i]) {
+        int64_t entry = offsets[i + 1];
+        if (entry < 0 || static_cast<uint64_t>(entry) >= dictionaryCount) {
+          throw ParseError("Entry index out of range in StringDictionaryColumn");
+        }
+        totalLength +=
+            static_cast<uint64_t>(dictionaryOffsets[entry + 1] - dictionaryOffsets[entry]);
+      }
+    }
+    batch.blob.resizeUninitialized(totalLength);
+    char* blob = batch.blob.data();
+    const char* dictionaryBlob = dictionary->dictionaryBlob.data();
+    for (uint64_t i = 0; i < numValues; ++i) {
+      int64_t length = 0;
+      if (!notNull || notNull[i]) {
+        int64_t entry = offsets[i + 1];
+        length = dictionaryOffsets[entry + 1] - dictionaryOffsets[entry];
+        memcpy(blob + offsets[i], dictionaryBlob + dictionaryOffsets[entry],
+               static_cast<size_t>(length));
+      }
+      offsets[i + 1] = offsets[i] + length;
+    }
+  }
+
   void StringDictionaryColumnReader::nextEncoded(ColumnVectorBatch& rowBatch, uint64_t numValues,
                                                  char* notNull) {
+    if (dynamic_cast<EncodedStringVectorBatch*>(&rowBatch) == nullptr) {
+      // batches of other layouts are decoded
+      ColumnReader::nextEncoded(rowBatch, numValues, notNull);
+      return;
+    }
     ColumnReader::next(rowBatch, numValues, notNull);
-    notNull = rowBatch.hasNulls ? rowBatch.notNull.data() : nullptr;
+    notNull = getNotNull(rowBatch);
     rowBatch.isEncoded = true;
 
     EncodedStringVectorBatch& batch = dynamic_cast<EncodedStringVectorBatch&>(rowBatch);
+    ensureDictionaryLoaded();
     batch.dictionary = this->dictionary;
 
-    // Length buffer is reused to save dictionary entry ids
-    rle->next(batch.index.data(), numValues, notNull);
+    int32_t* index = batch.index.data();
+    rle->next(index, numValues, notNull);
+    const int32_t dictionaryCount = static_cast<int32_t>(dictionary->dictionaryOffset.size() - 1);
+    for (uint64_t i = 0; i < numValues; ++i) {
+      if ((!notNull || notNull[i]) && (index[i] < 0 || index[i] >= dictionaryCount)) {
+        throw ParseError("Entry index out of range in StringDictionaryColumn");
+      }
+    }
   }
 
   void StringDictionaryColumnReader::seekToRowGroup(
@@ -680,6 +822,15 @@ namespace orc {
      */
     size_t computeSize(const int64_t* lengths, const char* notNull, uint64_t numValues);
 
+    /**
+     * Copy the next bytes of the blob stream.
+     * @param ptr the buffer to copy to
+     * @param totalLength the number of bytes to copy
+     */
+    void readBlob(char* ptr, size_t totalLength);
+
+    void nextOffsets(OffsetStringVectorBatch& batch, uint64_t numValues, const char* notNull);
+
    public:
     StringDirectColumnReader(const Type& type, StripeStreams& stipe);
     ~StringDirectColumnReader() override;
@@ -761,7 +912,11 @@ namespace orc {
                                       char* notNull) {
     ColumnReader::next(rowBatch, numValues, notNull);
     // update the notNull from the parent class
-    notNull = rowBatch.hasNulls ? rowBatch.notNull.data() : nullptr;
+    notNull = getNotNull(rowBatch);
+    if (auto* offsetBatch = dynamic_cast<OffsetStringVectorBatch*>(&rowBatch)) {
+      nextOffsets(*offsetBatch, numValues, notNull);
+      return;
+    }
     StringVectorBatch& byteBatch = dynamic_cast<StringVectorBatch&>(rowBatch);
     char** startPtr = byteBatch.data.data();
     int64_t* lengthPtr = byteBatch.length.data();
@@ -772,11 +927,51 @@ namespace orc {
     // figure out the total length of data we need from the blob stream
     const size_t totalLength = computeSize(lengthPtr, notNull, numValues);
 
+    byteBatch.blob.resizeUninitialized(totalLength);
+    readBlob(byteBatch.blob.data(), totalLength);
+
+    size_t filledSlots = 0;
+    const char* ptr = byteBatch.blob.data();
+    if (notNull) {
+      while (filledSlots < numValues) {
+        if (notNull[filledSlots]) {
+          startPtr[filledSlots] = const_cast<char*>(ptr);
+          ptr += lengthPtr[filledSlots];
+        }
+        filledSlots += 1;
+      }
+    } else {
+      while (filledSlots < numValues) {
+        startPtr[filledSlots] = const_cast<char*>(ptr);
+        ptr += lengthPtr[filledSlots];
+        filledSlots += 1;
+      }
+    }
+  }
+
+  void StringDirectColumnReader::nextOffsets(OffsetStringVectorBatch& batch, uint64_t numValues,
+                                             const char* notNull) {
+    // read the lengths after the first offset and turn them into offsets
+    int64_t* offsets = batch.offsets.data();
+    lengthRle->next(offsets + 1, numValues, notNull);
+    offsets[0] = 0;
+    for (uint64_t i = 0; i < numValues; ++i) {
+      int64_t length = !notNull || notNull[i] ? offsets[i + 1] : 0;
+      if (length < 0) {
+        throw ParseError("Negative string length in StringDirectColumnReader");
+      }
+      offsets[i + 1] = offsets[i] + length;
+    }
+
+    const size_t totalLength = static_cast<size_t>(offsets[numValues]);
+    batch.blob.resizeUninitialized(totalLength);
+    readBlob(batch.blob.data(), totalLength);
+  }
+
+  void StringDirectColumnReader::readBlob(char* ptr, size_t totalLength) {
     // Load data from the blob stream into our buffer until we have enough
     // to get the rest directly out of the stream's buffer.
     size_t bytesBuffered = 0;
-    byteBatch.blob.resize(totalLength);
-    char* ptr = byteBatch.blob.data();
     while (bytesBuffered + lastBufferLength < totalLength) {
       memcpy(ptr + bytesBuffered, lastBuffer, lastBufferLength);
       bytesBuffered += lastBufferLength;
@@ -795,24 +990,6 @@ namespace orc {
       lastBuffer += moreBytes;
       lastBufferLength -= moreBytes;
     }
-
-    size_t filledSlots = 0;
-    ptr = byteBatch.blob.data();
-    if (notNull) {
-      while (filledSlots < numValues) {
-        if (notNull[filledSlots]) {
-          startPtr[filledSlots] = const_cast<char*>(ptr);
-          ptr += lengthPtr[filledSlots];
-        }
-        filledSlots += 1;
-      }
-    } else {
-      while (filledSlots < numValues) {
-        startPtr[filledSlots] = const_cast<char*>(ptr);
-        ptr += lengthPtr[filledSlots];
-        filledSlots += 1;
-      }
-    }
   }
 
   void StringDirectColumnReader::seekToRowGroup(
@@ -892,7 +1069,7 @@ namespace orc {
                                         char* notNull) {
     ColumnReader::next(rowBatch, numValues, notNull);
     uint64_t i = 0;
-    notNull = rowBatch.hasNulls ? rowBatch.notNull.data() : nullptr;
+    notNull = getNotNull(rowBatch);
     for (auto iter = children.begin(); iter != children.end(); ++iter, ++i) {
       if (encoded) {
         (*iter)->nextEncoded(*(dynamic_cast<StructVectorBatch&>(rowBatch).fields[i]), numValues,
@@ -994,7 +1171,7 @@ namespace orc {
     ColumnReader::next(rowBatch, numValues, notNull);
     ListVectorBatch& listBatch = dynamic_cast<ListVectorBatch&>(rowBatch);
     int64_t* offsets = listBatch.offsets.data();
-    notNull = listBatch.hasNulls ? listBatch.notNull.data() : nullptr;
+    notNull = getNotNull(listBatch);
     rle->next(offsets, numValues, notNull);
     uint64_t totalChildren = 0;
     if (notNull) {
@@ -1127,7 +1304,7 @@ namespace orc {
     ColumnReader::next(rowBatch, numValues, notNull);
     MapVectorBatch& mapBatch = dynamic_cast<MapVectorBatch&>(rowBatch);
     int64_t* offsets = mapBatch.offsets.data();
-    notNull = mapBatch.hasNulls ? mapBatch.notNull.data() : nullptr;
+    notNull = getNotNull(mapBatch);
     rle->next(offsets, numValues, notNull);
     uint64_t totalChildren = 0;
     if (notNull) {
@@ -1265,7 +1442,7 @@ namespace orc {
     int64_t* counts = childrenCounts.data();
     memset(counts, 0, sizeof(int64_t) * numChildren);
     unsigned char* tags = unionBatch.tags.data();
-    notNull = unionBatch.hasNulls ? unionBatch.notNull.data() : nullptr;
+    notNull = getNotNull(unionBatch);
     rle->next(reinterpret_cast<char*>(tags), numValues, notNull);
     // set the offsets for each row
     if (notNull) {
@@ -1324,6 +1501,10 @@ namespace orc {
     static const int64_t POWERS_OF_TEN[MAX_PRECISION_64 + 1];
 
    protected:
+    // the number of bytes of the longest varint of 64 and 128 bits
+    static const int64_t MAX_VARINT64_LENGTH = 10;
+    static const int64_t MAX_VARINT128_LENGTH = 19;
+
     std::unique_ptr<SeekableInputStream> valueStream;
     int32_t precision;
     int32_t scale;
@@ -1346,19 +1527,87 @@ namespace orc {
       }
     }
 
-    void readInt64(int64_t& value, int32_t currentScale) {
-      value = 0;
-      size_t offset = 0;
+    /**
+     * Read a varint of up to 64 bits. When the buffer holds the longest
+     * varint, it is decoded without checking for the end of the buffer.
+     */
+    uint64_t readVarint64() {
+      uint64_t value = 0;
+      uint32_t offset = 0;
+      unsigned char ch;
+      if (bufferEnd - buffer >= MAX_VARINT64_LENGTH) {
+        do {
+          ch = static_cast<unsigned char>(*(buffer++));
+          value |= static_cast<uint64_t>(ch & 0x7f) << offset;
+          offset += 7;
+        } while ((ch & 0x80) && offset < 64);
+        if (!(ch & 0x80)) {
+          return value;
+        }
+      }
       while (true) {
         readBuffer();
-        unsigned char ch = static_cast<unsigned char>(*(buffer++));
-        value |= static_cast<uint64_t>(ch & 0x7f) << offset;
+        ch = static_cast<unsigned char>(*(buffer++));
+        if (offset < 64) {
+          value |= static_cast<uint64_t>(ch & 0x7f) << offset;
+        }
         offset += 7;
         if (!(ch & 0x80)) {
-          break;
+          return value;
+        }
+      }
+    }
+
+    /**
+     * Read a zigzag encoded varint of up to 128 bits, collecting the bits in
+     * two words rather than shifting an Int128 for each byte. When the buffer
+     * holds the longest varint, it is decoded without checking for the end of
+     * the buffer.
+     */
+    Int128 readZigZagInt128() {
+      uint64_t low = 0;
+      uint64_t high = 0;
+      uint32_t offset = 0;
+      unsigned char ch;
+      bool checkEnd = bufferEnd - buffer < MAX_VARINT128_LENGTH;
+      do {
+        if (checkEnd) {
+          readBuffer();
         }
+        ch = static_cast<unsigned char>(*(buffer++));
+        uint64_t bits = ch & 0x7f;
+        if (offset < 64) {
+          low |= bits << offset;
+          if (offset > 57) {
+            high |= bits >> (64 - offset);
+          }
+        } else if (offset < 128) {
+          high |= bits << (offset - 64);
+        }
+        offset += 7;
+        // longer varints than the longest one may run past the buffer
+        checkEnd = checkEnd || offset >= 7 * MAX_VARINT128_LENGTH;
+      } while (ch & 0x80);
+      // (value >> 1) ^ -(value & 1) with a logical shift
+      uint64_t sign = 0 - (low & 1);
+      low = ((low >> 1) | (high << 63)) ^ sign;
+      high = (high >> 1) ^ sign;
+      return Int128(static_cast<int64_t>(high), low);
+    }
+
+    /**
+     * Whether all the non-null values of a batch have the scale of the
+     * column, which is what writers produce, so that none needs rescaling.
+     */
+    bool hasColumnScale(const int64_t* scales, const char* notNull, uint64_t numValues) const {
+      int64_t differences = 0;
+      for (uint64_t i = 0; i < numValues; ++i) {
+        differences |= (notNull == nullptr || notNull[i]) ? scales[i] ^ scale : 0;
       }
-      value = unZigZag(static_cast<uint64_t>(value));
+      return differences == 0;
+    }
+
+    void rescaleInt64(int64_t& value, int32_t currentScale) const {
       if (scale > currentScale && static_cast<uint64_t>(scale - currentScale) <= MAX_PRECISION_64) {
         value *= POWERS_OF_TEN[scale - currentScale];
       } else if (scale < currentScale &&
@@ -1381,6 +1630,8 @@ namespace orc {
   };
   const uint32_t Decimal64ColumnReader::MAX_PRECISION_64;
   const uint32_t Decimal64ColumnReader::MAX_PRECISION_128;
+  const int64_t Decimal64ColumnReader::MAX_VARINT64_LENGTH;
+  const int64_t Decimal64ColumnReader::MAX_VARINT128_LENGTH;
   const int64_t Decimal64ColumnReader::POWERS_OF_TEN[MAX_PRECISION_64 + 1] = {1,
                                                                               10,
                                                                               100,
@@ -1435,7 +1686,7 @@ namespace orc {
 
   void Decimal64ColumnReader::next(ColumnVectorBatch& rowBatch, uint64_t numValues, char* notNull) {
     ColumnReader::next(rowBatch, numValues, notNull);
-    notNull = rowBatch.hasNulls ? rowBatch.notNull.data() : nullptr;
+    notNull = getNotNull(rowBatch);
     Decimal64VectorBatch& batch = dynamic_cast<Decimal64VectorBatch&>(rowBatch);
     int64_t* values = batch.values.data();
     // read the next group of scales
@@ -1443,20 +1694,43 @@ namespace orc {
     scaleDecoder->next(scaleBuffer, numValues, notNull);
     batch.precision = precision;
     batch.scale = scale;
-    if (notNull) {
-      for (size_t i = 0; i < numValues; ++i) {
-        if (notNull[i]) {
-          readInt64(values[i], static_cast<int32_t>(scaleBuffer[i]));
+    bool rescale = !hasColumnScale(scaleBuffer, notNull, numValues);
+    for (size_t i = 0; i < numValues; ++i) {
+      if (notNull == nullptr || notNull[i]) {
+        values[i] = unZigZag(readVarint64());
+        if (rescale) {
+          rescaleInt64(values[i], static_cast<int32_t>(scaleBuffer[i]));
         }
       }
-    } else {
-      for (size_t i = 0; i < numValues; ++i) {
-        readInt64(values[i], static_cast<int32_t>(scaleBuffer[i]));
-      }
     }
   }
 
   void scaleInt128(Int128& value, uint32_t scale, uint32_t currentScale) {
+#if defined(__SIZEOF_INT128__)
+    // the compiler's 128 bit integers multiply and divide in a few instructions
+    __extension__ typedef __int128 NativeInt128;
+    __extension__ typedef unsigned __int128 NativeUInt128;
+    NativeUInt128 bits = static_cast<uint64_t>(value.getHighBits());
+    bits = bits << 64 | value.getLowBits();
+    if (scale > currentScale) {
+      while (scale > currentScale) {
+        uint32_t scaleAdjust =
+            std::min(Decimal64ColumnReader::MAX_PRECISION_64, scale - currentScale);
+        bits *= static_cast<uint64_t>(Decimal64ColumnReader::POWERS_OF_TEN[scaleAdjust]);
+        currentScale += scaleAdjust;
+      }
+    } else if (scale < currentScale) {
+      NativeInt128 signedBits = static_cast<NativeInt128>(bits);
+      while (currentScale > scale) {
+        uint32_t scaleAdjust =
+            std::min(Decimal64ColumnReader::MAX_PRECISION_64, currentScale - scale);
+        signedBits /= Decimal64ColumnReader::POWERS_OF_TEN[scaleAdjust];
+        currentScale -= scaleAdjust;
+      }
+      bits = static_cast<NativeUInt128>(signedBits);
+    }
+    value = Int128(static_cast<int64_t>(bits >> 64), static_cast<uint64_t>(bits));
+#else
     if (scale > currentScale) {
       while (scale > currentScale) {
         uint32_t scaleAdjust =
@@ -1473,6 +1747,7 @@ namespace orc {
         currentScale -= scaleAdjust;
       }
     }
+#endif
   }
 
   void Decimal64ColumnReader::seekToRowGroup(
@@ -1492,25 +1767,6 @@ namespace orc {
 
     void next(ColumnVectorBatch& rowBatch, uint64_t numValues, char* notNull) override;
 
-   private:
-    void readInt128(Int128& value, int32_t currentScale) {
-      value = 0;
-      Int128 work;
-      uint32_t offset = 0;
-      while (true) {
-        readBuffer();
-        unsigned char ch = static_cast<unsigned char>(*(buffer++));
-        work = ch & 0x7f;
-        work <<= offset;
-        value |= work;
-        offset += 7;
-        if (!(ch & 0x80)) {
-          break;
-        }
-      }
-      unZigZagInt128(value);
-      scaleInt128(value, static_cast<uint32_t>(scale), static_cast<uint32_t>(currentScale));
-    }
   };
 
   Decimal128ColumnReader::Decimal128ColumnReader(const Type& type, StripeStreams& stripe)
@@ -1525,7 +1781,7 @@ namespace orc {
   void Decimal128ColumnReader::next(ColumnVectorBatch& rowBatch, uint64_t numValues,
                                     char* notNull) {
     ColumnReader::next(rowBatch, numValues, notNull);
-    notNull = rowBatch.hasNulls ? rowBatch.notNull.data() : nullptr;
+    notNull = getNotNull(rowBatch);
     Decimal128VectorBatch& batch = dynamic_cast<Decimal128VectorBatch&>(rowBatch);
     Int128* values = batch.values.data();
     // read the next group of scales
@@ -1533,16 +1789,15 @@ namespace orc {
     scaleDecoder->next(scaleBuffer, numValues, notNull);
     batch.precision = precision;
     batch.scale = scale;
-    if (notNull) {
-      for (size_t i = 0; i < numValues; ++i) {
-        if (notNull[i]) {
-          readInt128(values[i], static_cast<int32_t>(scaleBuffer[i]));
+    bool rescale = !hasColumnScale(scaleBuffer, notNull, numValues);
+    for (size_t i = 0; i < numValues; ++i) {
+      if (notNull == nullptr || notNull[i]) {
+        values[i] = readZigZagInt128();
+        if (rescale) {
+          scaleInt128(values[i], static_cast<uint32_t>(scale),
+                      static_cast<uint32_t>(scaleBuffer[i]));
         }
       }
-    } else {
-      for (size_t i = 0; i < numValues; ++i) {
-        readInt128(values[i], static_cast<int32_t>(scaleBuffer[i]));
-      }
     }
   }
 
@@ -1588,7 +1843,7 @@ namespace orc {
   void Decimal64ColumnReaderV2::next(ColumnVectorBatch& rowBatch, uint64_t numValues,
                                      char* notNull) {
     ColumnReader::next(rowBatch, numValues, notNull);
-    notNull = rowBatch.hasNulls ? rowBatch.notNull.data() : nullptr;
+    notNull = getNotNull(rowBatch);
     Decimal64VectorBatch& batch = dynamic_cast<Decimal64VectorBatch&>(rowBatch);
     valueDecoder->next(batch.values.data(), numValues, notNull);
     batch.precision = precision;
@@ -1658,7 +1913,7 @@ namespace orc {
   void DecimalHive11ColumnReader::next(ColumnVectorBatch& rowBatch, uint64_t numValues,
                                        char* notNull) {
     ColumnReader::next(rowBatch, numValues, notNull);
-    notNull = rowBatch.hasNulls ? rowBatch.notNull.data() : nullptr;
+    notNull = getNotNull(rowBatch);
     Decimal128VectorBatch& batch = dynamic_cast<Decimal128VectorBatch&>(rowBatch);
     Int128* values = batch.values.data();
     // read the next group of scales
@@ -1679,6 +1934,9 @@ namespace orc {
                            << "Hive 0.11 decimal with more than 38 digits "
                            << "replaced by NULL.\n";
               notNull[i] = false;
+              if (batch.useNotNullBitmap) {
+                clearBit(batch.notNullBitmap.data(), i);
+              }
             }
           }
         }
@@ -1693,7 +1951,11 @@ namespace orc {
                          << "Hive 0.11 decimal with more than 38 digits "
                          << "replaced by NULL.\n";
             batch.hasNulls = true;
-            batch.notNull[i] = false;
+            if (batch.useNotNullBitmap) {
+              clearBit(batch.notNullBitmap.data(), i);
+            } else {
+              batch.notNull[i] = false;
+            }
           }
         }
       }
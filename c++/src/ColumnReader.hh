@@ -108,6 +108,14 @@ namespace orc {
      * @return get schema evolution utility object
      */
     virtual const SchemaEvolution* getSchemaEvolution() const = 0;
+
+    /**
+     * Get the place where the string dictionary of a column is kept from
+     * one stripe to the next, so that consecutive stripes with identical
+     * dictionaries share a single StringDictionary.
+     * @return nullptr if dictionaries are not shared between stripes
+     */
+    virtual std::shared_ptr<StringDictionary>* getSharedDictionary(uint64_t columnId) const = 0;
   };
 
   /**
@@ -119,6 +127,15 @@ namespace orc {
     uint64_t columnId;
     MemoryPool& memoryPool;
     ReaderMetrics* metrics;
+    // the not null flags of batches that use not null bitmaps, expanded to
+    // one byte per value for the decoders
+    DataBuffer<char> notNullBytes;
+
+    /**
+     * Get the not null flags of the batch read by ColumnReader::next() with
+     * one byte per value, or nullptr if the batch has no nulls.
+     */
+    char* getNotNull(ColumnVectorBatch& rowBatch);
 
    public:
     ColumnReader(const Type& type, StripeStreams& stipe);
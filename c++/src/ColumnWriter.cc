@@ -19,11 +19,14 @@
 #include "orc/Int128.hh"
 #include "orc/Writer.hh"
 
+#include "Bitmap.hh"
 #include "ByteRLE.hh"
 #include "ColumnWriter.hh"
 #include "RLE.hh"
 #include "Statistics.hh"
+#include "TimestampCodec.hh"
 #include "Timezone.hh"
+#include "ZoneMap.hh"
 
 namespace orc {
   StreamsFactory::~StreamsFactory() {
@@ -35,22 +38,24 @@ namespace orc {
     StreamsFactoryImpl(const WriterOptions& writerOptions, OutputStream* outputStream)
         : options(writerOptions), outStream(outputStream) {}
 
-    virtual std::unique_ptr<BufferedOutputStream> createStream(
-        proto::Stream_Kind kind) const override;
+    virtual std::unique_ptr<BufferedOutputStream> createStream(proto::Stream_Kind kind,
+                                                               uint64_t columnId) const override;
 
    private:
     const WriterOptions& options;
     OutputStream* outStream;
   };
 
-  std::unique_ptr<BufferedOutputStream> StreamsFactoryImpl::createStream(proto::Stream_Kind) const {
+  std::unique_ptr<BufferedOutputStream> StreamsFactoryImpl::createStream(
+      proto::Stream_Kind, uint64_t columnId) const {
     // In the future, we can decide compression strategy and modifier
     // based on stream kind. But for now we just use the setting from
     // WriterOption
     return createCompressor(options.getCompression(), outStream, options.getCompressionStrategy(),
                             // BufferedOutputStream initial capacity
                             options.getOutputBufferCapacity(), options.getCompressionBlockSize(),
-                            *options.getMemoryPool(), options.getWriterMetrics());
+                            getColumnMemoryPool(*options.getMemoryPool(), columnId),
+                            options.getWriterMetrics());
   }
 
   std::unique_ptr<StreamsFactory> createStreamsFactory(const WriterOptions& options,
@@ -84,23 +89,25 @@ namespace orc {
         rowIndexEntry(),
         rowIndexPosition(),
         enableBloomFilter(false),
-        memPool(*options.getMemoryPool()),
+        enableZoneMap(false),
+        memPool(getColumnMemoryPool(*options.getMemoryPool(), type.getColumnId())),
         indexStream(),
         bloomFilterStream(),
-        hasNullValue(false) {
+        hasNullValue(false),
+        notNullBytes(memPool) {
     std::unique_ptr<BufferedOutputStream> presentStream =
-        factory.createStream(proto::Stream_Kind_PRESENT);
+        factory.createStream(proto::Stream_Kind_PRESENT, columnId);
     notNullEncoder = createBooleanRleEncoder(std::move(presentStream));
 
-    colIndexStatistics = createColumnStatistics(type);
-    colStripeStatistics = createColumnStatistics(type);
-    colFileStatistics = createColumnStatistics(type);
+    colIndexStatistics = createColumnStatistics(type, options.getStringStatisticsMaxLength());
+    colStripeStatistics = createColumnStatistics(type, options.getStringStatisticsMaxLength());
+    colFileStatistics = createColumnStatistics(type, options.getStringStatisticsMaxLength());
 
     if (enableIndex) {
       rowIndex = std::make_unique<proto::RowIndex>();
       rowIndexEntry = std::make_unique<proto::RowIndexEntry>();
       rowIndexPosition = std::make_unique<RowIndexPositionRecorder>(*rowIndexEntry);
-      indexStream = factory.createStream(proto::Stream_Kind_ROW_INDEX);
+      indexStream = factory.createStream(proto::Stream_Kind_ROW_INDEX, columnId);
 
       // BloomFilters for non-UTF8 strings and non-UTC timestamps are not supported
       if (options.isColumnUseBloomFilter(columnId) &&
@@ -109,7 +116,14 @@ namespace orc {
         bloomFilter.reset(
             new BloomFilterImpl(options.getRowIndexStride(), options.getBloomFilterFPP()));
         bloomFilterIndex.reset(new proto::BloomFilterIndex());
-        bloomFilterStream = factory.createStream(proto::Stream_Kind_BLOOM_FILTER_UTF8);
+        bloomFilterStream = factory.createStream(proto::Stream_Kind_BLOOM_FILTER_UTF8, columnId);
+      }
+
+      if (options.getZoneMapGranularity() != 0 && isZoneMapSupported(type.getKind())) {
+        enableZoneMap = true;
+        zoneMap = std::make_unique<proto::RowIndex>();
+        colPagesStatistics =
+            createColumnStatistics(type, options.getStringStatisticsMaxLength());
       }
     }
   }
@@ -120,6 +134,17 @@ namespace orc {
 
   void ColumnWriter::add(ColumnVectorBatch& batch, uint64_t offset, uint64_t numValues,
                          const char* incomingMask) {
+    if (batch.useNotNullBitmap) {
+      notNullBytes.resize(numValues);
+      if (batch.hasNulls) {
+        expandBits(batch.notNullBitmap.data(), offset, numValues, notNullBytes.data());
+        hasNullValue |= countSetBits(batch.notNullBitmap.data(), offset, numValues) != numValues;
+      } else {
+        memset(notNullBytes.data(), 1, numValues);
+      }
+      notNullEncoder->add(notNullBytes.data(), numValues, incomingMask);
+      return;
+    }
     const char* notNull = batch.notNull.data() + offset;
     notNullEncoder->add(notNull, numValues, incomingMask);
     hasNullValue |= batch.hasNulls;
@@ -165,7 +190,22 @@ namespace orc {
     getProtoBufStatistics(stats, colFileStatistics.get());
   }
 
+  void ColumnWriter::createZoneMapEntry() {
+    if (enableZoneMap) {
+      colIndexStatistics->toProtoBuf(*zoneMap->add_entry()->mutable_statistics());
+      colPagesStatistics->merge(*colIndexStatistics);
+      colIndexStatistics->reset();
+    }
+  }
+
   void ColumnWriter::createRowIndexEntry() {
+    if (enableZoneMap) {
+      // close the last page and restore the statistics of the whole row group
+      ColumnWriter::createZoneMapEntry();
+      colIndexStatistics->merge(*colPagesStatistics);
+      colPagesStatistics->reset();
+    }
+
     proto::ColumnStatistics* indexStats = rowIndexEntry->mutable_statistics();
     colIndexStatistics->toProtoBuf(*indexStats);
 
@@ -227,6 +267,12 @@ namespace orc {
     }
   }
 
+  void ColumnWriter::writeZoneMaps(std::map<uint64_t, const proto::RowIndex*>& zoneMaps) const {
+    if (enableZoneMap) {
+      zoneMaps[columnId] = zoneMap.get();
+    }
+  }
+
   void ColumnWriter::recordPosition() const {
     notNullEncoder->recordPosition(rowIndexPosition.get());
   }
@@ -246,6 +292,11 @@ namespace orc {
       bloomFilter->reset();
       bloomFilterIndex->clear_bloom_filter();
     }
+
+    if (enableZoneMap) {
+      zoneMap->clear_entry();
+      colPagesStatistics->reset();
+    }
   }
 
   void ColumnWriter::writeDictionary() {
@@ -275,7 +326,10 @@ namespace orc {
 
     virtual void createRowIndexEntry() override;
 
+    virtual void createZoneMapEntry() override;
+
     virtual void writeIndex(std::vector<proto::Stream>& streams) const override;
+    virtual void writeZoneMaps(std::map<uint64_t, const proto::RowIndex*>& zoneMaps) const override;
 
     virtual void writeDictionary() override;
 
@@ -306,7 +360,7 @@ namespace orc {
     }
 
     ColumnWriter::add(rowBatch, offset, numValues, incomingMask);
-    const char* notNull = structBatch->hasNulls ? structBatch->notNull.data() + offset : nullptr;
+    const char* notNull = getNotNull(*structBatch, offset);
     for (uint32_t i = 0; i < children.size(); ++i) {
       children[i]->add(*structBatch->fields[i], offset, numValues, notNull);
     }
@@ -342,6 +396,14 @@ namespace orc {
     }
   }
 
+  void StructColumnWriter::writeZoneMaps(
+      std::map<uint64_t, const proto::RowIndex*>& zoneMaps) const {
+    ColumnWriter::writeZoneMaps(zoneMaps);
+    for (uint32_t i = 0; i < children.size(); ++i) {
+      children[i]->writeZoneMaps(zoneMaps);
+    }
+  }
+
   uint64_t StructColumnWriter::getEstimatedSize() const {
     uint64_t size = ColumnWriter::getEstimatedSize();
     for (uint32_t i = 0; i < children.size(); ++i) {
@@ -392,6 +454,13 @@ namespace orc {
     }
   }
 
+  void StructColumnWriter::createZoneMapEntry() {
+    ColumnWriter::createZoneMapEntry();
+    for (uint32_t i = 0; i < children.size(); ++i) {
+      children[i]->createZoneMapEntry();
+    }
+  }
+
   void StructColumnWriter::createRowIndexEntry() {
     ColumnWriter::createRowIndexEntry();
 
@@ -444,7 +513,7 @@ namespace orc {
                                                       const WriterOptions& options)
       : ColumnWriter(type, factory, options), rleVersion(options.getRleVersion()) {
     std::unique_ptr<BufferedOutputStream> dataStream =
-        factory.createStream(proto::Stream_Kind_DATA);
+        factory.createStream(proto::Stream_Kind_DATA, columnId);
     rleEncoder = createRleEncoder(std::move(dataStream), true, rleVersion, memPool,
                                   options.getAlignedBitpacking());
 
@@ -469,25 +538,19 @@ namespace orc {
     ColumnWriter::add(rowBatch, offset, numValues, incomingMask);
 
     const auto* data = intBatch->data.data() + offset;
-    const char* notNull = intBatch->hasNulls ? intBatch->notNull.data() + offset : nullptr;
+    const char* notNull = getNotNull(*intBatch, offset);
 
     rleEncoder->add(data, numValues, notNull);
 
     // update stats
-    uint64_t count = 0;
-    for (uint64_t i = 0; i < numValues; ++i) {
-      if (notNull == nullptr || notNull[i]) {
-        ++count;
-        if (enableBloomFilter) {
+    if (enableBloomFilter) {
+      for (uint64_t i = 0; i < numValues; ++i) {
+        if (notNull == nullptr || notNull[i]) {
           bloomFilter->addLong(static_cast<int64_t>(data[i]));
         }
-        intStats->update(static_cast<int64_t>(data[i]), 1);
       }
     }
-    intStats->increase(count);
-    if (count < numValues) {
-      intStats->setHasNull(true);
-    }
+    intStats->updateBatch(data, notNull, numValues);
   }
 
   template <typename BatchType>
@@ -551,7 +614,7 @@ namespace orc {
                                                 const WriterOptions& options)
       : ColumnWriter(type, factory, options) {
     std::unique_ptr<BufferedOutputStream> dataStream =
-        factory.createStream(proto::Stream_Kind_DATA);
+        factory.createStream(proto::Stream_Kind_DATA, columnId);
     byteRleEncoder = createByteRleEncoder(std::move(dataStream));
 
     if (enableIndex) {
@@ -575,7 +638,7 @@ namespace orc {
     ColumnWriter::add(rowBatch, offset, numValues, incomingMask);
 
     auto* data = byteBatch->data.data() + offset;
-    const char* notNull = byteBatch->hasNulls ? byteBatch->notNull.data() + offset : nullptr;
+    const char* notNull = getNotNull(*byteBatch, offset);
 
     char* byteData = reinterpret_cast<char*>(data);
     for (uint64_t i = 0; i < numValues; ++i) {
@@ -583,20 +646,14 @@ namespace orc {
     }
     byteRleEncoder->add(byteData, numValues, notNull);
 
-    uint64_t count = 0;
-    for (uint64_t i = 0; i < numValues; ++i) {
-      if (notNull == nullptr || notNull[i]) {
-        ++count;
-        if (enableBloomFilter) {
+    if (enableBloomFilter) {
+      for (uint64_t i = 0; i < numValues; ++i) {
+        if (notNull == nullptr || notNull[i]) {
           bloomFilter->addLong(data[i]);
         }
-        intStats->update(static_cast<int64_t>(byteData[i]), 1);
       }
     }
-    intStats->increase(count);
-    if (count < numValues) {
-      intStats->setHasNull(true);
-    }
+    intStats->updateBatch(byteData, notNull, numValues);
   }
 
   template <typename BatchType>
@@ -662,7 +719,7 @@ namespace orc {
                                                       const WriterOptions& options)
       : ColumnWriter(type, factory, options) {
     std::unique_ptr<BufferedOutputStream> dataStream =
-        factory.createStream(proto::Stream_Kind_DATA);
+        factory.createStream(proto::Stream_Kind_DATA, columnId);
     rleEncoder = createBooleanRleEncoder(std::move(dataStream));
 
     if (enableIndex) {
@@ -688,7 +745,7 @@ namespace orc {
     ColumnWriter::add(rowBatch, offset, numValues, incomingMask);
 
     auto* data = byteBatch->data.data() + offset;
-    const char* notNull = byteBatch->hasNulls ? byteBatch->notNull.data() + offset : nullptr;
+    const char* notNull = getNotNull(*byteBatch, offset);
 
     char* byteData = reinterpret_cast<char*>(data);
     for (uint64_t i = 0; i < numValues; ++i) {
@@ -778,8 +835,9 @@ namespace orc {
                                                                    bool isFloatType)
       : ColumnWriter(type, factory, options),
         isFloat(isFloatType),
-        buffer(*options.getMemoryPool()) {
-    dataStream.reset(new AppendOnlyBufferedStream(factory.createStream(proto::Stream_Kind_DATA)));
+        buffer(memPool) {
+    dataStream.reset(
+        new AppendOnlyBufferedStream(factory.createStream(proto::Stream_Kind_DATA, columnId)));
     buffer.resize(isFloat ? 4 : 8);
 
     if (enableIndex) {
@@ -814,11 +872,10 @@ namespace orc {
     ColumnWriter::add(rowBatch, offset, numValues, incomingMask);
 
     const ValueType* doubleData = dblBatch->data.data() + offset;
-    const char* notNull = dblBatch->hasNulls ? dblBatch->notNull.data() + offset : nullptr;
+    const char* notNull = getNotNull(*dblBatch, offset);
 
     size_t bytes = isFloat ? 4 : 8;
     char* data = buffer.data();
-    uint64_t count = 0;
     for (uint64_t i = 0; i < numValues; ++i) {
       if (!notNull || notNull[i]) {
         if (isFloat) {
@@ -827,17 +884,12 @@ namespace orc {
           encodeFloatNum<double, int64_t>(static_cast<double>(doubleData[i]), data);
         }
         dataStream->write(data, bytes);
-        ++count;
         if (enableBloomFilter) {
           bloomFilter->addDouble(static_cast<double>(doubleData[i]));
         }
-        doubleStats->update(static_cast<double>(doubleData[i]));
       }
     }
-    doubleStats->increase(count);
-    if (count < numValues) {
-      doubleStats->setHasNull(true);
-    }
+    doubleStats->updateBatch(doubleData, notNull, numValues);
   }
 
   template <typename ValueType, typename BatchType>
@@ -1037,7 +1089,27 @@ namespace orc {
     void deleteDictStreams();
     void fallbackToDirectEncoding();
 
+    /**
+     * Add the values of an encoded batch to the dictionary, looking up each
+     * id of its dictionary once.
+     */
+    void addEncoded(const EncodedStringVectorBatch& batch, uint64_t offset, uint64_t numValues,
+                    const char* notNull, StringColumnStatisticsImpl* strStats);
+
    protected:
+    /**
+     * Get the values of a StringVectorBatch, an EncodedStringVectorBatch or
+     * an OffsetStringVectorBatch as string pointers and lengths.
+     * @param rowBatch the batch to add
+     * @param offset the first value to add
+     * @param numValues the number of values to add
+     * @param data set to the pointers of the values
+     * @param length set to the lengths of the values; subclasses may change
+     * them
+     */
+    void getValues(ColumnVectorBatch& rowBatch, uint64_t offset, uint64_t numValues,
+                   char**& data, int64_t*& length);
+
     RleVersion rleVersion;
     bool useCompression;
     const StreamsFactory& streamsFactory;
@@ -1065,6 +1137,19 @@ namespace orc {
 
     // record start row of each row group; null rows are skipped
     mutable std::vector<size_t> startOfRowGroups;
+
+    // pointers and lengths of the values of an OffsetStringVectorBatch or
+    // an EncodedStringVectorBatch
+    DataBuffer<char*> offsetValues;
+    DataBuffer<int64_t> offsetLengths;
+
+    // the dictionary of the last encoded batch, the insertion order in
+    // dictionary of each of its ids or -1 if the id was not added yet, and
+    // the number of the last call to addEncoded() that saw the id
+    std::shared_ptr<StringDictionary> encodedDictionary;
+    std::vector<int64_t> encodedEntries;
+    std::vector<uint64_t> encodedLastBatch;
+    uint64_t encodedBatchCount;
   };
 
   StringColumnWriter::StringColumnWriter(const Type& type, const StreamsFactory& factory,
@@ -1076,7 +1161,10 @@ namespace orc {
         alignedBitPacking(options.getAlignedBitpacking()),
         doneDictionaryCheck(false),
         useDictionary(options.getEnableDictionary()),
-        dictSizeThreshold(options.getDictionaryKeySizeThreshold()) {
+        dictSizeThreshold(options.getDictionaryKeySizeThreshold()),
+        offsetValues(memPool),
+        offsetLengths(memPool),
+        encodedBatchCount(0) {
     if (type.getKind() == TypeKind::BINARY) {
       useDictionary = false;
       doneDictionaryCheck = true;
@@ -1094,30 +1182,79 @@ namespace orc {
     }
   }
 
-  void StringColumnWriter::add(ColumnVectorBatch& rowBatch, uint64_t offset, uint64_t numValues,
-                               const char* incomingMask) {
-    const StringVectorBatch* stringBatch = dynamic_cast<const StringVectorBatch*>(&rowBatch);
-    if (stringBatch == nullptr) {
+  void StringColumnWriter::getValues(ColumnVectorBatch& rowBatch, uint64_t offset,
+                                     uint64_t numValues, char**& data, int64_t*& length) {
+    auto* encodedBatch =
+        rowBatch.isEncoded ? dynamic_cast<EncodedStringVectorBatch*>(&rowBatch) : nullptr;
+    if (encodedBatch) {
+      offsetValues.resizeUninitialized(numValues);
+      offsetLengths.resizeUninitialized(numValues);
+      StringDictionary& dict = *encodedBatch->dictionary;
+      const int32_t* index = encodedBatch->index.data() + offset;
+      const uint64_t dictionaryCount = dict.dictionaryOffset.size() - 1;
+      for (uint64_t i = 0; i < numValues; ++i) {
+        if (!rowBatch.isNotNull(offset + i)) {
+          offsetValues[i] = nullptr;
+          offsetLengths[i] = 0;
+        } else if (index[i] < 0 || static_cast<uint64_t>(index[i]) >= dictionaryCount) {
+          throw InvalidArgument("Dictionary index out of range in EncodedStringVectorBatch");
+        } else {
+          dict.getValueByIndex(index[i], offsetValues[i], offsetLengths[i]);
+        }
+      }
+      data = offsetValues.data();
+      length = offsetLengths.data();
+      return;
+    }
+    if (auto* stringBatch = dynamic_cast<StringVectorBatch*>(&rowBatch)) {
+      data = stringBatch->data.data() + offset;
+      length = stringBatch->length.data() + offset;
+      return;
+    }
+    auto* offsetBatch = dynamic_cast<OffsetStringVectorBatch*>(&rowBatch);
+    if (offsetBatch == nullptr) {
       throw InvalidArgument("Failed to cast to StringVectorBatch");
     }
+    offsetValues.resizeUninitialized(numValues);
+    offsetLengths.resizeUninitialized(numValues);
+    const int64_t* offsets = offsetBatch->offsets.data() + offset;
+    char* blob = offsetBatch->blob.data();
+    for (uint64_t i = 0; i < numValues; ++i) {
+      offsetValues[i] = blob + offsets[i];
+      offsetLengths[i] = offsets[i + 1] - offsets[i];
+    }
+    data = offsetValues.data();
+    length = offsetLengths.data();
+  }
 
+  void StringColumnWriter::add(ColumnVectorBatch& rowBatch, uint64_t offset, uint64_t numValues,
+                               const char* incomingMask) {
     StringColumnStatisticsImpl* strStats =
         dynamic_cast<StringColumnStatisticsImpl*>(colIndexStatistics.get());
     if (strStats == nullptr) {
       throw InvalidArgument("Failed to cast to StringColumnStatisticsImpl");
     }
 
+    auto* encodedBatch =
+        rowBatch.isEncoded ? dynamic_cast<EncodedStringVectorBatch*>(&rowBatch) : nullptr;
+    if (encodedBatch && useDictionary) {
+      ColumnWriter::add(rowBatch, offset, numValues, incomingMask);
+      addEncoded(*encodedBatch, offset, numValues, getNotNull(rowBatch, offset), strStats);
+      return;
+    }
+
+    char** data = nullptr;
+    int64_t* length = nullptr;
+    getValues(rowBatch, offset, numValues, data, length);
+
     ColumnWriter::add(rowBatch, offset, numValues, incomingMask);
 
-    char* const* data = stringBatch->data.data() + offset;
-    const int64_t* length = stringBatch->length.data() + offset;
-    const char* notNull = stringBatch->hasNulls ? stringBatch->notNull.data() + offset : nullptr;
+    const char* notNull = getNotNull(rowBatch, offset);
 
     if (!useDictionary) {
       directLengthEncoder->add(length, numValues, notNull);
     }
 
-    uint64_t count = 0;
     for (uint64_t i = 0; i < numValues; ++i) {
       if (!notNull || notNull[i]) {
         const size_t len = static_cast<size_t>(length[i]);
@@ -1130,10 +1267,59 @@ namespace orc {
         if (enableBloomFilter) {
           bloomFilter->addBytes(data[i], static_cast<int64_t>(len));
         }
-        strStats->update(data[i], len);
+      }
+    }
+    strStats->updateBatch(data, length, notNull, numValues);
+  }
+
+  void StringColumnWriter::addEncoded(const EncodedStringVectorBatch& batch, uint64_t offset,
+                                      uint64_t numValues, const char* notNull,
+                                      StringColumnStatisticsImpl* strStats) {
+    const StringDictionary& dict = *batch.dictionary;
+    const uint64_t dictionaryCount = dict.dictionaryOffset.size() - 1;
+    if (batch.dictionary != encodedDictionary) {
+      encodedDictionary = batch.dictionary;
+      encodedEntries.assign(dictionaryCount, -1);
+      encodedLastBatch.assign(dictionaryCount, 0);
+    } else if (dictionaryCount > encodedEntries.size()) {
+      // entries appended to the shared dictionary since the last batch
+      encodedEntries.resize(dictionaryCount, -1);
+      encodedLastBatch.resize(dictionaryCount, 0);
+    }
+    ++encodedBatchCount;
+
+    const int32_t* index = batch.index.data() + offset;
+    const int64_t* dictionaryOffsets = dict.dictionaryOffset.data();
+    const char* blob = dict.dictionaryBlob.data();
+    uint64_t count = 0;
+    uint64_t repeatedLength = 0;
+    for (uint64_t i = 0; i < numValues; ++i) {
+      if (!notNull || notNull[i]) {
+        int32_t id = index[i];
+        if (id < 0 || static_cast<uint64_t>(id) >= dictionaryCount) {
+          throw InvalidArgument("Dictionary index out of range in EncodedStringVectorBatch");
+        }
+        const char* value = blob + dictionaryOffsets[id];
+        const size_t len = static_cast<size_t>(dictionaryOffsets[id + 1] - dictionaryOffsets[id]);
+        if (encodedEntries[static_cast<size_t>(id)] < 0) {
+          encodedEntries[static_cast<size_t>(id)] =
+              static_cast<int64_t>(dictionary.insert(value, len));
+        }
+        dictionary.idxInDictBuffer.push_back(encodedEntries[static_cast<size_t>(id)]);
+        // the statistics and bloom filter only need each value once
+        if (encodedLastBatch[static_cast<size_t>(id)] != encodedBatchCount) {
+          encodedLastBatch[static_cast<size_t>(id)] = encodedBatchCount;
+          if (enableBloomFilter) {
+            bloomFilter->addBytes(value, static_cast<int64_t>(len));
+          }
+          strStats->update(value, len);
+        } else {
+          repeatedLength += len;
+        }
         ++count;
       }
     }
+    strStats->increaseTotalLength(repeatedLength);
     strStats->increase(count);
     if (count < numValues) {
       strStats->setHasNull(true);
@@ -1245,30 +1431,31 @@ namespace orc {
 
     dictionary.clear();
     dictionary.idxInDictBuffer.resize(0);
+    encodedDictionary.reset();
     startOfRowGroups.clear();
     startOfRowGroups.push_back(0);
   }
 
   void StringColumnWriter::createDirectStreams() {
     std::unique_ptr<BufferedOutputStream> directLengthStream =
-        streamsFactory.createStream(proto::Stream_Kind_LENGTH);
+        streamsFactory.createStream(proto::Stream_Kind_LENGTH, columnId);
     directLengthEncoder = createRleEncoder(std::move(directLengthStream), false, rleVersion,
                                            memPool, alignedBitPacking);
-    directDataStream.reset(
-        new AppendOnlyBufferedStream(streamsFactory.createStream(proto::Stream_Kind_DATA)));
+    directDataStream.reset(new AppendOnlyBufferedStream(
+        streamsFactory.createStream(proto::Stream_Kind_DATA, columnId)));
   }
 
   void StringColumnWriter::createDictStreams() {
     std::unique_ptr<BufferedOutputStream> dictDataStream =
-        streamsFactory.createStream(proto::Stream_Kind_DATA);
+        streamsFactory.createStream(proto::Stream_Kind_DATA, columnId);
     dictDataEncoder =
         createRleEncoder(std::move(dictDataStream), false, rleVersion, memPool, alignedBitPacking);
     std::unique_ptr<BufferedOutputStream> dictLengthStream =
-        streamsFactory.createStream(proto::Stream_Kind_LENGTH);
+        streamsFactory.createStream(proto::Stream_Kind_LENGTH, columnId);
     dictLengthEncoder = createRleEncoder(std::move(dictLengthStream), false, rleVersion, memPool,
                                          alignedBitPacking);
     dictStream.reset(new AppendOnlyBufferedStream(
-        streamsFactory.createStream(proto::Stream_Kind_DICTIONARY_DATA)));
+        streamsFactory.createStream(proto::Stream_Kind_DICTIONARY_DATA, columnId)));
   }
 
   void StringColumnWriter::deleteDictStreams() {
@@ -1278,6 +1465,7 @@ namespace orc {
 
     dictionary.clear();
     dictionary.idxInDictBuffer.clear();
+    encodedDictionary.reset();
     startOfRowGroups.clear();
   }
 
@@ -1429,7 +1617,7 @@ namespace orc {
     CharColumnWriter(const Type& type, const StreamsFactory& factory, const WriterOptions& options)
         : StringColumnWriter(type, factory, options),
           maxLength(type.getMaximumLength()),
-          padBuffer(*options.getMemoryPool()) {
+          padBuffer(memPool) {
       // utf-8 is currently 4 bytes long, but it could be up to 6
       padBuffer.resize(maxLength * 6);
     }
@@ -1444,10 +1632,9 @@ namespace orc {
 
   void CharColumnWriter::add(ColumnVectorBatch& rowBatch, uint64_t offset, uint64_t numValues,
                              const char* incomingMask) {
-    StringVectorBatch* charsBatch = dynamic_cast<StringVectorBatch*>(&rowBatch);
-    if (charsBatch == nullptr) {
-      throw InvalidArgument("Failed to cast to StringVectorBatch");
-    }
+    char** data = nullptr;
+    int64_t* length = nullptr;
+    getValues(rowBatch, offset, numValues, data, length);
 
     StringColumnStatisticsImpl* strStats =
         dynamic_cast<StringColumnStatisticsImpl*>(colIndexStatistics.get());
@@ -1457,9 +1644,7 @@ namespace orc {
 
     ColumnWriter::add(rowBatch, offset, numValues, incomingMask);
 
-    char** data = charsBatch->data.data() + offset;
-    int64_t* length = charsBatch->length.data() + offset;
-    const char* notNull = charsBatch->hasNulls ? charsBatch->notNull.data() + offset : nullptr;
+    const char* notNull = getNotNull(rowBatch, offset);
 
     uint64_t count = 0;
     for (uint64_t i = 0; i < numValues; ++i) {
@@ -1522,10 +1707,9 @@ namespace orc {
 
   void VarCharColumnWriter::add(ColumnVectorBatch& rowBatch, uint64_t offset, uint64_t numValues,
                                 const char* incomingMask) {
-    StringVectorBatch* charsBatch = dynamic_cast<StringVectorBatch*>(&rowBatch);
-    if (charsBatch == nullptr) {
-      throw InvalidArgument("Failed to cast to StringVectorBatch");
-    }
+    char** data = nullptr;
+    int64_t* length = nullptr;
+    getValues(rowBatch, offset, numValues, data, length);
 
     StringColumnStatisticsImpl* strStats =
         dynamic_cast<StringColumnStatisticsImpl*>(colIndexStatistics.get());
@@ -1535,11 +1719,8 @@ namespace orc {
 
     ColumnWriter::add(rowBatch, offset, numValues, incomingMask);
 
-    char* const* data = charsBatch->data.data() + offset;
-    int64_t* length = charsBatch->length.data() + offset;
-    const char* notNull = charsBatch->hasNulls ? charsBatch->notNull.data() + offset : nullptr;
+    const char* notNull = getNotNull(rowBatch, offset);
 
-    uint64_t count = 0;
     for (uint64_t i = 0; i < numValues; ++i) {
       if (!notNull || notNull[i]) {
         uint64_t itemLength =
@@ -1556,8 +1737,6 @@ namespace orc {
         if (enableBloomFilter) {
           bloomFilter->addBytes(data[i], length[i]);
         }
-        strStats->update(data[i], static_cast<size_t>(length[i]));
-        ++count;
       }
     }
 
@@ -1565,10 +1744,7 @@ namespace orc {
       directLengthEncoder->add(length, numValues, notNull);
     }
 
-    strStats->increase(count);
-    if (count < numValues) {
-      strStats->setHasNull(true);
-    }
+    strStats->updateBatch(data, length, notNull, numValues);
   }
 
   class BinaryColumnWriter : public StringColumnWriter {
@@ -1585,10 +1761,9 @@ namespace orc {
 
   void BinaryColumnWriter::add(ColumnVectorBatch& rowBatch, uint64_t offset, uint64_t numValues,
                                const char* incomingMask) {
-    StringVectorBatch* binBatch = dynamic_cast<StringVectorBatch*>(&rowBatch);
-    if (binBatch == nullptr) {
-      throw InvalidArgument("Failed to cast to StringVectorBatch");
-    }
+    char** data = nullptr;
+    int64_t* length = nullptr;
+    getValues(rowBatch, offset, numValues, data, length);
 
     BinaryColumnStatisticsImpl* binStats =
         dynamic_cast<BinaryColumnStatisticsImpl*>(colIndexStatistics.get());
@@ -1598,9 +1773,7 @@ namespace orc {
 
     ColumnWriter::add(rowBatch, offset, numValues, incomingMask);
 
-    char** data = binBatch->data.data() + offset;
-    int64_t* length = binBatch->length.data() + offset;
-    const char* notNull = binBatch->hasNulls ? binBatch->notNull.data() + offset : nullptr;
+    const char* notNull = getNotNull(rowBatch, offset);
 
     uint64_t count = 0;
     for (uint64_t i = 0; i < numValues; ++i) {
@@ -1645,6 +1818,7 @@ namespace orc {
     RleVersion rleVersion;
     const Timezone& timezone;
     const bool isUTC;
+    TimezoneVariantCache variants;
   };
 
   TimestampColumnWriter::TimestampColumnWriter(const Type& type, const StreamsFactory& factory,
@@ -1652,11 +1826,12 @@ namespace orc {
       : ColumnWriter(type, factory, options),
         rleVersion(options.getRleVersion()),
         timezone(isInstantType ? getTimezoneByName("GMT") : options.getTimezone()),
-        isUTC(isInstantType || options.getTimezoneName() == "GMT") {
+        isUTC(isInstantType || options.getTimezoneName() == "GMT"),
+        variants(timezone) {
     std::unique_ptr<BufferedOutputStream> dataStream =
-        factory.createStream(proto::Stream_Kind_DATA);
+        factory.createStream(proto::Stream_Kind_DATA, columnId);
     std::unique_ptr<BufferedOutputStream> secondaryStream =
-        factory.createStream(proto::Stream_Kind_SECONDARY);
+        factory.createStream(proto::Stream_Kind_SECONDARY, columnId);
     secRleEncoder = createRleEncoder(std::move(dataStream), true, rleVersion, memPool,
                                      options.getAlignedBitpacking());
     nanoRleEncoder = createRleEncoder(std::move(secondaryStream), false, rleVersion, memPool,
@@ -1667,27 +1842,6 @@ namespace orc {
     }
   }
 
-  // Because the number of nanoseconds often has a large number of trailing zeros,
-  // the number has trailing decimal zero digits removed and the last three bits
-  // are used to record how many zeros were removed if the trailing zeros are
-  // more than 2. Thus 1000 nanoseconds would be serialized as 0x0a and
-  // 100000 would be serialized as 0x0c.
-  static int64_t formatNano(int64_t nanos) {
-    if (nanos == 0) {
-      return 0;
-    } else if (nanos % 100 != 0) {
-      return (nanos) << 3;
-    } else {
-      nanos /= 100;
-      int64_t trailingZeros = 1;
-      while (nanos % 10 == 0 && trailingZeros < 7) {
-        nanos /= 10;
-        trailingZeros += 1;
-      }
-      return (nanos) << 3 | trailingZeros;
-    }
-  }
-
   void TimestampColumnWriter::add(ColumnVectorBatch& rowBatch, uint64_t offset, uint64_t numValues,
                                   const char* incomingMask) {
     TimestampVectorBatch* tsBatch = dynamic_cast<TimestampVectorBatch*>(&rowBatch);
@@ -1703,7 +1857,7 @@ namespace orc {
 
     ColumnWriter::add(rowBatch, offset, numValues, incomingMask);
 
-    const char* notNull = tsBatch->hasNulls ? tsBatch->notNull.data() + offset : nullptr;
+    const char* notNull = getNotNull(*tsBatch, offset);
     int64_t* secs = tsBatch->data.data() + offset;
     int64_t* nanos = tsBatch->nanoseconds.data() + offset;
 
@@ -1713,20 +1867,14 @@ namespace orc {
         // TimestampVectorBatch already stores data in UTC
         int64_t millsUTC = secs[i] * 1000 + nanos[i] / 1000000;
         if (!isUTC) {
-          millsUTC = timezone.convertToUTC(secs[i]) * 1000 + nanos[i] / 1000000;
+          int64_t secsUTC = secs[i] + variants.getVariant(secs[i]).gmtOffset;
+          millsUTC = secsUTC * 1000 + nanos[i] / 1000000;
         }
         ++count;
         if (enableBloomFilter) {
           bloomFilter->addLong(millsUTC);
         }
         tsStats->update(millsUTC, static_cast<int32_t>(nanos[i] % 1000000));
-
-        if (secs[i] < 0 && nanos[i] > 999999) {
-          secs[i] += 1;
-        }
-
-        secs[i] -= timezone.getEpoch();
-        nanos[i] = formatNano(nanos[i]);
       }
     }
     tsStats->increase(count);
@@ -1734,6 +1882,7 @@ namespace orc {
       tsStats->setHasNull(true);
     }
 
+    encodeTimestamps(secs, nanos, timezone.getEpoch(), notNull, numValues);
     secRleEncoder->add(secs, numValues, notNull);
     nanoRleEncoder->add(nanos, numValues, notNull);
   }
@@ -1808,24 +1957,18 @@ namespace orc {
     ColumnWriter::add(rowBatch, offset, numValues, incomingMask);
 
     const int64_t* data = longBatch->data.data() + offset;
-    const char* notNull = longBatch->hasNulls ? longBatch->notNull.data() + offset : nullptr;
+    const char* notNull = getNotNull(*longBatch, offset);
 
     rleEncoder->add(data, numValues, notNull);
 
-    uint64_t count = 0;
-    for (uint64_t i = 0; i < numValues; ++i) {
-      if (!notNull || notNull[i]) {
-        ++count;
-        dateStats->update(static_cast<int32_t>(data[i]));
-        if (enableBloomFilter) {
+    if (enableBloomFilter) {
+      for (uint64_t i = 0; i < numValues; ++i) {
+        if (!notNull || notNull[i]) {
           bloomFilter->addLong(data[i]);
         }
       }
     }
-    dateStats->increase(count);
-    if (count < numValues) {
-      dateStats->setHasNull(true);
-    }
+    dateStats->updateBatch(data, notNull, numValues);
   }
 
   class Decimal64ColumnWriter : public ColumnWriter {
@@ -1854,19 +1997,34 @@ namespace orc {
     std::unique_ptr<AppendOnlyBufferedStream> valueStream;
     std::unique_ptr<RleEncoder> scaleEncoder;
 
-   private:
-    char buffer[10];
+    // the number of bytes of the longest varint of 128 bits
+    static const size_t MAX_VARINT128_LENGTH = 19;
+
+    // the varints of a batch are collected here and written to valueStream
+    // together
+    char buffer[1024];
   };
 
+  // write a varint of 64 bits and return the end of it
+  static char* writeVarint64(char* data, uint64_t value) {
+    while (value > 0x7f) {
+      *(data++) = static_cast<char>(0x80 | (value & 0x7f));
+      value >>= 7;
+    }
+    *(data++) = static_cast<char>(value);
+    return data;
+  }
+
   Decimal64ColumnWriter::Decimal64ColumnWriter(const Type& type, const StreamsFactory& factory,
                                                const WriterOptions& options)
       : ColumnWriter(type, factory, options),
         rleVersion(options.getRleVersion()),
         precision(type.getPrecision()),
         scale(type.getScale()) {
-    valueStream.reset(new AppendOnlyBufferedStream(factory.createStream(proto::Stream_Kind_DATA)));
+    valueStream.reset(
+        new AppendOnlyBufferedStream(factory.createStream(proto::Stream_Kind_DATA, columnId)));
     std::unique_ptr<BufferedOutputStream> scaleStream =
-        factory.createStream(proto::Stream_Kind_SECONDARY);
+        factory.createStream(proto::Stream_Kind_SECONDARY, columnId);
     scaleEncoder = createRleEncoder(std::move(scaleStream), true, rleVersion, memPool,
                                     options.getAlignedBitpacking());
 
@@ -1890,25 +2048,18 @@ namespace orc {
 
     ColumnWriter::add(rowBatch, offset, numValues, incomingMask);
 
-    const char* notNull = decBatch->hasNulls ? decBatch->notNull.data() + offset : nullptr;
+    const char* notNull = getNotNull(*decBatch, offset);
     const int64_t* values = decBatch->values.data() + offset;
 
     uint64_t count = 0;
+    char* data = buffer;
     for (uint64_t i = 0; i < numValues; ++i) {
       if (!notNull || notNull[i]) {
-        int64_t val = zigZag(values[i]);
-        char* data = buffer;
-        while (true) {
-          if ((val & ~0x7f) == 0) {
-            *(data++) = (static_cast<char>(val));
-            break;
-          } else {
-            *(data++) = static_cast<char>(0x80 | (val & 0x7f));
-            // cast val to unsigned so as to force 0-fill right shift
-            val = (static_cast<uint64_t>(val) >> 7);
-          }
+        if (data + MAX_VARINT128_LENGTH > buffer + sizeof(buffer)) {
+          valueStream->write(buffer, static_cast<size_t>(data - buffer));
+          data = buffer;
         }
-        valueStream->write(buffer, static_cast<size_t>(data - buffer));
+        data = writeVarint64(data, static_cast<uint64_t>(zigZag(values[i])));
         ++count;
         if (enableBloomFilter) {
           std::string decimal = Decimal(values[i], static_cast<int32_t>(scale)).toString(true);
@@ -1917,6 +2068,7 @@ namespace orc {
         decStats->update(Decimal(values[i], static_cast<int32_t>(scale)));
       }
     }
+    valueStream->write(buffer, static_cast<size_t>(data - buffer));
     decStats->increase(count);
     if (count < numValues) {
       decStats->setHasNull(true);
@@ -1993,7 +2145,7 @@ namespace orc {
         precision(type.getPrecision()),
         scale(type.getScale()) {
     std::unique_ptr<BufferedOutputStream> dataStream =
-        factory.createStream(proto::Stream_Kind_DATA);
+        factory.createStream(proto::Stream_Kind_DATA, columnId);
     valueEncoder = createRleEncoder(std::move(dataStream), true, RleVersion_2, memPool,
                                     options.getAlignedBitpacking());
 
@@ -2018,7 +2170,7 @@ namespace orc {
     ColumnWriter::add(rowBatch, offset, numValues, incomingMask);
 
     const int64_t* data = decBatch->values.data() + offset;
-    const char* notNull = decBatch->hasNulls ? decBatch->notNull.data() + offset : nullptr;
+    const char* notNull = getNotNull(*decBatch, offset);
 
     valueEncoder->add(data, numValues, notNull);
 
@@ -2078,9 +2230,6 @@ namespace orc {
 
     virtual void add(ColumnVectorBatch& rowBatch, uint64_t offset, uint64_t numValues,
                      const char* incomingMask) override;
-
-   private:
-    char buffer[20];
   };
 
   Decimal128ColumnWriter::Decimal128ColumnWriter(const Type& type, const StreamsFactory& factory,
@@ -2090,16 +2239,20 @@ namespace orc {
   }
 
   // Zigzag encoding moves the sign bit to the least significant bit using the
-  // expression (val « 1) ^ (val » 63) and derives its name from the fact that
-  // positive and negative numbers alternate once encoded.
-  Int128 zigZagInt128(const Int128& value) {
-    bool isNegative = value < 0;
-    Int128 val = value.abs();
-    val <<= 1;
-    if (isNegative) {
-      val -= 1;
-    }
-    return val;
+  // expression (val « 1) ^ (val » 127) and derives its name from the fact that
+  // positive and negative numbers alternate once encoded. The encoded value is
+  // written as a varint straight from its two words.
+  static char* writeZigZagInt128(char* data, const Int128& value) {
+    uint64_t sign = static_cast<uint64_t>(value.getHighBits() >> 63);
+    uint64_t low = (value.getLowBits() << 1) ^ sign;
+    uint64_t high = static_cast<uint64_t>(value.getHighBits()) << 1 | value.getLowBits() >> 63;
+    high ^= sign;
+    while (high != 0) {
+      *(data++) = static_cast<char>(0x80 | (low & 0x7f));
+      low = (low >> 7) | (high << 57);
+      high >>= 7;
+    }
+    return writeVarint64(data, low);
   }
 
   void Decimal128ColumnWriter::add(ColumnVectorBatch& rowBatch, uint64_t offset, uint64_t numValues,
@@ -2117,27 +2270,20 @@ namespace orc {
 
     ColumnWriter::add(rowBatch, offset, numValues, incomingMask);
 
-    const char* notNull = decBatch->hasNulls ? decBatch->notNull.data() + offset : nullptr;
+    const char* notNull = getNotNull(*decBatch, offset);
     const Int128* values = decBatch->values.data() + offset;
 
     // The current encoding of decimal columns stores the integer representation
     // of the value as an unbounded length zigzag encoded base 128 varint.
     uint64_t count = 0;
+    char* data = buffer;
     for (uint64_t i = 0; i < numValues; ++i) {
       if (!notNull || notNull[i]) {
-        Int128 val = zigZagInt128(values[i]);
-        char* data = buffer;
-        while (true) {
-          if ((val & ~0x7f) == 0) {
-            *(data++) = (static_cast<char>(val.getLowBits()));
-            break;
-          } else {
-            *(data++) = static_cast<char>(0x80 | (val.getLowBits() & 0x7f));
-            val >>= 7;
-          }
+        if (data + MAX_VARINT128_LENGTH > buffer + sizeof(buffer)) {
+          valueStream->write(buffer, static_cast<size_t>(data - buffer));
+          data = buffer;
         }
-        valueStream->write(buffer, static_cast<size_t>(data - buffer));
-
+        data = writeZigZagInt128(data, values[i]);
         ++count;
         if (enableBloomFilter) {
           std::string decimal = Decimal(values[i], static_cast<int32_t>(scale)).toString(true);
@@ -2146,6 +2292,7 @@ namespace orc {
         decStats->update(Decimal(values[i], static_cast<int32_t>(scale)));
       }
     }
+    valueStream->write(buffer, static_cast<size_t>(data - buffer));
     decStats->increase(count);
     if (count < numValues) {
       decStats->setHasNull(true);
@@ -2178,7 +2325,10 @@ namespace orc {
 
     virtual void createRowIndexEntry() override;
 
+    virtual void createZoneMapEntry() override;
+
     virtual void writeIndex(std::vector<proto::Stream>& streams) const override;
+    virtual void writeZoneMaps(std::map<uint64_t, const proto::RowIndex*>& zoneMaps) const override;
 
     virtual void recordPosition() const override;
 
@@ -2196,7 +2346,7 @@ namespace orc {
                                      const WriterOptions& options)
       : ColumnWriter(type, factory, options), rleVersion(options.getRleVersion()) {
     std::unique_ptr<BufferedOutputStream> lengthStream =
-        factory.createStream(proto::Stream_Kind_LENGTH);
+        factory.createStream(proto::Stream_Kind_LENGTH, columnId);
     lengthEncoder = createRleEncoder(std::move(lengthStream), false, rleVersion, memPool,
                                      options.getAlignedBitpacking());
 
@@ -2228,7 +2378,7 @@ namespace orc {
     ColumnWriter::add(rowBatch, offset, numValues, incomingMask);
 
     int64_t* offsets = listBatch->offsets.data() + offset;
-    const char* notNull = listBatch->hasNulls ? listBatch->notNull.data() + offset : nullptr;
+    const char* notNull = getNotNull(*listBatch, offset);
 
     uint64_t elemOffset = static_cast<uint64_t>(offsets[0]);
     uint64_t totalNumValues = static_cast<uint64_t>(offsets[numValues] - offsets[0]);
@@ -2287,6 +2437,13 @@ namespace orc {
     }
   }
 
+  void ListColumnWriter::writeZoneMaps(std::map<uint64_t, const proto::RowIndex*>& zoneMaps) const {
+    ColumnWriter::writeZoneMaps(zoneMaps);
+    if (child.get()) {
+      child->writeZoneMaps(zoneMaps);
+    }
+  }
+
   uint64_t ListColumnWriter::getEstimatedSize() const {
     uint64_t size = ColumnWriter::getEstimatedSize();
     if (child.get()) {
@@ -2337,6 +2494,13 @@ namespace orc {
     }
   }
 
+  void ListColumnWriter::createZoneMapEntry() {
+    ColumnWriter::createZoneMapEntry();
+    if (child.get()) {
+      child->createZoneMapEntry();
+    }
+  }
+
   void ListColumnWriter::createRowIndexEntry() {
     ColumnWriter::createRowIndexEntry();
     if (child.get()) {
@@ -2386,7 +2550,10 @@ namespace orc {
 
     virtual void createRowIndexEntry() override;
 
+    virtual void createZoneMapEntry() override;
+
     virtual void writeIndex(std::vector<proto::Stream>& streams) const override;
+    virtual void writeZoneMaps(std::map<uint64_t, const proto::RowIndex*>& zoneMaps) const override;
 
     virtual void recordPosition() const override;
 
@@ -2405,7 +2572,7 @@ namespace orc {
                                    const WriterOptions& options)
       : ColumnWriter(type, factory, options), rleVersion(options.getRleVersion()) {
     std::unique_ptr<BufferedOutputStream> lengthStream =
-        factory.createStream(proto::Stream_Kind_LENGTH);
+        factory.createStream(proto::Stream_Kind_LENGTH, columnId);
     lengthEncoder = createRleEncoder(std::move(lengthStream), false, rleVersion, memPool,
                                      options.getAlignedBitpacking());
 
@@ -2441,7 +2608,7 @@ namespace orc {
     ColumnWriter::add(rowBatch, offset, numValues, incomingMask);
 
     int64_t* offsets = mapBatch->offsets.data() + offset;
-    const char* notNull = mapBatch->hasNulls ? mapBatch->notNull.data() + offset : nullptr;
+    const char* notNull = getNotNull(*mapBatch, offset);
 
     uint64_t elemOffset = static_cast<uint64_t>(offsets[0]);
     uint64_t totalNumValues = static_cast<uint64_t>(offsets[numValues] - offsets[0]);
@@ -2510,6 +2677,16 @@ namespace orc {
     }
   }
 
+  void MapColumnWriter::writeZoneMaps(std::map<uint64_t, const proto::RowIndex*>& zoneMaps) const {
+    ColumnWriter::writeZoneMaps(zoneMaps);
+    if (keyWriter.get()) {
+      keyWriter->writeZoneMaps(zoneMaps);
+    }
+    if (elemWriter.get()) {
+      elemWriter->writeZoneMaps(zoneMaps);
+    }
+  }
+
   uint64_t MapColumnWriter::getEstimatedSize() const {
     uint64_t size = ColumnWriter::getEstimatedSize();
     size += lengthEncoder->getBufferSize();
@@ -2578,6 +2755,16 @@ namespace orc {
     }
   }
 
+  void MapColumnWriter::createZoneMapEntry() {
+    ColumnWriter::createZoneMapEntry();
+    if (keyWriter.get()) {
+      keyWriter->createZoneMapEntry();
+    }
+    if (elemWriter.get()) {
+      elemWriter->createZoneMapEntry();
+    }
+  }
+
   void MapColumnWriter::createRowIndexEntry() {
     ColumnWriter::createRowIndexEntry();
     if (keyWriter.get()) {
@@ -2636,7 +2823,10 @@ namespace orc {
 
     virtual void createRowIndexEntry() override;
 
+    virtual void createZoneMapEntry() override;
+
     virtual void writeIndex(std::vector<proto::Stream>& streams) const override;
+    virtual void writeZoneMaps(std::map<uint64_t, const proto::RowIndex*>& zoneMaps) const override;
 
     virtual void recordPosition() const override;
 
@@ -2653,7 +2843,7 @@ namespace orc {
                                        const WriterOptions& options)
       : ColumnWriter(type, factory, options) {
     std::unique_ptr<BufferedOutputStream> dataStream =
-        factory.createStream(proto::Stream_Kind_DATA);
+        factory.createStream(proto::Stream_Kind_DATA, columnId);
     rleEncoder = createByteRleEncoder(std::move(dataStream));
 
     for (uint64_t i = 0; i != type.getSubtypeCount(); ++i) {
@@ -2674,7 +2864,7 @@ namespace orc {
 
     ColumnWriter::add(rowBatch, offset, numValues, incomingMask);
 
-    const char* notNull = unionBatch->hasNulls ? unionBatch->notNull.data() + offset : nullptr;
+    const char* notNull = getNotNull(*unionBatch, offset);
     unsigned char* tags = unionBatch->tags.data() + offset;
     uint64_t* offsets = unionBatch->offsets.data() + offset;
 
@@ -2740,6 +2930,14 @@ namespace orc {
     }
   }
 
+  void UnionColumnWriter::writeZoneMaps(
+      std::map<uint64_t, const proto::RowIndex*>& zoneMaps) const {
+    ColumnWriter::writeZoneMaps(zoneMaps);
+    for (uint32_t i = 0; i < children.size(); ++i) {
+      children[i]->writeZoneMaps(zoneMaps);
+    }
+  }
+
   uint64_t UnionColumnWriter::getEstimatedSize() const {
     uint64_t size = ColumnWriter::getEstimatedSize();
     size += rleEncoder->getBufferSize();
@@ -2790,6 +2988,13 @@ namespace orc {
     }
   }
 
+  void UnionColumnWriter::createZoneMapEntry() {
+    ColumnWriter::createZoneMapEntry();
+    for (uint32_t i = 0; i < children.size(); ++i) {
+      children[i]->createZoneMapEntry();
+    }
+  }
+
   void UnionColumnWriter::createRowIndexEntry() {
     ColumnWriter::createRowIndexEntry();
     for (uint32_t i = 0; i < children.size(); ++i) {
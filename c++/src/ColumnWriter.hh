@@ -29,6 +29,9 @@
 
 #include "wrap/orc-proto-wrapper.hh"
 
+#include <map>
+#include <string>
+
 namespace orc {
 
   class StreamsFactory {
@@ -38,9 +41,11 @@ namespace orc {
     /**
      * Get the stream for the given column/kind in this stripe.
      * @param kind the kind of the stream
+     * @param columnId the column that writes the stream
      * @return the buffered output stream
      */
-    virtual std::unique_ptr<BufferedOutputStream> createStream(proto::Stream_Kind kind) const = 0;
+    virtual std::unique_ptr<BufferedOutputStream> createStream(proto::Stream_Kind kind,
+                                                               uint64_t columnId) const = 0;
   };
 
   std::unique_ptr<StreamsFactory> createStreamsFactory(const WriterOptions& options,
@@ -85,6 +90,12 @@ namespace orc {
     std::unique_ptr<BloomFilterImpl> bloomFilter;
     std::unique_ptr<proto::BloomFilterIndex> bloomFilterIndex;
 
+    // zone maps are recorded per page of rows inside a row group
+    bool enableZoneMap;
+    std::unique_ptr<proto::RowIndex> zoneMap;
+    // statistics of the closed pages of the current row group
+    std::unique_ptr<MutableColumnStatistics> colPagesStatistics;
+
    public:
     ColumnWriter(const Type& type, const StreamsFactory& factory, const WriterOptions& options);
 
@@ -154,12 +165,26 @@ namespace orc {
      */
     virtual void addBloomFilterEntry();
 
+    /**
+     * Close the current zone map page with the index statistics gathered since
+     * the previous page, and ensure all of the children columns do the same.
+     * The row index entry is built from all pages of the row group.
+     */
+    virtual void createZoneMapEntry();
+
     /**
      * Write row index streams for this column.
      * @param streams output list of ROW_INDEX streams
      */
     virtual void writeIndex(std::vector<proto::Stream>& streams) const;
 
+    /**
+     * Collect the zone maps of the current stripe for this column and all of
+     * the children columns that record them.
+     * @param zoneMaps output zone maps with column id as the key
+     */
+    virtual void writeZoneMaps(std::map<uint64_t, const proto::RowIndex*>& zoneMaps) const;
+
     /**
      * Record positions for index.
      *
@@ -198,6 +223,20 @@ namespace orc {
     std::unique_ptr<BufferedOutputStream> indexStream;
     std::unique_ptr<BufferedOutputStream> bloomFilterStream;
     bool hasNullValue;
+    // the not null flags of batches that use not null bitmaps, expanded to
+    // one byte per value for the encoders
+    DataBuffer<char> notNullBytes;
+
+    /**
+     * Get the not null flags of the values added by ColumnWriter::add() with
+     * one byte per value, or nullptr if the batch has no nulls.
+     */
+    const char* getNotNull(const ColumnVectorBatch& batch, uint64_t offset) const {
+      if (!batch.hasNulls) {
+        return nullptr;
+      }
+      return batch.useNotNullBitmap ? notNullBytes.data() : batch.notNull.data() + offset;
+    }
   };
 
   /**
@@ -760,7 +760,7 @@ namespace orc {
     } else {
       // Did not read enough from input.
       if (inputDataBuffer.capacity() < remainingLength) {
-        inputDataBuffer.resize(remainingLength);
+        inputDataBuffer.resizeUninitialized(remainingLength);
       }
       ::memcpy(inputDataBuffer.data(), inputBuffer, availableSize);
       inputBuffer += availableSize;
@@ -928,7 +928,7 @@ namespace orc {
     *data = rawInputBuffer.data();
     *size = static_cast<int>(rawInputBuffer.size());
     bufferSize = *size;
-    compressorBuffer.resize(estimateMaxCompressionSize());
+    compressorBuffer.resizeUninitialized(estimateMaxCompressionSize());
 
     return true;
   }
@@ -18,6 +18,10 @@
 
 #include "ConvertColumnReader.hh"
 
+#include <cerrno>
+#include <charconv>
+#include <limits>
+
 namespace orc {
 
   // Assume that we are using tight numeric vector batch
@@ -33,6 +37,9 @@ namespace orc {
   }
 
   void ConvertColumnReader::next(ColumnVectorBatch& rowBatch, uint64_t numValues, char* notNull) {
+    if (rowBatch.useNotNullBitmap) {
+      throw NotImplementedYet("Schema evolution does not support not null bitmaps");
+    }
     reader->next(*data, numValues, notNull);
     rowBatch.resize(data->capacity);
     rowBatch.numElements = data->numElements;
@@ -134,6 +141,15 @@ namespace orc {
   // { byte, short, int, long, float, double }
   template <typename FileTypeBatch, typename ReadTypeBatch, typename ReadType>
   class NumericConvertColumnReader : public ConvertColumnReader {
+    using FileType = std::decay_t<decltype(std::declval<const FileTypeBatch&>().data[0])>;
+
+    // whether every value of the file type fits in the read type, like int to
+    // bigint or float to double
+    static constexpr bool isWidening =
+        std::is_floating_point<ReadType>::value
+            ? !std::is_floating_point<FileType>::value || sizeof(ReadType) >= sizeof(FileType)
+            : !std::is_floating_point<FileType>::value && sizeof(ReadType) >= sizeof(FileType);
+
    public:
     NumericConvertColumnReader(const Type& _readType, const Type& fileType, StripeStreams& stripe,
                                bool _throwOnOverflow)
@@ -143,6 +159,16 @@ namespace orc {
       ConvertColumnReader::next(rowBatch, numValues, notNull);
       const auto& srcBatch = *SafeCastBatchTo<const FileTypeBatch*>(data.get());
       auto& dstBatch = *SafeCastBatchTo<ReadTypeBatch*>(&rowBatch);
+      if constexpr (isWidening) {
+        // nothing can overflow, so the null slots are converted along with the
+        // values in a loop the compiler vectorizes
+        const FileType* src = srcBatch.data.data();
+        ReadType* dst = dstBatch.data.data();
+        for (uint64_t i = 0; i < rowBatch.numElements; ++i) {
+          dst[i] = static_cast<ReadType>(src[i]);
+        }
+        return;
+      }
       if (rowBatch.hasNulls) {
         for (uint64_t i = 0; i < rowBatch.numElements; ++i) {
           if (rowBatch.notNull[i]) {
@@ -192,35 +218,57 @@ namespace orc {
                                        StripeStreams& stripe, bool _throwOnOverflow)
         : ConvertColumnReader(_readType, fileType, stripe, _throwOnOverflow) {}
 
-    void next(ColumnVectorBatch& rowBatch, uint64_t numValues, char* notNull) override;
-
-    virtual uint64_t convertToStrBuffer(ColumnVectorBatch& rowBatch, uint64_t numValues) = 0;
-
    protected:
-    std::vector<std::string> strBuffer;
+    // Format the non-null values straight into the blob of the string batch.
+    // format(idx, out) writes at most maxFormattedLength chars to out and
+    // returns their number. Values longer than the maximum length of a
+    // VARCHAR or CHAR overflow and CHAR values are padded with spaces.
+    template <typename FileType, typename Formatter>
+    void formatStrings(ColumnVectorBatch& rowBatch, uint64_t maxFormattedLength,
+                       Formatter format);
   };
 
-  void ConvertToStringVariantColumnReader::next(ColumnVectorBatch& rowBatch, uint64_t numValues,
-                                                char* notNull) {
-    ConvertColumnReader::next(rowBatch, numValues, notNull);
-
-    // cache converted string in the buffer
-    auto totalLength = convertToStrBuffer(rowBatch, numValues);
-
-    // contact string values to blob buffer of vector batch
+  template <typename FileType, typename Formatter>
+  void ConvertToStringVariantColumnReader::formatStrings(ColumnVectorBatch& rowBatch,
+                                                         uint64_t maxFormattedLength,
+                                                         Formatter format) {
     auto& dstBatch = *SafeCastBatchTo<StringVectorBatch*>(&rowBatch);
-    dstBatch.blob.resize(totalLength);
-    char* blob = dstBatch.blob.data();
-    for (uint64_t i = 0; i < numValues; ++i) {
+    const auto kind = readType.getKind();
+    const uint64_t maxLength =
+        kind == STRING ? std::numeric_limits<uint64_t>::max() : readType.getMaximumLength();
+    const uint64_t padLength = kind == CHAR ? maxLength : 0;
+    const uint64_t reservedLength = std::max(maxFormattedLength, padLength);
+    auto& blob = dstBatch.blob;
+    uint64_t blobSize = 0;
+    for (uint64_t i = 0; i < rowBatch.numElements; ++i) {
       if (!rowBatch.hasNulls || rowBatch.notNull[i]) {
-        const auto size = strBuffer[i].size();
-        ::memcpy(blob, strBuffer[i].c_str(), size);
-        dstBatch.data[i] = blob;
-        dstBatch.length[i] = static_cast<int32_t>(size);
-        blob += size;
+        if (blob.size() < blobSize + reservedLength) {
+          blob.resizeUninitialized(blobSize + reservedLength);
+        }
+        char* out = blob.data() + blobSize;
+        uint64_t length = format(i, out);
+        if (length > maxLength) {
+          handleOverflow<FileType, std::string>(rowBatch, i, throwOnOverflow);
+          continue;
+        }
+        if (length < padLength) {
+          memset(out + length, ' ', padLength - length);
+          length = padLength;
+        }
+        dstBatch.length[i] = static_cast<int64_t>(length);
+        blobSize += length;
+      }
+    }
+    blob.resizeUninitialized(blobSize);
+
+    // the blob may have moved while growing, so point at the values last
+    char* value = blob.data();
+    for (uint64_t i = 0; i < rowBatch.numElements; ++i) {
+      if (!rowBatch.hasNulls || rowBatch.notNull[i]) {
+        dstBatch.data[i] = value;
+        value += dstBatch.length[i];
       }
     }
-    strBuffer.clear();
   }
 
   class BooleanToStringVariantColumnReader : public ConvertToStringVariantColumnReader {
@@ -228,95 +276,154 @@ namespace orc {
     BooleanToStringVariantColumnReader(const Type& _readType, const Type& fileType,
                                        StripeStreams& stripe, bool _throwOnOverflow)
         : ConvertToStringVariantColumnReader(_readType, fileType, stripe, _throwOnOverflow) {
-      trueValue = "TRUE";
-      falseValue = "FALSE";
       if (readType.getKind() == CHAR || readType.getKind() == VARCHAR) {
         if (readType.getMaximumLength() < 5) {
           throw SchemaEvolutionError("Invalid maximum length for boolean type: " +
                                      std::to_string(readType.getMaximumLength()));
         }
-        if (readType.getKind() == CHAR) {
-          trueValue.resize(readType.getMaximumLength(), ' ');
-          falseValue.resize(readType.getMaximumLength(), ' ');
-        }
       }
     }
 
-    uint64_t convertToStrBuffer(ColumnVectorBatch& rowBatch, uint64_t numValues) override;
-
-   private:
-    std::string trueValue;
-    std::string falseValue;
+    void next(ColumnVectorBatch& rowBatch, uint64_t numValues, char* notNull) override {
+      ConvertColumnReader::next(rowBatch, numValues, notNull);
+      const int8_t* values = SafeCastBatchTo<const BooleanVectorBatch*>(data.get())->data.data();
+      formatStrings<bool>(rowBatch, 5, [values](uint64_t idx, char* out) -> uint64_t {
+        if (values[idx]) {
+          memcpy(out, "TRUE", 4);
+          return 4;
+        }
+        memcpy(out, "FALSE", 5);
+        return 5;
+      });
+    }
   };
 
-  uint64_t BooleanToStringVariantColumnReader::convertToStrBuffer(ColumnVectorBatch& rowBatch,
-                                                                  uint64_t numValues) {
-    uint64_t size = 0;
-    strBuffer.resize(numValues);
-    const auto& srcBatch = *SafeCastBatchTo<const BooleanVectorBatch*>(data.get());
-    // cast the bool value to string
-    for (uint64_t i = 0; i < numValues; ++i) {
-      if (!rowBatch.hasNulls || rowBatch.notNull[i]) {
-        strBuffer[i] = (srcBatch.data[i] ? trueValue : falseValue);
-        size += strBuffer[i].size();
-      }
+  // the longest formatting of a number, like the 309 integral digits, sign,
+  // point and six fractional digits of -DBL_MAX in fixed notation plus the
+  // null terminating the output of snprintf()
+  template <typename T>
+  constexpr uint64_t maxFormattedLength() {
+    if constexpr (std::is_floating_point<T>::value) {
+      return std::numeric_limits<T>::max_exponent10 + 10;
+    } else {
+      return std::numeric_limits<T>::digits10 + 2;
+    }
+  }
+
+  // Format a number like std::to_string() does, with "%f" for floating point
+  // numbers, but without allocating a string. Returns the formatted length.
+  template <typename T>
+  static inline uint64_t formatNumber(T value, char* out) {
+    if constexpr (std::is_floating_point<T>::value) {
+#if defined(__cpp_lib_to_chars)
+      auto result = std::to_chars(out, out + maxFormattedLength<T>(), static_cast<double>(value),
+                                  std::chars_format::fixed, 6);
+      return static_cast<uint64_t>(result.ptr - out);
+#else
+      return static_cast<uint64_t>(
+          snprintf(out, maxFormattedLength<T>(), "%f", static_cast<double>(value)));
+#endif
+    } else {
+      auto result = std::to_chars(out, out + maxFormattedLength<T>(), value);
+      return static_cast<uint64_t>(result.ptr - out);
     }
-    return size;
   }
 
   template <typename FileTypeBatch>
   class NumericToStringVariantColumnReader : public ConvertToStringVariantColumnReader {
+    using FileType = std::decay_t<decltype(std::declval<const FileTypeBatch&>().data[0])>;
+
    public:
     NumericToStringVariantColumnReader(const Type& _readType, const Type& fileType,
                                        StripeStreams& stripe, bool _throwOnOverflow)
         : ConvertToStringVariantColumnReader(_readType, fileType, stripe, _throwOnOverflow) {}
-    uint64_t convertToStrBuffer(ColumnVectorBatch& rowBatch, uint64_t numValues) override;
+
+    void next(ColumnVectorBatch& rowBatch, uint64_t numValues, char* notNull) override {
+      ConvertColumnReader::next(rowBatch, numValues, notNull);
+      const FileType* values = SafeCastBatchTo<const FileTypeBatch*>(data.get())->data.data();
+      formatStrings<FileType>(
+          rowBatch, maxFormattedLength<FileType>(),
+          [values](uint64_t idx, char* out) { return formatNumber(values[idx], out); });
+    }
   };
 
-  template <typename FileTypeBatch>
-  uint64_t NumericToStringVariantColumnReader<FileTypeBatch>::convertToStrBuffer(
-      ColumnVectorBatch& rowBatch, uint64_t numValues) {
-    uint64_t size = 0;
-    strBuffer.resize(numValues);
-    const auto& srcBatch = *SafeCastBatchTo<const FileTypeBatch*>(data.get());
-    if (readType.getKind() == STRING) {
-      for (uint64_t i = 0; i < numValues; ++i) {
-        if (!rowBatch.hasNulls || rowBatch.notNull[i]) {
-          strBuffer[i] = std::to_string(srcBatch.data[i]);
-          size += strBuffer[i].size();
-        }
+  // Parse a whole string as a number of the given type. Returns false if the
+  // string is not a number or the number is out of the range of the type.
+  template <typename T>
+  static bool parseNumber(const char* begin, const char* end, T& value) {
+    // from_chars() does not accept the leading plus sign that Java does
+    if (begin != end && *begin == '+') {
+      ++begin;
+      if (begin != end && *begin == '-') {
+        return false;
       }
-    } else if (readType.getKind() == VARCHAR) {
-      const auto maxLength = readType.getMaximumLength();
-      for (uint64_t i = 0; i < numValues; ++i) {
-        if (!rowBatch.hasNulls || rowBatch.notNull[i]) {
-          strBuffer[i] = std::to_string(srcBatch.data[i]);
-          if (strBuffer[i].size() > maxLength) {
-            handleOverflow<decltype(srcBatch.data[i]), std::string>(rowBatch, i, throwOnOverflow);
-          } else {
-            size += strBuffer[i].size();
-          }
-        }
+    }
+    if constexpr (std::is_floating_point<T>::value) {
+#if defined(__cpp_lib_to_chars)
+      auto result = std::from_chars(begin, end, value);
+      return result.ec == std::errc() && result.ptr == end;
+#else
+      // strtod() needs a terminated string and skips leading spaces
+      std::string str(begin, end);
+      if (str.empty() || isspace(static_cast<unsigned char>(str[0]))) {
+        return false;
       }
-    } else if (readType.getKind() == CHAR) {
-      const auto maxLength = readType.getMaximumLength();
-      for (uint64_t i = 0; i < numValues; ++i) {
+      char* parsed;
+      errno = 0;
+      if constexpr (std::is_same<T, float>::value) {
+        value = strtof(str.c_str(), &parsed);
+      } else {
+        value = strtod(str.c_str(), &parsed);
+      }
+      return errno != ERANGE && parsed == str.c_str() + str.size();
+#endif
+    } else {
+      auto result = std::from_chars(begin, end, value);
+      return result.ec == std::errc() && result.ptr == end;
+    }
+  }
+
+  // { string, char, varchar } -> { boolean, byte, short, int, long, float, double }
+  template <typename ReadTypeBatch, typename ReadType>
+  class StringVariantToNumericColumnReader : public ConvertColumnReader {
+   public:
+    StringVariantToNumericColumnReader(const Type& _readType, const Type& fileType,
+                                       StripeStreams& stripe, bool _throwOnOverflow)
+        : ConvertColumnReader(_readType, fileType, stripe, _throwOnOverflow),
+          trimTrailingSpaces(fileType.getKind() == CHAR) {}
+
+    void next(ColumnVectorBatch& rowBatch, uint64_t numValues, char* notNull) override {
+      ConvertColumnReader::next(rowBatch, numValues, notNull);
+      const auto& srcBatch = *SafeCastBatchTo<const StringVectorBatch*>(data.get());
+      auto& dstBatch = *SafeCastBatchTo<ReadTypeBatch*>(&rowBatch);
+      for (uint64_t i = 0; i < rowBatch.numElements; ++i) {
         if (!rowBatch.hasNulls || rowBatch.notNull[i]) {
-          strBuffer[i] = std::to_string(srcBatch.data[i]);
-          if (strBuffer[i].size() > maxLength) {
-            handleOverflow<decltype(srcBatch.data[i]), std::string>(rowBatch, i, throwOnOverflow);
-          } else {
-            strBuffer[i].resize(maxLength, ' ');
-            size += strBuffer[i].size();
+          const char* begin = srcBatch.data[i];
+          const char* end = begin + srcBatch.length[i];
+          if (trimTrailingSpaces) {
+            while (end != begin && end[-1] == ' ') {
+              --end;
+            }
+          }
+          if constexpr (std::is_same<ReadType, bool>::value) {
+            // like the integer to boolean conversions, any non-zero value is true
+            int64_t value;
+            if (parseNumber(begin, end, value)) {
+              dstBatch.data[i] = value != 0;
+            } else {
+              handleOverflow<std::string, ReadType>(rowBatch, i, throwOnOverflow);
+            }
+          } else if (!parseNumber(begin, end, dstBatch.data[i])) {
+            handleOverflow<std::string, ReadType>(rowBatch, i, throwOnOverflow);
           }
         }
       }
-    } else {
-      throw SchemaEvolutionError("Invalid type for numeric to string conversion: " +
-                                 readType.toString());
     }
-    return size;
-  }
+
+   private:
+    // CHAR values are padded with spaces to their maximum length
+    const bool trimTrailingSpaces;
+  };
 
   template <typename FileTypeBatch, typename ReadTypeBatch, bool isFloatingFileType>
   class NumericToDecimalColumnReader : public ConvertColumnReader {
@@ -551,13 +658,38 @@ namespace orc {
       fromScale = fileType.getScale();
       toPrecision = _readType.getPrecision();
       toScale = _readType.getScale();
+      // the decimals of Hive 0.11 have no precision and are rescaled by their
+      // reader
+      isWidening = fromPrecision > 0 && toScale >= fromScale &&
+                   toPrecision - toScale >= fromPrecision - fromScale;
+      if (isWidening) {
+        bool overflow = false;
+        scaleMultiplier = scaleUpInt128ByPowerOfTen(1, toScale - fromScale, overflow);
+      }
     }
 
     void next(ColumnVectorBatch& rowBatch, uint64_t numValues, char* notNull) override {
+      if constexpr (std::is_same_v<FileTypeBatch, ReadTypeBatch>) {
+        if (isWidening && fromScale == toScale) {
+          // the unscaled values stay the same, so they are read straight into
+          // the batch
+          reader->next(rowBatch, numValues, notNull);
+          auto& dstBatch = *SafeCastBatchTo<ReadTypeBatch*>(&rowBatch);
+          dstBatch.precision = toPrecision;
+          dstBatch.scale = toScale;
+          return;
+        }
+      }
       ConvertColumnReader::next(rowBatch, numValues, notNull);
 
       const auto& srcBatch = *SafeCastBatchTo<const FileTypeBatch*>(data.get());
       auto& dstBatch = *SafeCastBatchTo<ReadTypeBatch*>(&rowBatch);
+      dstBatch.precision = toPrecision;
+      dstBatch.scale = toScale;
+      if (isWidening) {
+        widenDecimals(dstBatch, srcBatch);
+        return;
+      }
       for (uint64_t i = 0; i < numValues; ++i) {
         if (!rowBatch.hasNulls || rowBatch.notNull[i]) {
           convertDecimalToDecimal(dstBatch, i, srcBatch);
@@ -566,6 +698,32 @@ namespace orc {
     }
 
    private:
+    // rescale values that cannot overflow the read type without checking them
+    void widenDecimals(ReadTypeBatch& dstBatch, const FileTypeBatch& srcBatch) {
+      const uint64_t numValues = dstBatch.numElements;
+      if constexpr (std::is_same_v<ReadTypeBatch, Decimal64VectorBatch>) {
+        // the file type has at most the precision of the read type, so a
+        // widening conversion never comes from a Decimal128
+        if constexpr (std::is_same_v<FileTypeBatch, Decimal64VectorBatch>) {
+          uint64_t multiplier = scaleMultiplier.getLowBits();
+          const int64_t* src = srcBatch.values.data();
+          int64_t* dst = dstBatch.values.data();
+          for (uint64_t i = 0; i < numValues; ++i) {
+            dst[i] = static_cast<int64_t>(static_cast<uint64_t>(src[i]) * multiplier);
+          }
+        }
+      } else {
+        for (uint64_t i = 0; i < numValues; ++i) {
+          if (!dstBatch.hasNulls || dstBatch.notNull[i]) {
+            dstBatch.values[i] = srcBatch.values[i];
+            if (toScale != fromScale) {
+              dstBatch.values[i] *= scaleMultiplier;
+            }
+          }
+        }
+      }
+    }
+
     void convertDecimalToDecimal(ReadTypeBatch& dstBatch, uint64_t idx,
                                  const FileTypeBatch& srcBatch) {
       using FileType = decltype(srcBatch.values[idx]);
@@ -591,6 +749,8 @@ namespace orc {
     int32_t fromScale;
     int32_t toPrecision;
     int32_t toScale;
+    bool isWidening;
+    Int128 scaleMultiplier;
   };
 
 #define DEFINE_NUMERIC_CONVERT_READER(FROM, TO, TYPE) \
@@ -600,6 +760,10 @@ namespace orc {
 #define DEFINE_NUMERIC_CONVERT_TO_STRING_VARINT_READER(FROM, TO) \
   using FROM##To##TO##ColumnReader = NumericToStringVariantColumnReader<FROM##VectorBatch>;
 
+#define DEFINE_STRING_VARIANT_CONVERT_TO_NUMERIC_READER(TO, TYPE) \
+  using StringVariantTo##TO##ColumnReader =                        \
+      StringVariantToNumericColumnReader<TO##VectorBatch, TYPE>;
+
 #define DEFINE_NUMERIC_CONVERT_TO_DECIMAL_READER(FROM, IS_FROM_FLOATING)                       \
   using FROM##To##Decimal64##ColumnReader =                                                    \
       NumericToDecimalColumnReader<FROM##VectorBatch, Decimal64VectorBatch, IS_FROM_FLOATING>; \
@@ -689,6 +853,15 @@ namespace orc {
   using BooleanToCharColumnReader = BooleanToStringVariantColumnReader;
   using BooleanToVarcharColumnReader = BooleanToStringVariantColumnReader;
 
+  // String/Char/Varchar to Numeric
+  DEFINE_STRING_VARIANT_CONVERT_TO_NUMERIC_READER(Boolean, bool)
+  DEFINE_STRING_VARIANT_CONVERT_TO_NUMERIC_READER(Byte, int8_t)
+  DEFINE_STRING_VARIANT_CONVERT_TO_NUMERIC_READER(Short, int16_t)
+  DEFINE_STRING_VARIANT_CONVERT_TO_NUMERIC_READER(Int, int32_t)
+  DEFINE_STRING_VARIANT_CONVERT_TO_NUMERIC_READER(Long, int64_t)
+  DEFINE_STRING_VARIANT_CONVERT_TO_NUMERIC_READER(Float, float)
+  DEFINE_STRING_VARIANT_CONVERT_TO_NUMERIC_READER(Double, double)
+
   // Numeric to Decimal
   DEFINE_NUMERIC_CONVERT_TO_DECIMAL_READER(Boolean, false)
   DEFINE_NUMERIC_CONVERT_TO_DECIMAL_READER(Byte, false)
@@ -936,6 +1109,31 @@ namespace orc {
         }
       }
       case STRING:
+      case CHAR:
+      case VARCHAR: {
+        switch (_readType.getKind()) {
+          CASE_CREATE_READER(BOOLEAN, StringVariantToBoolean)
+          CASE_CREATE_READER(BYTE, StringVariantToByte)
+          CASE_CREATE_READER(SHORT, StringVariantToShort)
+          CASE_CREATE_READER(INT, StringVariantToInt)
+          CASE_CREATE_READER(LONG, StringVariantToLong)
+          CASE_CREATE_READER(FLOAT, StringVariantToFloat)
+          CASE_CREATE_READER(DOUBLE, StringVariantToDouble)
+          case STRING:
+          case CHAR:
+          case VARCHAR:
+          case TIMESTAMP:
+          case TIMESTAMP_INSTANT:
+          case BINARY:
+          case LIST:
+          case MAP:
+          case STRUCT:
+          case UNION:
+          case DECIMAL:
+          case DATE:
+            CASE_EXCEPTION
+        }
+      }
       case BINARY:
       case TIMESTAMP:
       case LIST:
@@ -981,8 +1179,6 @@ namespace orc {
         }
       }
       case DATE:
-      case VARCHAR:
-      case CHAR:
       case TIMESTAMP_INSTANT:
         CASE_EXCEPTION
     }
@@ -990,6 +1186,7 @@ namespace orc {
 
 #undef DEFINE_NUMERIC_CONVERT_READER
 #undef DEFINE_NUMERIC_CONVERT_TO_STRING_VARINT_READER
+#undef DEFINE_STRING_VARIANT_CONVERT_TO_NUMERIC_READER
 #undef DEFINE_NUMERIC_CONVERT_TO_DECIMAL_READER
 #undef DEFINE_NUMERIC_CONVERT_TO_TIMESTAMP_READER
 #undef DEFINE_DECIMAL_CONVERT_TO_NUMERIC_READER
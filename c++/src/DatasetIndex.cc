@@ -0,0 +1,355 @@
+/**
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "orc/DatasetIndex.hh"
+#include "orc/Exceptions.hh"
+
+#include "BloomFilter.hh"
+#include "Reader.hh"
+#include "TypeImpl.hh"
+#include "sargs/SargsApplier.hh"
+
+#include <algorithm>
+#include <map>
+#include <unordered_map>
+
+namespace orc {
+
+  /**
+   * The dataset index is a sequence of varints and length-prefixed byte
+   * strings:
+   *
+   *   "ORCIDX" version numberOfFiles
+   *   for each file:
+   *     name fileTail metadata numberOfBloomFilterColumns
+   *     for each bloom filter column:
+   *       columnId
+   *       for each stripe:
+   *         bloomFilterIndex
+   *
+   * where fileTail, metadata and bloomFilterIndex are the serialized
+   * proto::FileTail, proto::Metadata and proto::BloomFilterIndex. The bloom
+   * filters of the row groups are kept as they are: merging them into one
+   * filter per stripe would saturate it, since each of them is sized for the
+   * rows of one row group. Entries without a bitset are not usable.
+   */
+  static const char DATASET_INDEX_MAGIC[] = "ORCIDX";
+  static const size_t DATASET_INDEX_MAGIC_LENGTH = sizeof(DATASET_INDEX_MAGIC) - 1;
+  static const uint64_t DATASET_INDEX_VERSION = 1;
+
+  DatasetIndexBuilder::~DatasetIndexBuilder() {
+    // PASS
+  }
+
+  DatasetIndex::~DatasetIndex() {
+    // PASS
+  }
+
+  struct IndexedFile {
+    std::string name;
+    proto::FileTail tail;
+    proto::Metadata metadata;
+    // bloom filters of each column, one index per stripe
+    std::map<uint32_t, std::vector<proto::BloomFilterIndex>> bloomFilters;
+
+    // derived when the index is read
+    std::unique_ptr<Type> schema;
+    // bloom filters of each stripe and row group, keyed by column id
+    std::vector<std::vector<std::unordered_map<uint64_t, const BloomFilter*>>> rowGroupBloomFilters;
+    std::vector<std::unique_ptr<BloomFilter>> bloomFilterPool;
+  };
+
+  static void writeVarint(std::string& out, uint64_t value) {
+    while (value >= 0x80) {
+      out.push_back(static_cast<char>((value & 0x7f) | 0x80));
+      value >>= 7;
+    }
+    out.push_back(static_cast<char>(value));
+  }
+
+  static void writeBytes(std::string& out, const std::string& bytes) {
+    writeVarint(out, bytes.size());
+    out.append(bytes);
+  }
+
+  static void writeMessage(std::string& out, const google::protobuf::MessageLite& message) {
+    std::string bytes;
+    if (!message.SerializeToString(&bytes)) {
+      throw std::logic_error("Failed to serialize the dataset index");
+    }
+    writeBytes(out, bytes);
+  }
+
+  class DatasetIndexParser {
+   public:
+    DatasetIndexParser(const std::string& _data, const std::string& _name)
+        : data(_data), name(_name), position(0) {}
+
+    uint64_t readVarint() {
+      uint64_t value = 0;
+      for (uint32_t shift = 0; shift < 64; shift += 7) {
+        checkRemaining(1);
+        auto byte = static_cast<unsigned char>(data[position++]);
+        value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+        if ((byte & 0x80) == 0) {
+          return value;
+        }
+      }
+      throw ParseError("Malformed varint in dataset index " + name);
+    }
+
+    // read the number of entries that follow, each taking at least one byte
+    uint64_t readCount() {
+      uint64_t count = readVarint();
+      checkRemaining(count);
+      return count;
+    }
+
+    std::string readBytes() {
+      uint64_t length = readVarint();
+      checkRemaining(length);
+      std::string bytes = data.substr(position, length);
+      position += length;
+      return bytes;
+    }
+
+    void readMessage(google::protobuf::MessageLite& message) {
+      if (!message.ParseFromString(readBytes())) {
+        throw ParseError("Failed to parse dataset index " + name);
+      }
+    }
+
+    void readMagic() {
+      checkRemaining(DATASET_INDEX_MAGIC_LENGTH);
+      if (data.compare(0, DATASET_INDEX_MAGIC_LENGTH, DATASET_INDEX_MAGIC) != 0) {
+        throw ParseError("Not a dataset index: " + name);
+      }
+      position += DATASET_INDEX_MAGIC_LENGTH;
+    }
+
+   private:
+    void checkRemaining(uint64_t length) const {
+      if (length > data.size() - position) {
+        throw ParseError("Truncated dataset index " + name);
+      }
+    }
+
+    const std::string& data;
+    const std::string& name;
+    size_t position;
+  };
+
+  static void serializeBloomFilters(const BloomFilterIndex& index, proto::BloomFilterIndex& out) {
+    for (const auto& entry : index.entries) {
+      proto::BloomFilter* pbFilter = out.add_bloom_filter();
+      const auto* bloomFilter = dynamic_cast<const BloomFilterImpl*>(entry.get());
+      if (bloomFilter != nullptr) {
+        BloomFilterUTF8Utils::serialize(*bloomFilter, *pbFilter);
+      }
+    }
+  }
+
+  class DatasetIndexBuilderImpl : public DatasetIndexBuilder {
+   public:
+    void addFile(const std::string& fileName, const Reader& reader) override;
+
+    uint64_t getNumberOfFiles() const override {
+      return files.size();
+    }
+
+    void write(OutputStream& stream) const override;
+
+   private:
+    std::vector<IndexedFile> files;
+  };
+
+  void DatasetIndexBuilderImpl::addFile(const std::string& fileName, const Reader& reader) {
+    const auto* readerImpl = dynamic_cast<const ReaderImpl*>(&reader);
+    if (readerImpl == nullptr) {
+      throw InvalidArgument("The reader of " + fileName + " is not created by createReader()");
+    }
+
+    IndexedFile file;
+    file.name = fileName;
+    if (!file.tail.ParseFromString(reader.getSerializedFileTail())) {
+      throw ParseError("Failed to parse the file tail of " + fileName);
+    }
+    const proto::Metadata* metadata = readerImpl->getMetadata();
+    if (metadata != nullptr) {
+      file.metadata = *metadata;
+    }
+
+    if (!hasBadBloomFilters(file.tail.footer())) {
+      auto numberOfStripes = static_cast<uint32_t>(reader.getNumberOfStripes());
+      for (uint32_t stripe = 0; stripe != numberOfStripes; ++stripe) {
+        for (const auto& column : reader.getBloomFilters(stripe, {})) {
+          std::vector<proto::BloomFilterIndex>& stripes = file.bloomFilters[column.first];
+          stripes.resize(numberOfStripes);
+          serializeBloomFilters(column.second, stripes[stripe]);
+        }
+      }
+    }
+
+    files.push_back(std::move(file));
+  }
+
+  void DatasetIndexBuilderImpl::write(OutputStream& stream) const {
+    std::string out(DATASET_INDEX_MAGIC, DATASET_INDEX_MAGIC_LENGTH);
+    writeVarint(out, DATASET_INDEX_VERSION);
+    writeVarint(out, files.size());
+    for (const IndexedFile& file : files) {
+      writeBytes(out, file.name);
+      writeMessage(out, file.tail);
+      writeMessage(out, file.metadata);
+      writeVarint(out, file.bloomFilters.size());
+      for (const auto& column : file.bloomFilters) {
+        writeVarint(out, column.first);
+        for (const proto::BloomFilterIndex& stripe : column.second) {
+          writeMessage(out, stripe);
+        }
+      }
+    }
+    stream.write(out.data(), out.size());
+  }
+
+  std::unique_ptr<DatasetIndexBuilder> createDatasetIndexBuilder() {
+    return std::make_unique<DatasetIndexBuilderImpl>();
+  }
+
+  class DatasetIndexImpl : public DatasetIndex {
+   public:
+    explicit DatasetIndexImpl(std::vector<IndexedFile> _files) : files(std::move(_files)) {}
+
+    uint64_t getNumberOfFiles() const override {
+      return files.size();
+    }
+
+    const std::string& getFileName(uint64_t fileIndex) const override {
+      return files.at(fileIndex).name;
+    }
+
+    std::string getSerializedFileTail(uint64_t fileIndex) const override;
+
+    std::vector<DatasetStripe> findStripes(const SearchArgument& sarg) const override;
+
+   private:
+    std::vector<IndexedFile> files;
+  };
+
+  std::string DatasetIndexImpl::getSerializedFileTail(uint64_t fileIndex) const {
+    std::string result;
+    if (!files.at(fileIndex).tail.SerializeToString(&result)) {
+      throw ParseError("Failed to serialize file tail");
+    }
+    return result;
+  }
+
+  std::vector<DatasetStripe> DatasetIndexImpl::findStripes(const SearchArgument& sarg) const {
+    std::vector<DatasetStripe> result;
+    for (uint64_t fileIndex = 0; fileIndex != files.size(); ++fileIndex) {
+      const IndexedFile& file = files[fileIndex];
+      const proto::Footer& footer = file.tail.footer();
+      const proto::PostScript& postscript = file.tail.postscript();
+      WriterVersion writerVersion = postscript.has_writer_version()
+                                        ? static_cast<WriterVersion>(postscript.writer_version())
+                                        : WriterVersion_ORIGINAL;
+      SargsApplier sargsApplier(*file.schema, &sarg, footer.row_index_stride(), writerVersion,
+                                nullptr);
+      if (!sargsApplier.evaluateFileStatistics(footer, 0)) {
+        continue;
+      }
+
+      for (int stripe = 0; stripe != footer.stripes_size(); ++stripe) {
+        if (stripe < file.metadata.stripe_stats_size()) {
+          const proto::StripeStatistics& stripeStats = file.metadata.stripe_stats(stripe);
+          const auto& rowGroups = file.rowGroupBloomFilters[static_cast<size_t>(stripe)];
+          // the stripe is needed if any of its row groups passes the bloom filters
+          bool isStripeNeeded = rowGroups.empty()
+                                    ? sargsApplier.evaluateStripeSummary(stripeStats, {})
+                                    : false;
+          for (size_t rowGroup = 0; rowGroup != rowGroups.size() && !isStripeNeeded; ++rowGroup) {
+            isStripeNeeded = sargsApplier.evaluateStripeSummary(stripeStats, rowGroups[rowGroup]);
+          }
+          if (!isStripeNeeded) {
+            continue;
+          }
+        }
+        const proto::StripeInformation& info = footer.stripes(stripe);
+        result.push_back({fileIndex, static_cast<uint64_t>(stripe), info.offset(),
+                          info.index_length() + info.data_length() + info.footer_length(),
+                          info.number_of_rows()});
+      }
+    }
+    return result;
+  }
+
+  std::unique_ptr<DatasetIndex> readDatasetIndex(std::unique_ptr<InputStream> stream) {
+    std::string data(stream->getLength(), '\0');
+    stream->read(&data[0], data.size(), 0);
+
+    DatasetIndexParser parser(data, stream->getName());
+    parser.readMagic();
+    uint64_t version = parser.readVarint();
+    if (version != DATASET_INDEX_VERSION) {
+      throw ParseError("Unknown dataset index version " + std::to_string(version) + " in " +
+                       stream->getName());
+    }
+
+    uint64_t numberOfFiles = parser.readCount();
+    std::vector<IndexedFile> files;
+    files.reserve(numberOfFiles);
+    for (uint64_t fileIndex = 0; fileIndex != numberOfFiles; ++fileIndex) {
+      files.emplace_back();
+      IndexedFile& file = files.back();
+      file.name = parser.readBytes();
+      parser.readMessage(file.tail);
+      parser.readMessage(file.metadata);
+      const proto::Footer& footer = file.tail.footer();
+      if (footer.types_size() == 0) {
+        throw ParseError("Footer of " + file.name + " is corrupt: no types found");
+      }
+      file.schema = convertType(footer.types(0), footer);
+
+      auto numberOfStripes = static_cast<size_t>(footer.stripes_size());
+      file.rowGroupBloomFilters.resize(numberOfStripes);
+      uint64_t numberOfColumns = parser.readCount();
+      for (uint64_t i = 0; i != numberOfColumns; ++i) {
+        auto columnId = static_cast<uint32_t>(parser.readVarint());
+        std::vector<proto::BloomFilterIndex>& stripes = file.bloomFilters[columnId];
+        stripes.resize(numberOfStripes);
+        for (size_t stripe = 0; stripe != numberOfStripes; ++stripe) {
+          const proto::BloomFilterIndex& pbIndex = stripes[stripe];
+          parser.readMessage(stripes[stripe]);
+          auto& rowGroups = file.rowGroupBloomFilters[stripe];
+          rowGroups.resize(std::max(rowGroups.size(),
+                                    static_cast<size_t>(pbIndex.bloom_filter_size())));
+          for (int rowGroup = 0; rowGroup != pbIndex.bloom_filter_size(); ++rowGroup) {
+            const proto::BloomFilter& pbFilter = pbIndex.bloom_filter(rowGroup);
+            if (pbFilter.has_num_hash_functions() && pbFilter.has_utf8bitset()) {
+              file.bloomFilterPool.push_back(std::make_unique<BloomFilterImpl>(pbFilter));
+              rowGroups[static_cast<size_t>(rowGroup)][columnId] =
+                  file.bloomFilterPool.back().get();
+            }
+          }
+        }
+      }
+    }
+    return std::make_unique<DatasetIndexImpl>(std::move(files));
+  }
+
+}  // namespace orc
@@ -68,6 +68,24 @@ namespace orc {
     // PASS
   }
 
+  MemoryLimitExceeded::MemoryLimitExceeded(const std::string& what_arg)
+      : runtime_error(what_arg) {
+    // PASS
+  }
+
+  MemoryLimitExceeded::MemoryLimitExceeded(const char* what_arg) : runtime_error(what_arg) {
+    // PASS
+  }
+
+  MemoryLimitExceeded::MemoryLimitExceeded(const MemoryLimitExceeded& error)
+      : runtime_error(error) {
+    // PASS
+  }
+
+  MemoryLimitExceeded::~MemoryLimitExceeded() noexcept {
+    // PASS
+  }
+
   SchemaEvolutionError::SchemaEvolutionError(const std::string& what_arg) : logic_error(what_arg) {
     // PASS
   }
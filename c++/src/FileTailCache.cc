@@ -0,0 +1,158 @@
+/**
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "FileTailCache.hh"
+#include "orc/Exceptions.hh"
+
+namespace orc {
+
+  FileTailCache::~FileTailCache() {
+    // PASS
+  }
+
+  FileTailCacheImpl::FileTailCacheImpl(uint64_t _memoryLimit)
+      : memoryLimit(_memoryLimit), memoryUsage(0), hits(0), misses(0), evictions(0) {
+    if (memoryLimit == 0) {
+      throw InvalidArgument("The memory limit of a file tail cache must be positive");
+    }
+  }
+
+  FileTailCacheImpl::~FileTailCacheImpl() {
+    // PASS
+  }
+
+  uint64_t FileTailCacheImpl::getMemoryUsage() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return memoryUsage;
+  }
+
+  uint64_t FileTailCacheImpl::getNumberOfEntries() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return nodes.size();
+  }
+
+  uint64_t FileTailCacheImpl::getNumberOfHits() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return hits;
+  }
+
+  uint64_t FileTailCacheImpl::getNumberOfMisses() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return misses;
+  }
+
+  uint64_t FileTailCacheImpl::getNumberOfEvictions() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return evictions;
+  }
+
+  void FileTailCacheImpl::clear() {
+    std::lock_guard<std::mutex> lock(mutex);
+    nodes.clear();
+    index.clear();
+    memoryUsage = 0;
+  }
+
+  std::string FileTailCacheImpl::buildKey(const std::string& name, uint64_t length,
+                                          const std::string& version) {
+    // prefixing the version with its size keeps versions and names from
+    // running into each other
+    std::string key = std::to_string(length);
+    key += '\0';
+    key += std::to_string(version.size());
+    key += '\0';
+    key += version;
+    key += name;
+    return key;
+  }
+
+  uint64_t FileTailCacheImpl::getSize(const std::string& key, const Entry& entry) {
+    uint64_t size = key.size() + entry.postscript->ByteSizeLong() + entry.footer->ByteSizeLong();
+    if (entry.metadata) {
+      size += entry.metadata->ByteSizeLong();
+    }
+    return size;
+  }
+
+  bool FileTailCacheImpl::get(const std::string& key, Entry& entry) {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto found = index.find(key);
+    if (found == index.end()) {
+      misses += 1;
+      return false;
+    }
+    hits += 1;
+    nodes.splice(nodes.begin(), nodes, found->second);
+    entry = found->second->entry;
+    return true;
+  }
+
+  void FileTailCacheImpl::put(const std::string& key, const Entry& entry) {
+    uint64_t size = getSize(key, entry);
+    std::lock_guard<std::mutex> lock(mutex);
+    auto found = index.find(key);
+    if (found != index.end()) {
+      memoryUsage -= found->second->size;
+      nodes.erase(found->second);
+      index.erase(found);
+    }
+    if (size > memoryLimit) {
+      return;
+    }
+    nodes.push_front({key, entry, size});
+    index[key] = nodes.begin();
+    memoryUsage += size;
+    evict();
+  }
+
+  void FileTailCacheImpl::putMetadata(const std::string& key,
+                                      std::shared_ptr<proto::Metadata> metadata) {
+    uint64_t size = metadata->ByteSizeLong();
+    std::lock_guard<std::mutex> lock(mutex);
+    auto found = index.find(key);
+    if (found == index.end() || found->second->entry.metadata) {
+      return;
+    }
+    Node& node = *found->second;
+    if (node.size + size > memoryLimit) {
+      // keep the footer cached without the stripe statistics
+      return;
+    }
+    node.entry.metadata = std::move(metadata);
+    node.size += size;
+    memoryUsage += size;
+    // keep the tail the reader is using while evicting the others
+    nodes.splice(nodes.begin(), nodes, found->second);
+    evict();
+  }
+
+  void FileTailCacheImpl::evict() {
+    while (memoryUsage > memoryLimit) {
+      Node& last = nodes.back();
+      memoryUsage -= last.size;
+      index.erase(last.key);
+      nodes.pop_back();
+      evictions += 1;
+    }
+  }
+
+  std::shared_ptr<FileTailCache> createFileTailCache(uint64_t memoryLimit) {
+    return std::make_shared<FileTailCacheImpl>(memoryLimit);
+  }
+
+}  // namespace orc
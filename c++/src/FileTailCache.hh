@@ -0,0 +1,109 @@
+/**
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ORC_FILETAILCACHE_HH
+#define ORC_FILETAILCACHE_HH
+
+#include "orc/Reader.hh"
+
+#include "wrap/orc-proto-wrapper.hh"
+
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace orc {
+
+  class FileTailCacheImpl : public FileTailCache {
+   public:
+    // the parsed tail of a file, shared by the readers of the file
+    struct Entry {
+      std::shared_ptr<proto::PostScript> postscript;
+      std::shared_ptr<proto::Footer> footer;
+      // nullptr until a reader of the file reads the stripe statistics
+      std::shared_ptr<proto::Metadata> metadata;
+      uint64_t postscriptLength;
+    };
+
+    explicit FileTailCacheImpl(uint64_t memoryLimit);
+    ~FileTailCacheImpl() override;
+
+    uint64_t getMemoryLimit() const override {
+      return memoryLimit;
+    }
+
+    uint64_t getMemoryUsage() const override;
+    uint64_t getNumberOfEntries() const override;
+    uint64_t getNumberOfHits() const override;
+    uint64_t getNumberOfMisses() const override;
+    uint64_t getNumberOfEvictions() const override;
+    void clear() override;
+
+    /**
+     * Build the key of a file.
+     * @param name the name of the file
+     * @param length the length of the file
+     * @param version the version of the file, may be empty
+     */
+    static std::string buildKey(const std::string& name, uint64_t length,
+                                const std::string& version);
+
+    /**
+     * Look the tail of a file up and make it the most recently used one.
+     * @return true if the tail was found and copied to entry
+     */
+    bool get(const std::string& key, Entry& entry);
+
+    /**
+     * Add or replace the tail of a file and evict the least recently used
+     * tails beyond the memory limit.
+     */
+    void put(const std::string& key, const Entry& entry);
+
+    /**
+     * Add the stripe statistics to the tail of a file if it is still cached.
+     */
+    void putMetadata(const std::string& key, std::shared_ptr<proto::Metadata> metadata);
+
+   private:
+    struct Node {
+      std::string key;
+      Entry entry;
+      uint64_t size;
+    };
+
+    static uint64_t getSize(const std::string& key, const Entry& entry);
+
+    // evict the least recently used tails beyond the limit; requires the lock
+    void evict();
+
+    const uint64_t memoryLimit;
+    mutable std::mutex mutex;
+    // the most recently used tail first
+    std::list<Node> nodes;
+    std::unordered_map<std::string, std::list<Node>::iterator> index;
+    uint64_t memoryUsage;
+    uint64_t hits;
+    uint64_t misses;
+    uint64_t evictions;
+  };
+
+}  // namespace orc
+
+#endif
@@ -0,0 +1,136 @@
+/**
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "MemoryManager.hh"
+#include "orc/Exceptions.hh"
+
+#include <algorithm>
+#include <vector>
+
+namespace orc {
+
+  MemoryManager::~MemoryManager() {
+    // PASS
+  }
+
+  MemoryManagerImpl::MemoryManagerImpl(uint64_t _memoryBudget)
+      : memoryBudget(_memoryBudget), totalStripeSize(0), totalEstimatedSize(0) {
+    if (memoryBudget == 0) {
+      throw InvalidArgument("The memory budget of a memory manager must be positive");
+    }
+  }
+
+  MemoryManagerImpl::~MemoryManagerImpl() {
+    // PASS
+  }
+
+  uint64_t MemoryManagerImpl::getNumberOfWriters() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return writers.size();
+  }
+
+  uint64_t MemoryManagerImpl::getTotalEstimatedSize() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return totalEstimatedSize;
+  }
+
+  MemoryManagerImpl::WriterState* MemoryManagerImpl::addWriter(uint64_t stripeSize) {
+    std::lock_guard<std::mutex> lock(mutex);
+    writers.emplace_back();
+    WriterState& writer = writers.back();
+    writer.stripeSize = stripeSize;
+    writer.estimatedSize = 0;
+    writer.rowsSinceCheck = 0;
+    writer.flushRequested = false;
+    totalStripeSize += stripeSize;
+    updateScaledStripeSizes();
+    return &writer;
+  }
+
+  void MemoryManagerImpl::removeWriter(WriterState* writer) {
+    std::lock_guard<std::mutex> lock(mutex);
+    totalStripeSize -= writer->stripeSize;
+    totalEstimatedSize -= writer->estimatedSize;
+    writers.remove_if([writer](const WriterState& state) { return &state == writer; });
+    updateScaledStripeSizes();
+  }
+
+  void MemoryManagerImpl::updateScaledStripeSizes() {
+    for (WriterState& writer : writers) {
+      if (totalStripeSize <= memoryBudget) {
+        writer.scaledStripeSize = writer.stripeSize;
+      } else {
+        writer.scaledStripeSize = std::max<uint64_t>(
+            1, static_cast<uint64_t>(static_cast<double>(writer.stripeSize) *
+                                     static_cast<double>(memoryBudget) /
+                                     static_cast<double>(totalStripeSize)));
+      }
+    }
+  }
+
+  bool MemoryManagerImpl::addedRows(WriterState* writer, uint64_t rows, uint64_t estimatedSize) {
+    writer->rowsSinceCheck += rows;
+    if (writer->rowsSinceCheck >= ROWS_BETWEEN_CHECKS) {
+      updateWriter(writer, estimatedSize);
+    }
+    return writer->flushRequested;
+  }
+
+  void MemoryManagerImpl::updateWriter(WriterState* writer, uint64_t estimatedSize) {
+    writer->rowsSinceCheck = 0;
+    std::lock_guard<std::mutex> lock(mutex);
+    totalEstimatedSize = totalEstimatedSize - writer->estimatedSize + estimatedSize;
+    writer->estimatedSize = estimatedSize;
+    if (estimatedSize == 0) {
+      writer->flushRequested = false;
+      return;
+    }
+
+    if (totalEstimatedSize > memoryBudget) {
+      // ask the writers with the largest stripes to flush until the rest fit
+      std::vector<WriterState*> candidates;
+      for (WriterState& state : writers) {
+        if (state.estimatedSize > 0 && !state.flushRequested) {
+          candidates.push_back(&state);
+        }
+      }
+      std::sort(candidates.begin(), candidates.end(),
+                [](const WriterState* a, const WriterState* b) {
+                  return a->estimatedSize > b->estimatedSize;
+                });
+      uint64_t remaining = totalEstimatedSize;
+      for (WriterState& state : writers) {
+        if (state.flushRequested) {
+          remaining -= state.estimatedSize;
+        }
+      }
+      for (WriterState* candidate : candidates) {
+        if (remaining <= memoryBudget) {
+          break;
+        }
+        candidate->flushRequested = true;
+        remaining -= candidate->estimatedSize;
+      }
+    }
+  }
+
+  std::shared_ptr<MemoryManager> createMemoryManager(uint64_t memoryBudget) {
+    return std::make_shared<MemoryManagerImpl>(memoryBudget);
+  }
+
+}  // namespace orc
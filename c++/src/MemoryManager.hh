@@ -0,0 +1,93 @@
+/**
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ORC_MEMORYMANAGER_HH
+#define ORC_MEMORYMANAGER_HH
+
+#include "orc/Writer.hh"
+
+#include <atomic>
+#include <list>
+#include <mutex>
+
+namespace orc {
+
+  class MemoryManagerImpl : public MemoryManager {
+   public:
+    // the number of rows a writer adds between two checks of the budget,
+    // as in the Java implementation
+    static const uint64_t ROWS_BETWEEN_CHECKS = 5000;
+
+    // the state of a registered writer
+    struct WriterState {
+      uint64_t stripeSize;
+      uint64_t estimatedSize;
+      // the rows the writer added since it last updated its estimated size
+      uint64_t rowsSinceCheck;
+      // the stripe size scaled to the budget, updated as writers come and go
+      std::atomic<uint64_t> scaledStripeSize;
+      // set by the manager when the writer should write its stripe early
+      std::atomic<bool> flushRequested;
+    };
+
+    explicit MemoryManagerImpl(uint64_t memoryBudget);
+    ~MemoryManagerImpl() override;
+
+    uint64_t getMemoryBudget() const override {
+      return memoryBudget;
+    }
+
+    uint64_t getNumberOfWriters() const override;
+    uint64_t getTotalEstimatedSize() const override;
+
+    /**
+     * Register a writer.
+     * @param stripeSize the stripe size the writer was configured with
+     * @return the state of the writer, valid until removeWriter()
+     */
+    WriterState* addWriter(uint64_t stripeSize);
+
+    void removeWriter(WriterState* writer);
+
+    /**
+     * Record rows added by a writer. Every ROWS_BETWEEN_CHECKS rows, this
+     * updates the estimated size of its stripe.
+     * @return true if the manager requested the writer to write its stripe
+     */
+    bool addedRows(WriterState* writer, uint64_t rows, uint64_t estimatedSize);
+
+    /**
+     * Update the estimated size of the stripe a writer buffers, and request
+     * the largest writers to flush if all buffered stripes exceed the budget.
+     */
+    void updateWriter(WriterState* writer, uint64_t estimatedSize);
+
+   private:
+    // scale the stripe sizes of all writers to the budget; requires the lock
+    void updateScaledStripeSizes();
+
+    const uint64_t memoryBudget;
+    mutable std::mutex mutex;
+    std::list<WriterState> writers;
+    uint64_t totalStripeSize;
+    uint64_t totalEstimatedSize;
+  };
+
+}  // namespace orc
+
+#endif
@@ -22,8 +22,10 @@
 #include "Adaptor.hh"
 
 #include <string.h>
+#include <algorithm>
 #include <cstdlib>
 #include <iostream>
+#include <type_traits>
 
 namespace orc {
 
@@ -108,6 +110,39 @@ namespace orc {
     }
   }
 
+  template <class T>
+  void DataBuffer<T>::reserveWithGrowth(uint64_t newCapacity) {
+    if (newCapacity > currentCapacity || !buf) {
+      reserve(std::max(newCapacity, currentCapacity + currentCapacity / 2));
+    }
+  }
+
+  template <class T>
+  void DataBuffer<T>::resizeUninitialized(uint64_t newSize) {
+    reserveWithGrowth(newSize);
+    if constexpr (std::is_trivially_copyable<T>::value) {
+      currentSize = newSize;
+    } else {
+      resize(newSize);
+    }
+  }
+
+  template <class T>
+  void DataBuffer<T>::shrinkToFit() {
+    if (!buf || currentCapacity == currentSize) {
+      return;
+    }
+    T* buf_old = buf;
+    if (currentSize == 0) {
+      buf = nullptr;
+    } else {
+      buf = reinterpret_cast<T*>(memoryPool.malloc(sizeof(T) * currentSize));
+      memcpy(buf, buf_old, sizeof(T) * currentSize);
+    }
+    memoryPool.free(reinterpret_cast<char*>(buf_old));
+    currentCapacity = currentSize;
+  }
+
   // Specializations for char
 
   template <>
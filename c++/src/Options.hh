@@ -43,6 +43,8 @@ namespace orc {
     MemoryPool* memoryPool;
     std::string serializedTail;
     ReaderMetrics* metrics;
+    std::shared_ptr<FileTailCache> tailCache;
+    std::string tailCacheVersion;
 
     ReaderOptionsPrivate() {
       tailLocation = std::numeric_limits<uint64_t>::max();
@@ -104,6 +106,24 @@ namespace orc {
     return privateBits->tailLocation;
   }
 
+  ReaderOptions& ReaderOptions::setFileTailCache(std::shared_ptr<FileTailCache> cache) {
+    privateBits->tailCache = std::move(cache);
+    return *this;
+  }
+
+  std::shared_ptr<FileTailCache> ReaderOptions::getFileTailCache() const {
+    return privateBits->tailCache;
+  }
+
+  ReaderOptions& ReaderOptions::setFileTailCacheVersion(const std::string& version) {
+    privateBits->tailCacheVersion = version;
+    return *this;
+  }
+
+  std::string ReaderOptions::getFileTailCacheVersion() const {
+    return privateBits->tailCacheVersion;
+  }
+
   ReaderOptions& ReaderOptions::setSerializedFileTail(const std::string& value) {
     privateBits->serializedTail = value;
     return *this;
@@ -139,6 +159,8 @@ namespace orc {
     std::string readerTimezone;
     RowReaderOptions::IdReadIntentMap idReadIntentMap;
     bool useTightNumericVector;
+    bool useOffsetStringVector;
+    bool useNotNullBitmap;
     std::shared_ptr<Type> readType;
     bool throwOnSchemaEvolutionOverflow;
 
@@ -151,6 +173,8 @@ namespace orc {
       enableLazyDecoding = false;
       readerTimezone = "GMT";
       useTightNumericVector = false;
+      useOffsetStringVector = false;
+      useNotNullBitmap = false;
       throwOnSchemaEvolutionOverflow = false;
     }
   };
@@ -318,6 +342,24 @@ namespace orc {
     return privateBits->useTightNumericVector;
   }
 
+  RowReaderOptions& RowReaderOptions::setUseOffsetStringVector(bool useOffsetStringVector) {
+    privateBits->useOffsetStringVector = useOffsetStringVector;
+    return *this;
+  }
+
+  bool RowReaderOptions::getUseOffsetStringVector() const {
+    return privateBits->useOffsetStringVector;
+  }
+
+  RowReaderOptions& RowReaderOptions::setUseNotNullBitmap(bool useNotNullBitmap) {
+    privateBits->useNotNullBitmap = useNotNullBitmap;
+    return *this;
+  }
+
+  bool RowReaderOptions::getUseNotNullBitmap() const {
+    return privateBits->useNotNullBitmap;
+  }
+
   RowReaderOptions& RowReaderOptions::setReadType(std::shared_ptr<Type> type) {
     privateBits->readType = std::move(type);
     return *this;
@@ -23,6 +23,7 @@
 #include "Statistics.hh"
 #include "StripeStream.hh"
 #include "Utils.hh"
+#include "ZoneMap.hh"
 
 #include "wrap/coded-stream-wrapper.h"
 
@@ -30,6 +31,7 @@
 #include <iostream>
 #include <iterator>
 #include <memory>
+#include <mutex>
 #include <set>
 #include <sstream>
 #include <string>
@@ -255,6 +257,7 @@ namespace orc {
         footer(contents->footer.get()),
         firstRowOfStripe(*contents->pool, 0),
         enableEncodedBlock(opts.getEnableLazyDecoding()),
+        trackingPool(dynamic_cast<const TrackingMemoryPool*>(contents->pool)),
         readerTimezone(getTimezoneByName(opts.getTimezoneName())),
         schemaEvolution(opts.getReadType(), contents->schema.get()) {
     uint64_t numberOfStripes;
@@ -264,7 +267,13 @@ namespace orc {
     currentRowInStripe = 0;
     rowsInCurrentStripe = 0;
     numRowGroupsInStripeRange = 0;
+    stripeIndexLoaded = false;
+    unreadRowIndexBytes = 0;
+    unreadBloomFilterBytes = 0;
+    zoneMapGranularity = 0;
     useTightNumericVector = opts.getUseTightNumericVector();
+    useOffsetStringVector = opts.getUseOffsetStringVector();
+    useNotNullBitmap = opts.getUseNotNullBitmap();
     throwOnSchemaEvolutionOverflow = opts.getThrowOnSchemaEvolutionOverflow();
     uint64_t rowTotal = 0;
 
@@ -314,17 +323,25 @@ namespace orc {
     skipBloomFilters = hasBadBloomFilters();
   }
 
+  RowReaderImpl::~RowReaderImpl() {
+    reportSkippedIndexBytes();
+  }
+
   // Check if the file has inconsistent bloom filters.
   bool RowReaderImpl::hasBadBloomFilters() {
+    return orc::hasBadBloomFilters(*footer);
+  }
+
+  bool hasBadBloomFilters(const proto::Footer& footer) {
     // Only C++ writer in old releases could have bad bloom filters.
-    if (footer->writer() != ORC_CPP_WRITER) return false;
+    if (footer.writer() != ORC_CPP_WRITER) return false;
     // 'softwareVersion' is added in 1.5.13, 1.6.11, and 1.7.0.
     // 1.6.x releases before 1.6.11 won't have it. On the other side, the C++ writer
     // supports writing bloom filters since 1.6.0. So files written by the C++ writer
     // and with 'softwareVersion' unset would have bad bloom filters.
-    if (!footer->has_software_version()) return true;
+    if (!footer.has_software_version()) return true;
 
-    const std::string& fullVersion = footer->software_version();
+    const std::string& fullVersion = footer.software_version();
     std::string version;
     // Deal with snapshot versions, e.g. 1.6.12-SNAPSHOT.
     if (fullVersion.find('-') != std::string::npos) {
@@ -405,7 +422,9 @@ namespace orc {
       currentStripe = seekToStripe;
       currentRowInStripe = rowNumber - firstRowOfStripe[currentStripe];
       startNextStripe();
-      if (currentStripe >= lastStripe) {
+      if (currentStripe >= lastStripe || sargsApplier) {
+        // with a search argument, startNextStripe() has already positioned
+        // the column readers at the first selected row
         return;
       }
     } else {
@@ -414,16 +433,14 @@ namespace orc {
         // advance to selected row group if predicate pushdown is enabled
         currentRowInStripe =
             advanceToNextRowGroup(currentRowInStripe, rowsInCurrentStripe,
-                                  footer->row_index_stride(), sargsApplier->getNextSkippedRows());
+                                  sargsApplier->getSkipStride(),
+                                  sargsApplier->getNextSkippedRows());
       }
     }
 
     uint64_t rowsToSkip = currentRowInStripe;
     // seek to the target row group if row indexes exists
     if (rowIndexStride > 0 && currentStripeInfo.index_length() > 0) {
-      if (rowIndexes.empty()) {
-        loadStripeIndex();
-      }
       // TODO(ORC-1175): process the failures of loadStripeIndex() call
       seekToRowGroup(static_cast<uint32_t>(rowsToSkip / rowIndexStride));
       // skip leading rows in the target row group
@@ -440,6 +457,8 @@ namespace orc {
     // reset all previous row indexes
     rowIndexes.clear();
     bloomFilterIndex.clear();
+    stripeIndexLoaded = true;
+    unreadRowIndexBytes = 0;
 
     // obtain row indexes for selected columns
     uint64_t offset = currentStripeInfo.offset();
@@ -447,21 +466,99 @@ namespace orc {
       const proto::Stream& pbStream = currentStripeFooter.streams(i);
       uint64_t colId = pbStream.column();
       if (selectedColumns[colId] && pbStream.has_kind() &&
-          (pbStream.kind() == proto::Stream_Kind_ROW_INDEX ||
-           pbStream.kind() == proto::Stream_Kind_BLOOM_FILTER_UTF8)) {
+          pbStream.kind() == proto::Stream_Kind_ROW_INDEX) {
         std::unique_ptr<SeekableInputStream> inStream = createDecompressor(
             getCompression(),
             std::unique_ptr<SeekableInputStream>(new SeekableFileInputStream(
                 contents->stream.get(), offset, pbStream.length(), *contents->pool)),
             getCompressionSize(), *contents->pool, contents->readerMetrics);
 
-        if (pbStream.kind() == proto::Stream_Kind_ROW_INDEX) {
-          proto::RowIndex rowIndex;
-          if (!rowIndex.ParseFromZeroCopyStream(inStream.get())) {
-            throw ParseError("Failed to parse the row index");
-          }
-          rowIndexes[colId] = rowIndex;
-        } else if (!skipBloomFilters) {  // Stream_Kind_BLOOM_FILTER_UTF8
+        proto::RowIndex rowIndex;
+        if (!rowIndex.ParseFromZeroCopyStream(inStream.get())) {
+          throw ParseError("Failed to parse the row index");
+        }
+        rowIndexes[colId] = rowIndex;
+      }
+      offset += pbStream.length();
+    }
+  }
+
+  void RowReaderImpl::loadZoneMaps() {
+    zoneMaps.clear();
+    zoneMapGranularity = 0;
+
+    // the section fills the gap between the stripe footer and the next stripe
+    uint64_t sectionStart = currentStripeInfo.offset() + currentStripeInfo.index_length() +
+                            currentStripeInfo.data_length() + currentStripeInfo.footer_length();
+    uint64_t sectionEnd =
+        currentStripe + 1 < static_cast<uint64_t>(footer->stripes_size())
+            ? footer->stripes(static_cast<int>(currentStripe + 1)).offset()
+            : footer->header_length() + footer->content_length();
+    if (sectionEnd < sectionStart + ZONE_MAP_HEADER_LENGTH ||
+        sectionEnd > contents->stream->getLength()) {
+      return;
+    }
+    char header[ZONE_MAP_HEADER_LENGTH];
+    contents->stream->read(header, ZONE_MAP_HEADER_LENGTH, sectionStart);
+    uint64_t directoryLength = getZoneMapDirectoryLength(header);
+    if (directoryLength == 0) {
+      return;
+    }
+    uint64_t dataStart = sectionStart + ZONE_MAP_HEADER_LENGTH + directoryLength;
+    if (dataStart > sectionEnd) {
+      throw ParseError("Malformed zone map section");
+    }
+    std::string buffer(directoryLength, '\0');
+    contents->stream->read(&buffer[0], directoryLength, sectionStart + ZONE_MAP_HEADER_LENGTH);
+    ZoneMapDirectory directory = parseZoneMapDirectory(buffer);
+
+    for (const auto& column : directory.columns) {
+      uint64_t colId = column.first;
+      if (colId >= selectedColumns.size() || !selectedColumns[colId] ||
+          !sargsApplier->needsZoneMap(colId)) {
+        continue;
+      }
+      uint64_t offset = dataStart + column.second.first;
+      uint64_t length = column.second.second;
+      if (offset + length > sectionEnd) {
+        throw ParseError("Malformed zone map section");
+      }
+      std::unique_ptr<SeekableInputStream> inStream = createDecompressor(
+          getCompression(),
+          std::unique_ptr<SeekableInputStream>(new SeekableFileInputStream(
+              contents->stream.get(), offset, length, *contents->pool)),
+          getCompressionSize(), *contents->pool, contents->readerMetrics);
+      if (!zoneMaps[colId].ParseFromZeroCopyStream(inStream.get())) {
+        throw ParseError("Failed to parse the zone map");
+      }
+    }
+    if (!zoneMaps.empty()) {
+      zoneMapGranularity = directory.granularity;
+    }
+  }
+
+  void RowReaderImpl::loadBloomFilters(bool needed) {
+    bloomFilterIndex.clear();
+    if (skipBloomFilters) {
+      return;
+    }
+
+    uint64_t skippedBytes = 0;
+    uint64_t offset = currentStripeInfo.offset();
+    for (int i = 0; i < currentStripeFooter.streams_size(); ++i) {
+      const proto::Stream& pbStream = currentStripeFooter.streams(i);
+      uint64_t colId = pbStream.column();
+      if (selectedColumns[colId] && pbStream.has_kind() &&
+          pbStream.kind() == proto::Stream_Kind_BLOOM_FILTER_UTF8) {
+        if (!needed || !sargsApplier || !sargsApplier->needsBloomFilter(colId)) {
+          skippedBytes += pbStream.length();
+        } else {
+          std::unique_ptr<SeekableInputStream> inStream = createDecompressor(
+              getCompression(),
+              std::unique_ptr<SeekableInputStream>(new SeekableFileInputStream(
+                  contents->stream.get(), offset, pbStream.length(), *contents->pool)),
+              getCompressionSize(), *contents->pool, contents->readerMetrics);
+
           proto::BloomFilterIndex pbBFIndex;
           if (!pbBFIndex.ParseFromZeroCopyStream(inStream.get())) {
             throw ParseError("Failed to parse bloom filter index");
@@ -469,18 +566,70 @@ namespace orc {
           BloomFilterIndex bfIndex;
           for (int j = 0; j < pbBFIndex.bloom_filter_size(); j++) {
             bfIndex.entries.push_back(BloomFilterUTF8Utils::deserialize(
-                pbStream.kind(), currentStripeFooter.columns(static_cast<int>(pbStream.column())),
+                pbStream.kind(), currentStripeFooter.columns(static_cast<int>(colId)),
                 pbBFIndex.bloom_filter(j)));
           }
           // add bloom filters to result for one column
-          bloomFilterIndex[pbStream.column()] = bfIndex;
+          bloomFilterIndex[static_cast<uint32_t>(colId)] = bfIndex;
         }
       }
       offset += pbStream.length();
     }
+    unreadBloomFilterBytes = skippedBytes;
+  }
+
+  void RowReaderImpl::skipStripeIndex() {
+    rowIndexes.clear();
+    bloomFilterIndex.clear();
+    zoneMaps.clear();
+    stripeIndexLoaded = false;
+
+    unreadRowIndexBytes = 0;
+    unreadBloomFilterBytes = 0;
+    for (int i = 0; i < currentStripeFooter.streams_size(); ++i) {
+      const proto::Stream& pbStream = currentStripeFooter.streams(i);
+      if (!selectedColumns[pbStream.column()] || !pbStream.has_kind()) {
+        continue;
+      }
+      if (pbStream.kind() == proto::Stream_Kind_ROW_INDEX) {
+        unreadRowIndexBytes += pbStream.length();
+      } else if (!skipBloomFilters && pbStream.kind() == proto::Stream_Kind_BLOOM_FILTER_UTF8) {
+        unreadBloomFilterBytes += pbStream.length();
+      }
+    }
+  }
+
+  void RowReaderImpl::reportSkippedIndexBytes() {
+    if (contents->readerMetrics != nullptr) {
+      contents->readerMetrics->SkippedIndexBytes.fetch_add(unreadRowIndexBytes +
+                                                           unreadBloomFilterBytes);
+    }
+    unreadRowIndexBytes = 0;
+    unreadBloomFilterBytes = 0;
+  }
+
+  void RowReaderImpl::seekToSelectedRow(uint64_t fromRowInStripe, uint64_t toRowInStripe) {
+    uint64_t rowIndexStride = footer->row_index_stride();
+    if (fromRowInStripe <= toRowInStripe &&
+        fromRowInStripe / rowIndexStride == toRowInStripe / rowIndexStride) {
+      // skipped pages of the current row group are cheaper to decode than to seek
+      if (toRowInStripe > fromRowInStripe) {
+        reader->skip(toRowInStripe - fromRowInStripe);
+      }
+      return;
+    }
+    seekToRowGroup(static_cast<uint32_t>(toRowInStripe / rowIndexStride));
+    if (toRowInStripe % rowIndexStride > 0) {
+      reader->skip(toRowInStripe % rowIndexStride);
+    }
   }
 
   void RowReaderImpl::seekToRowGroup(uint32_t rowGroupEntryId) {
+    // row indexes are not loaded for stripes that sargs fully select
+    if (!stripeIndexLoaded) {
+      loadStripeIndex();
+    }
+
     // store positions for selected columns
     std::list<std::list<uint64_t>> positions;
     // store position providers for selected colimns
@@ -549,7 +698,7 @@ namespace orc {
         fileLength(_fileLength),
         postscriptLength(_postscriptLength),
         footer(contents->footer.get()) {
-    isMetadataLoaded = false;
+    isMetadataLoaded = contents->metadata != nullptr;
     checkOrcVersion();
     numberOfStripes = static_cast<uint64_t>(footer->stripes_size());
     contents->schema = convertType(footer->types(0), *footer);
@@ -791,6 +940,13 @@ namespace orc {
     return std::unique_ptr<ColumnStatistics>(convertColumnStatistics(col, statContext));
   }
 
+  const proto::Metadata* ReaderImpl::getMetadata() const {
+    if (!isMetadataLoaded) {
+      readMetadata();
+    }
+    return contents->metadata.get();
+  }
+
   void ReaderImpl::readMetadata() const {
     uint64_t metadataSize = contents->postscript->metadata_length();
     uint64_t footerLength = contents->postscript->footer_length();
@@ -812,6 +968,9 @@ namespace orc {
       if (!contents->metadata->ParseFromZeroCopyStream(pbStream.get())) {
         throw ParseError("Failed to parse the metadata");
       }
+      if (contents->tailCache) {
+        contents->tailCache->putMetadata(contents->tailCacheKey, contents->metadata);
+      }
     }
     isMetadataLoaded = true;
   }
@@ -1011,6 +1170,7 @@ namespace orc {
 
   // Update fields to indicate we've reached the end of file
   void RowReaderImpl::markEndOfFile() {
+    reportSkippedIndexBytes();
     currentStripe = lastStripe;
     currentRowInStripe = 0;
     rowsInCurrentStripe = 0;
@@ -1027,6 +1187,8 @@ namespace orc {
     reader.reset();  // ColumnReaders use lots of memory; free old memory first
     rowIndexes.clear();
     bloomFilterIndex.clear();
+    zoneMaps.clear();
+    stripeIndexLoaded = false;
 
     // evaluate file statistics if it exists
     if (sargsApplier && !sargsApplier->evaluateFileStatistics(*footer, numRowGroupsInStripeRange)) {
@@ -1036,6 +1198,8 @@ namespace orc {
     }
 
     do {
+      // the index bytes of the stripe left behind can no longer be read
+      reportSkippedIndexBytes();
       currentStripeInfo = footer->stripes(static_cast<int>(currentStripe));
       uint64_t fileLength = contents->stream->getLength();
       if (currentStripeInfo.offset() + currentStripeInfo.index_length() +
@@ -1056,6 +1220,7 @@ namespace orc {
 
       if (sargsApplier) {
         bool isStripeNeeded = true;
+        bool isStripeFullyMatched = false;
         if (contents->metadata) {
           const auto& currentStripeStats =
               contents->metadata->stripe_stats(static_cast<int>(currentStripe));
@@ -1064,14 +1229,27 @@ namespace orc {
               (rowsInCurrentStripe + footer->row_index_stride() - 1) / footer->row_index_stride();
           isStripeNeeded =
               sargsApplier->evaluateStripeStatistics(currentStripeStats, stripeRowGroupCount);
+          isStripeFullyMatched = sargsApplier->isStripeFullyMatched();
         }
 
-        if (isStripeNeeded) {
-          // read row group statistics and bloom filters of current stripe
+        if (isStripeNeeded && isStripeFullyMatched) {
+          // no row group can be skipped, so leave the index unread until a seek needs it
+          skipStripeIndex();
+          sargsApplier->selectAllRowGroups(rowsInCurrentStripe);
+          if (sargsApplier->hasSelectedFrom(currentRowInStripe)) {
+            break;
+          }
+          isStripeNeeded = false;
+        } else if (isStripeNeeded) {
+          // read row group statistics of current stripe, then the bloom
+          // filters if min/max statistics leave row groups to check
           loadStripeIndex();
+          loadBloomFilters(sargsApplier->needsBloomFilters(rowsInCurrentStripe, rowIndexes));
+          loadZoneMaps();
 
           // select row groups to read in the current stripe
-          sargsApplier->pickRowGroups(rowsInCurrentStripe, rowIndexes, bloomFilterIndex);
+          sargsApplier->pickRowGroups(rowsInCurrentStripe, rowIndexes, bloomFilterIndex, zoneMaps,
+                                      zoneMapGranularity);
           if (sargsApplier->hasSelectedFrom(currentRowInStripe)) {
             // current stripe has at least one row group matching the predicate
             break;
@@ -1102,10 +1280,11 @@ namespace orc {
         // move to the 1st selected row group when PPD is enabled.
         currentRowInStripe =
             advanceToNextRowGroup(currentRowInStripe, rowsInCurrentStripe,
-                                  footer->row_index_stride(), sargsApplier->getNextSkippedRows());
+                                  sargsApplier->getSkipStride(),
+                                  sargsApplier->getNextSkippedRows());
         previousRow = firstRowOfStripe[currentStripe] + currentRowInStripe - 1;
         if (currentRowInStripe > 0) {
-          seekToRowGroup(static_cast<uint32_t>(currentRowInStripe / footer->row_index_stride()));
+          seekToSelectedRow(0, currentRowInStripe);
         }
       }
     } else {
@@ -1127,8 +1306,9 @@ namespace orc {
     uint64_t rowsToRead =
         std::min(static_cast<uint64_t>(data.capacity), rowsInCurrentStripe - currentRowInStripe);
     if (sargsApplier && rowsToRead > 0) {
-      rowsToRead = computeBatchSize(rowsToRead, currentRowInStripe, rowsInCurrentStripe,
-                                    footer->row_index_stride(), sargsApplier->getNextSkippedRows());
+      rowsToRead =
+          computeBatchSize(rowsToRead, currentRowInStripe, rowsInCurrentStripe,
+                           sargsApplier->getSkipStride(), sargsApplier->getNextSkippedRows());
     }
     data.numElements = rowsToRead;
     if (rowsToRead == 0) {
@@ -1140,6 +1320,9 @@ namespace orc {
     } else {
       reader->next(data, rowsToRead, nullptr);
     }
+    if (trackingPool != nullptr && contents->readerMetrics != nullptr) {
+      updateMaximum(contents->readerMetrics->PeakMemoryBytes, trackingPool->getPeakBytes());
+    }
     // update row number
     previousRow = firstRowOfStripe[currentStripe] + currentRowInStripe;
     currentRowInStripe += rowsToRead;
@@ -1147,14 +1330,14 @@ namespace orc {
     // check if we need to advance to next selected row group
     if (sargsApplier) {
       uint64_t nextRowToRead =
-          advanceToNextRowGroup(currentRowInStripe, rowsInCurrentStripe, footer->row_index_stride(),
-                                sargsApplier->getNextSkippedRows());
+          advanceToNextRowGroup(currentRowInStripe, rowsInCurrentStripe,
+                                sargsApplier->getSkipStride(), sargsApplier->getNextSkippedRows());
       if (currentRowInStripe != nextRowToRead) {
-        // it is guaranteed to be at start of a row group
-        currentRowInStripe = nextRowToRead;
-        if (currentRowInStripe < rowsInCurrentStripe) {
-          seekToRowGroup(static_cast<uint32_t>(currentRowInStripe / footer->row_index_stride()));
+        // it is guaranteed to be at start of a row group or a zone map page
+        if (nextRowToRead < rowsInCurrentStripe) {
+          seekToSelectedRow(currentRowInStripe, nextRowToRead);
         }
+        currentRowInStripe = nextRowToRead;
       }
     }
 
@@ -1234,8 +1417,15 @@ namespace orc {
     }
     const Type& readType =
         schemaEvolution.getReadType() ? *schemaEvolution.getReadType() : getSelectedType();
-    return readType.createRowBatch(capacity, *contents->pool, enableEncodedBlock,
-                                   useTightNumericVector);
+    // the conversions of schema evolution only produce StringVectorBatch
+    // and byte per value not null flags
+    std::unique_ptr<ColumnVectorBatch> result = readType.createRowBatch(
+        capacity, *contents->pool, enableEncodedBlock, useTightNumericVector,
+        useOffsetStringVector && !schemaEvolution.getReadType());
+    if (useNotNullBitmap && !schemaEvolution.getReadType()) {
+      result->enableNotNullBitmap();
+    }
+    return result;
   }
 
   void ensureOrcFooter(InputStream* stream, DataBuffer<char>* buffer, uint64_t postscriptLength) {
@@ -1355,6 +1545,41 @@ namespace orc {
     return footer;
   }
 
+  // read the postscript and the footer of a file into its contents and
+  // return the length of the postscript
+  uint64_t readFileTail(FileContents& contents, InputStream* stream, uint64_t fileLength) {
+    // read last bytes into buffer to get PostScript
+    uint64_t readSize = std::min(fileLength, DIRECTORY_SIZE_GUESS);
+    if (readSize < 4) {
+      throw ParseError("File size too small");
+    }
+    auto buffer = std::make_unique<DataBuffer<char>>(*contents.pool, readSize);
+    stream->read(buffer->data(), readSize, fileLength - readSize);
+
+    uint64_t postscriptLength = buffer->data()[readSize - 1] & 0xff;
+    contents.postscript = readPostscript(stream, buffer.get(), postscriptLength);
+    uint64_t footerSize = contents.postscript->footer_length();
+    uint64_t tailSize = 1 + postscriptLength + footerSize;
+    if (tailSize >= fileLength) {
+      std::stringstream msg;
+      msg << "Invalid ORC tailSize=" << tailSize << ", fileLength=" << fileLength;
+      throw ParseError(msg.str());
+    }
+    uint64_t footerOffset;
+
+    if (tailSize > readSize) {
+      buffer->resize(footerSize);
+      stream->read(buffer->data(), footerSize, fileLength - tailSize);
+      footerOffset = 0;
+    } else {
+      footerOffset = readSize - tailSize;
+    }
+
+    contents.footer = readFooter(stream, buffer.get(), footerOffset, *contents.postscript,
+                                 *contents.pool, contents.readerMetrics);
+    return postscriptLength;
+  }
+
   std::unique_ptr<Reader> createReader(std::unique_ptr<InputStream> stream,
                                        const ReaderOptions& options) {
     auto contents = std::make_shared<FileContents>();
@@ -1377,36 +1602,27 @@ namespace orc {
     } else {
       // figure out the size of the file using the option or filesystem
       fileLength = std::min(options.getTailLocation(), static_cast<uint64_t>(stream->getLength()));
-
-      // read last bytes into buffer to get PostScript
-      uint64_t readSize = std::min(fileLength, DIRECTORY_SIZE_GUESS);
-      if (readSize < 4) {
-        throw ParseError("File size too small");
+      contents->tailCache =
+          std::dynamic_pointer_cast<FileTailCacheImpl>(options.getFileTailCache());
+      FileTailCacheImpl::Entry cached;
+      if (contents->tailCache) {
+        contents->tailCacheKey = FileTailCacheImpl::buildKey(stream->getName(), fileLength,
+                                                             options.getFileTailCacheVersion());
       }
-      auto buffer = std::make_unique<DataBuffer<char>>(*contents->pool, readSize);
-      stream->read(buffer->data(), readSize, fileLength - readSize);
-
-      postscriptLength = buffer->data()[readSize - 1] & 0xff;
-      contents->postscript = readPostscript(stream.get(), buffer.get(), postscriptLength);
-      uint64_t footerSize = contents->postscript->footer_length();
-      uint64_t tailSize = 1 + postscriptLength + footerSize;
-      if (tailSize >= fileLength) {
-        std::stringstream msg;
-        msg << "Invalid ORC tailSize=" << tailSize << ", fileLength=" << fileLength;
-        throw ParseError(msg.str());
-      }
-      uint64_t footerOffset;
-
-      if (tailSize > readSize) {
-        buffer->resize(footerSize);
-        stream->read(buffer->data(), footerSize, fileLength - tailSize);
-        footerOffset = 0;
+      if (contents->tailCache && contents->tailCache->get(contents->tailCacheKey, cached)) {
+        contents->postscript = cached.postscript;
+        contents->footer = cached.footer;
+        contents->metadata = cached.metadata;
+        postscriptLength = cached.postscriptLength;
       } else {
-        footerOffset = readSize - tailSize;
+        postscriptLength = readFileTail(*contents, stream.get(), fileLength);
+        if (contents->tailCache) {
+          cached.postscript = contents->postscript;
+          cached.footer = contents->footer;
+          cached.postscriptLength = postscriptLength;
+          contents->tailCache->put(contents->tailCacheKey, cached);
+        }
       }
-
-      contents->footer = readFooter(stream.get(), buffer.get(), footerOffset, *contents->postscript,
-                                    *contents->pool, contents->readerMetrics);
     }
     contents->isDecimalAsLong = false;
     if (contents->postscript->version_size() == 2) {
@@ -1475,6 +1691,56 @@ namespace orc {
     // PASS
   }
 
+  RowBatchPool::~RowBatchPool() {
+    // PASS
+  }
+
+  class RowBatchPoolImpl : public RowBatchPool {
+   public:
+    RowBatchPoolImpl(const RowReader& _reader, uint64_t _batchSize, uint64_t _maxIdleBatches)
+        : reader(_reader), batchSize(_batchSize), maxIdleBatches(_maxIdleBatches) {}
+
+    std::unique_ptr<ColumnVectorBatch> acquire() override {
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!idleBatches.empty()) {
+          std::unique_ptr<ColumnVectorBatch> batch = std::move(idleBatches.back());
+          idleBatches.pop_back();
+          return batch;
+        }
+      }
+      return reader.createRowBatch(batchSize);
+    }
+
+    void release(std::unique_ptr<ColumnVectorBatch> batch) override {
+      if (batch == nullptr) {
+        return;
+      }
+      batch->clear();
+      std::lock_guard<std::mutex> lock(mutex);
+      if (idleBatches.size() < maxIdleBatches) {
+        idleBatches.push_back(std::move(batch));
+      }
+    }
+
+    uint64_t getNumberOfIdleBatches() const override {
+      std::lock_guard<std::mutex> lock(mutex);
+      return idleBatches.size();
+    }
+
+   private:
+    const RowReader& reader;
+    const uint64_t batchSize;
+    const uint64_t maxIdleBatches;
+    mutable std::mutex mutex;
+    std::vector<std::unique_ptr<ColumnVectorBatch>> idleBatches;
+  };
+
+  std::unique_ptr<RowBatchPool> createRowBatchPool(const RowReader& reader, uint64_t batchSize,
+                                                   uint64_t maxIdleBatches) {
+    return std::make_unique<RowBatchPoolImpl>(reader, batchSize, maxIdleBatches);
+  }
+
   Reader::~Reader() {
     // PASS
   }
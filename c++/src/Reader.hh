@@ -25,6 +25,7 @@
 #include "orc/Reader.hh"
 
 #include "ColumnReader.hh"
+#include "FileTailCache.hh"
 #include "RLE.hh"
 #include "SchemaEvolution.hh"
 #include "TypeImpl.hh"
@@ -58,8 +59,9 @@ namespace orc {
    */
   struct FileContents {
     std::unique_ptr<InputStream> stream;
-    std::unique_ptr<proto::PostScript> postscript;
-    std::unique_ptr<proto::Footer> footer;
+    // shared with the file tail cache, which is why they are read-only
+    std::shared_ptr<proto::PostScript> postscript;
+    std::shared_ptr<proto::Footer> footer;
     std::unique_ptr<Type> schema;
     uint64_t blockSize;
     CompressionKind compression;
@@ -68,13 +70,22 @@ namespace orc {
     /// Decimal64 in ORCv2 uses RLE to store values. This flag indicates whether
     /// this new encoding is used.
     bool isDecimalAsLong;
-    std::unique_ptr<proto::Metadata> metadata;
+    std::shared_ptr<proto::Metadata> metadata;
     ReaderMetrics* readerMetrics;
+    // the file tail cache and the key of the file in it, if set
+    std::shared_ptr<FileTailCacheImpl> tailCache;
+    std::string tailCacheKey;
   };
 
   proto::StripeFooter getStripeFooter(const proto::StripeInformation& info,
                                       const FileContents& contents);
 
+  /**
+   * Check if the file has inconsistent bloom filters written by old releases
+   * of the C++ writer.
+   */
+  bool hasBadBloomFilters(const proto::Footer& footer);
+
   class ReaderImpl;
   class Timezone;
 
@@ -159,14 +170,31 @@ namespace orc {
 
     bool enableEncodedBlock;
     bool useTightNumericVector;
+    bool useOffsetStringVector;
+    bool useNotNullBitmap;
+    // the pool of the reader if it tracks its memory use
+    const TrackingMemoryPool* trackingPool;
     bool throwOnSchemaEvolutionOverflow;
+    // the last string dictionary of each dictionary encoded column
+    mutable std::unordered_map<uint64_t, std::shared_ptr<StringDictionary>> sharedDictionaries;
     // internal methods
     void startNextStripe();
     inline void markEndOfFile();
 
     // row index of current stripe with column id as the key
     std::unordered_map<uint64_t, proto::RowIndex> rowIndexes;
+    // whether loadStripeIndex() was called for the current stripe; the row
+    // indexes stay empty if no selected column has any
+    bool stripeIndexLoaded;
+    // the row index and bloom filter bytes of the current stripe not read so
+    // far; a later seek may still load the row indexes
+    uint64_t unreadRowIndexBytes;
+    uint64_t unreadBloomFilterBytes;
     std::map<uint32_t, BloomFilterIndex> bloomFilterIndex;
+    // page-level min/max statistics of current stripe with column id as the key
+    std::unordered_map<uint64_t, proto::RowIndex> zoneMaps;
+    // rows per zone map page of current stripe, 0 if no zone map is loaded
+    uint64_t zoneMapGranularity;
     std::shared_ptr<SearchArgument> sargs;
     std::unique_ptr<SargsApplier> sargsApplier;
 
@@ -176,9 +204,24 @@ namespace orc {
     // match read and file types
     SchemaEvolution schemaEvolution;
 
-    // load stripe index if not done so
+    // load row indexes of the selected columns
     void loadStripeIndex();
 
+    // load the zone maps of the selected columns the search argument can use
+    // from the section that follows the stripe footer, if there is one
+    void loadZoneMaps();
+
+    // load the bloom filters the search argument can use, or leave them
+    // unread if they are not worth reading
+    void loadBloomFilters(bool needed);
+
+    // leave the index streams of a stripe that doesn't need them unread
+    void skipStripeIndex();
+
+    // add the index bytes the reader left the current stripe without to
+    // ReaderMetrics::SkippedIndexBytes
+    void reportSkippedIndexBytes();
+
     // In case of PPD, batch size should be aware of row group boundaries.
     // If only a subset of row groups are selected then the next read should
     // stop at the end of selected range.
@@ -205,6 +248,14 @@ namespace orc {
      */
     void seekToRowGroup(uint32_t rowGroupEntryId);
 
+    /**
+     * Position the column readers at a selected row of the current stripe.
+     * Rows within the current row group are skipped without seeking.
+     * @param fromRowInStripe the row the column readers are positioned at
+     * @param toRowInStripe the row to read next
+     */
+    void seekToSelectedRow(uint64_t fromRowInStripe, uint64_t toRowInStripe);
+
     /**
      * Check if the file has bad bloom filters. We will skip using them in the
      * following reads.
@@ -220,6 +271,8 @@ namespace orc {
      */
     RowReaderImpl(std::shared_ptr<FileContents> contents, const RowReaderOptions& options);
 
+    ~RowReaderImpl() override;
+
     // Select the columns from the options object
     const std::vector<bool> getSelectedColumns() const override;
 
@@ -245,6 +298,10 @@ namespace orc {
     const SchemaEvolution* getSchemaEvolution() const {
       return &schemaEvolution;
     }
+
+    std::shared_ptr<StringDictionary>* getSharedDictionary(uint64_t columnId) const {
+      return &sharedDictionaries[columnId];
+    }
   };
 
   class ReaderImpl : public Reader {
@@ -360,6 +417,12 @@ namespace orc {
       return contents->schema.get();
     }
 
+    /**
+     * Get the stripe statistics of the file, reading them if not done so.
+     * @return nullptr if the file has no stripe statistics
+     */
+    const proto::Metadata* getMetadata() const;
+
     InputStream* getStream() const {
       return contents->stream.get();
     }
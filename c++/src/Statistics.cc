@@ -279,23 +279,108 @@ namespace orc {
   }
 
   StringColumnStatisticsImpl::StringColumnStatisticsImpl(const proto::ColumnStatistics& pb,
-                                                         const StatContext& statContext) {
+                                                         const StatContext& statContext)
+      : _maxLength(0), _isMinimumTruncated(false), _isMaximumTruncated(false) {
     _stats.setNumberOfValues(pb.number_of_values());
     _stats.setHasNull(pb.has_null());
     if (!pb.has_string_statistics() || !statContext.correctStats) {
       _stats.setTotalLength(0);
     } else {
       const proto::StringStatistics& stats = pb.string_statistics();
-      _stats.setHasMinimum(stats.has_minimum());
-      _stats.setHasMaximum(stats.has_maximum());
+      _isMinimumTruncated = !stats.has_minimum() && stats.has_lower_bound();
+      _isMaximumTruncated = !stats.has_maximum() && stats.has_upper_bound();
+      _stats.setHasMinimum(stats.has_minimum() || _isMinimumTruncated);
+      _stats.setHasMaximum(stats.has_maximum() || _isMaximumTruncated);
       _stats.setHasTotalLength(stats.has_sum());
 
-      _stats.setMinimum(stats.minimum());
-      _stats.setMaximum(stats.maximum());
+      _stats.setMinimum(_isMinimumTruncated ? stats.lower_bound() : stats.minimum());
+      _stats.setMaximum(_isMaximumTruncated ? stats.upper_bound() : stats.maximum());
       _stats.setTotalLength(static_cast<uint64_t>(stats.sum()));
     }
   }
 
+  // the length of the longest prefix of at most maxLength bytes that ends
+  // between UTF-8 characters
+  static size_t truncateUtf8(const char* value, size_t length, uint64_t maxLength) {
+    size_t end = static_cast<size_t>(std::min<uint64_t>(length, maxLength));
+    while (end > 0 && end < length && (value[end] & 0xC0) == 0x80) {
+      --end;
+    }
+    return end;
+  }
+
+  std::string StringColumnStatisticsImpl::truncateLowerBound(const char* value, size_t length,
+                                                             uint64_t maxLength) {
+    return std::string(value, truncateUtf8(value, length, maxLength));
+  }
+
+  bool StringColumnStatisticsImpl::truncateUpperBound(const char* value, size_t length,
+                                                      uint64_t maxLength, std::string& bound) {
+    size_t end = truncateUtf8(value, length, maxLength);
+    if (end == 0) {
+      // keep the first character when it is longer than maxLength
+      end = std::min<size_t>(1, length);
+      while (end < length && (value[end] & 0xC0) == 0x80) {
+        ++end;
+      }
+    }
+    while (end > 0) {
+      size_t start = end - 1;
+      while (start > 0 && (value[start] & 0xC0) == 0x80) {
+        --start;
+      }
+      // decode the last character, which the bound replaces with the next one
+      const unsigned char* bytes = reinterpret_cast<const unsigned char*>(value + start);
+      size_t charLength = end - start;
+      uint32_t codePoint = 0;
+      if (charLength == 1 && bytes[0] < 0x80) {
+        codePoint = bytes[0];
+      } else if (charLength >= 2 && charLength <= 4) {
+        codePoint = bytes[0] & (0x7F >> charLength);
+        for (size_t i = 1; i < charLength; ++i) {
+          codePoint = (codePoint << 6) | (bytes[i] & 0x3F);
+        }
+      } else {
+        codePoint = 0x110000;
+      }
+      codePoint += 1;
+      if (codePoint >= 0xD800 && codePoint <= 0xDFFF) {
+        codePoint = 0xE000;
+      }
+      char next[4];
+      size_t nextLength;
+      if (codePoint < 0x80) {
+        next[0] = static_cast<char>(codePoint);
+        nextLength = 1;
+      } else if (codePoint < 0x800) {
+        next[0] = static_cast<char>(0xC0 | (codePoint >> 6));
+        next[1] = static_cast<char>(0x80 | (codePoint & 0x3F));
+        nextLength = 2;
+      } else if (codePoint < 0x10000) {
+        next[0] = static_cast<char>(0xE0 | (codePoint >> 12));
+        next[1] = static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+        next[2] = static_cast<char>(0x80 | (codePoint & 0x3F));
+        nextLength = 3;
+      } else {
+        next[0] = static_cast<char>(0xF0 | (codePoint >> 18));
+        next[1] = static_cast<char>(0x80 | ((codePoint >> 12) & 0x3F));
+        next[2] = static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+        next[3] = static_cast<char>(0x80 | (codePoint & 0x3F));
+        nextLength = 4;
+      }
+      // malformed characters may not encode to larger bytes, so check that
+      // the bound is above every string starting with the truncated prefix
+      if (codePoint <= 0x10FFFF &&
+          memcmp(next, value + start, std::min(nextLength, charLength)) > 0) {
+        bound.assign(value, start);
+        bound.append(next, nextLength);
+        return true;
+      }
+      end = start;
+    }
+    return false;
+  }
+
   TimestampColumnStatisticsImpl::TimestampColumnStatisticsImpl(const proto::ColumnStatistics& pb,
                                                                const StatContext& statContext) {
     _stats.setNumberOfValues(pb.number_of_values());
@@ -382,7 +467,8 @@ namespace orc {
     }
   }
 
-  std::unique_ptr<MutableColumnStatistics> createColumnStatistics(const Type& type) {
+  std::unique_ptr<MutableColumnStatistics> createColumnStatistics(const Type& type,
+                                                                  uint64_t maxStringLength) {
     switch (static_cast<int64_t>(type.getKind())) {
       case BOOLEAN:
         return std::make_unique<BooleanColumnStatisticsImpl>();
@@ -405,7 +491,7 @@ namespace orc {
       case STRING:
       case CHAR:
       case VARCHAR:
-        return std::make_unique<StringColumnStatisticsImpl>();
+        return std::make_unique<StringColumnStatisticsImpl>(maxStringLength);
       case DATE:
         return std::make_unique<DateColumnStatisticsImpl>();
       case TIMESTAMP:
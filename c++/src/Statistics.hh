@@ -27,6 +27,9 @@
 #include "Timezone.hh"
 #include "TypeImpl.hh"
 
+#include <algorithm>
+#include <limits>
+
 namespace orc {
 
   /**
@@ -552,6 +555,29 @@ namespace orc {
       _stats.updateMinMax(value);
     }
 
+    // update with the values of a batch that are not null, including their
+    // count
+    void updateBatch(const int64_t* values, const char* notNull, uint64_t numValues) {
+      int32_t minimum = std::numeric_limits<int32_t>::max();
+      int32_t maximum = std::numeric_limits<int32_t>::min();
+      uint64_t count = 0;
+      for (uint64_t i = 0; i < numValues; ++i) {
+        bool isSet = notNull == nullptr || notNull[i];
+        int32_t value = static_cast<int32_t>(values[i]);
+        minimum = std::min(minimum, isSet ? value : std::numeric_limits<int32_t>::max());
+        maximum = std::max(maximum, isSet ? value : std::numeric_limits<int32_t>::min());
+        count += isSet;
+      }
+      if (count > 0) {
+        _stats.updateMinMax(minimum);
+        _stats.updateMinMax(maximum);
+      }
+      increase(count);
+      if (count < numValues) {
+        setHasNull(true);
+      }
+    }
+
     void merge(const MutableColumnStatistics& other) override {
       const DateColumnStatisticsImpl& dateStats =
           dynamic_cast<const DateColumnStatisticsImpl&>(other);
@@ -866,6 +892,53 @@ namespace orc {
       _stats.setSum(_stats.getSum() + value);
     }
 
+    // update with the values of a batch that are not null, including their
+    // count, with the same result as calling update() for each of them
+    template <typename T>
+    void updateBatch(const T* values, const char* notNull, uint64_t numValues) {
+      uint64_t i = 0;
+      if (!_stats.hasMinimum()) {
+        // the first value becomes the minimum and maximum even if it is NaN
+        while (i < numValues && notNull != nullptr && !notNull[i]) {
+          ++i;
+        }
+        if (i == numValues) {
+          if (numValues > 0) {
+            setHasNull(true);
+          }
+          return;
+        }
+        _stats.updateMinMax(static_cast<double>(values[i]));
+      }
+      // NaNs fail both comparisons like they do in updateMinMax()
+      double minimum = std::numeric_limits<double>::infinity();
+      double maximum = -std::numeric_limits<double>::infinity();
+      double sum = _stats.getSum();
+      uint64_t count = 0;
+      for (; i < numValues; ++i) {
+        if (notNull == nullptr || notNull[i]) {
+          double value = static_cast<double>(values[i]);
+          if (value < minimum) {
+            minimum = value;
+          }
+          if (maximum < value) {
+            maximum = value;
+          }
+          sum += value;
+          ++count;
+        }
+      }
+      if (minimum <= maximum) {
+        _stats.updateMinMax(minimum);
+        _stats.updateMinMax(maximum);
+      }
+      _stats.setSum(sum);
+      increase(count);
+      if (count < numValues) {
+        setHasNull(true);
+      }
+    }
+
     void merge(const MutableColumnStatistics& other) override {
       const DoubleColumnStatisticsImpl& doubleStats =
           dynamic_cast<const DoubleColumnStatisticsImpl&>(other);
@@ -932,6 +1005,33 @@ namespace orc {
    private:
     InternalIntegerStatistics _stats;
 
+    static uint64_t absolute(int64_t value) {
+      return value < 0 ? 0 - static_cast<uint64_t>(value) : static_cast<uint64_t>(value);
+    }
+
+    template <typename T>
+    void addBatchSum(const T* values, const char* notNull, uint64_t numValues, uint64_t count,
+                     int64_t minimum, int64_t maximum, uint64_t batchSum) {
+      const uint64_t limit = static_cast<uint64_t>(std::numeric_limits<int64_t>::max());
+      uint64_t maxAbsolute = std::max(absolute(minimum), absolute(maximum));
+      uint64_t sumAbsolute = absolute(_stats.getSum());
+      // no partial sum exceeds |sum| + count * max(|value|)
+      if (sumAbsolute <= limit &&
+          (maxAbsolute == 0 || count <= (limit - sumAbsolute) / maxAbsolute)) {
+        _stats.setSum(static_cast<int64_t>(static_cast<uint64_t>(_stats.getSum()) + batchSum));
+        return;
+      }
+      int64_t sum = _stats.getSum();
+      for (uint64_t i = 0; i < numValues; ++i) {
+        if ((notNull == nullptr || notNull[i]) &&
+            !addExact(sum, static_cast<int64_t>(values[i]), &sum)) {
+          _stats.setHasSum(false);
+          return;
+        }
+      }
+      _stats.setSum(sum);
+    }
+
    public:
     IntegerColumnStatisticsImpl() {
       reset();
@@ -1028,6 +1128,49 @@ namespace orc {
       }
     }
 
+    // update with the values of a batch that are not null, including their
+    // count. The minimum, maximum and sum are computed in one branch free
+    // pass; the sum is added at once when no partial sum can overflow and
+    // value by value otherwise, so the result matches calling update() for
+    // each value.
+    template <typename T>
+    void updateBatch(const T* values, const char* notNull, uint64_t numValues) {
+      int64_t minimum = std::numeric_limits<int64_t>::max();
+      int64_t maximum = std::numeric_limits<int64_t>::min();
+      // wraps around on overflow, in which case it is not used
+      uint64_t sum = 0;
+      uint64_t count = 0;
+      if (notNull == nullptr) {
+        for (uint64_t i = 0; i < numValues; ++i) {
+          int64_t value = static_cast<int64_t>(values[i]);
+          minimum = std::min(minimum, value);
+          maximum = std::max(maximum, value);
+          sum += static_cast<uint64_t>(value);
+        }
+        count = numValues;
+      } else {
+        for (uint64_t i = 0; i < numValues; ++i) {
+          bool isSet = notNull[i] != 0;
+          int64_t value = static_cast<int64_t>(values[i]);
+          minimum = std::min(minimum, isSet ? value : std::numeric_limits<int64_t>::max());
+          maximum = std::max(maximum, isSet ? value : std::numeric_limits<int64_t>::min());
+          sum += isSet ? static_cast<uint64_t>(value) : 0;
+          count += isSet;
+        }
+      }
+      if (count > 0) {
+        _stats.updateMinMax(minimum);
+        _stats.updateMinMax(maximum);
+        if (_stats.hasSum()) {
+          addBatchSum(values, notNull, numValues, count, minimum, maximum, sum);
+        }
+      }
+      increase(count);
+      if (count < numValues) {
+        setHasNull(true);
+      }
+    }
+
     void merge(const MutableColumnStatistics& other) override {
       const IntegerColumnStatisticsImpl& intStats =
           dynamic_cast<const IntegerColumnStatisticsImpl&>(other);
@@ -1098,9 +1241,71 @@ namespace orc {
   class StringColumnStatisticsImpl : public StringColumnStatistics, public MutableColumnStatistics {
    private:
     InternalStringStatistics _stats;
+    // the longest minimum and maximum kept, 0 for no limit; longer ones are
+    // truncated into a lower and an upper bound
+    uint64_t _maxLength;
+    bool _isMinimumTruncated;
+    bool _isMaximumTruncated;
+
+    // compare like strncmp, with the shorter string first on a tie
+    static int compareStrings(const char* left, size_t leftLength, const char* right,
+                              size_t rightLength) {
+      int cmp = strncmp(left, right, std::min(leftLength, rightLength));
+      if (cmp != 0 || leftLength == rightLength) {
+        return cmp;
+      }
+      return leftLength < rightLength ? -1 : 1;
+    }
+
+    void updateMinMax(const char* value, size_t length) {
+      if (!_stats.hasMinimum()) {
+        updateMinimum(value, length);
+        updateMaximum(value, length);
+      } else {
+        const std::string& minimum = _stats.getMinimum();
+        if (compareStrings(minimum.c_str(), minimum.length(), value, length) > 0) {
+          updateMinimum(value, length);
+        }
+        const std::string& maximum = _stats.getMaximum();
+        if (compareStrings(maximum.c_str(), maximum.length(), value, length) < 0) {
+          updateMaximum(value, length);
+        }
+      }
+    }
+
+    void updateMinimum(const char* value, size_t length) {
+      _isMinimumTruncated = _maxLength != 0 && length > _maxLength;
+      _stats.setHasMinimum(true);
+      _stats.setMinimum(_isMinimumTruncated ? truncateLowerBound(value, length, _maxLength)
+                                            : std::string(value, length));
+    }
+
+    void updateMaximum(const char* value, size_t length) {
+      std::string bound;
+      _isMaximumTruncated = _maxLength != 0 && length > _maxLength &&
+                            truncateUpperBound(value, length, _maxLength, bound);
+      _stats.setHasMaximum(true);
+      _stats.setMaximum(_isMaximumTruncated ? std::move(bound) : std::string(value, length));
+    }
 
    public:
-    StringColumnStatisticsImpl() {
+    /**
+     * Truncate a string to at most maxLength bytes, cutting between UTF-8
+     * characters, to get a lower bound of it.
+     */
+    static std::string truncateLowerBound(const char* value, size_t length, uint64_t maxLength);
+
+    /**
+     * Truncate a string to about maxLength bytes and increment its last
+     * UTF-8 character to get an upper bound of it, as Java ORC does.
+     * @param bound set to the upper bound
+     * @return false if there is no shorter upper bound, in which case bound
+     * is left as it is
+     */
+    static bool truncateUpperBound(const char* value, size_t length, uint64_t maxLength,
+                                   std::string& bound);
+
+    explicit StringColumnStatisticsImpl(uint64_t maxLength = 0) : _maxLength(maxLength) {
       reset();
     }
     StringColumnStatisticsImpl(const proto::ColumnStatistics& stats,
@@ -1108,10 +1313,18 @@ namespace orc {
     virtual ~StringColumnStatisticsImpl() override;
 
     bool hasMinimum() const override {
-      return _stats.hasMinimum();
+      return _stats.hasMinimum() && !_isMinimumTruncated;
     }
 
     bool hasMaximum() const override {
+      return _stats.hasMaximum() && !_isMaximumTruncated;
+    }
+
+    bool hasLowerBound() const override {
+      return _stats.hasMinimum();
+    }
+
+    bool hasUpperBound() const override {
       return _stats.hasMaximum();
     }
 
@@ -1155,14 +1368,32 @@ namespace orc {
       }
     }
 
+    const std::string& getLowerBound() const override {
+      if (hasLowerBound()) {
+        return _stats.getMinimum();
+      } else {
+        throw ParseError("LowerBound is not defined.");
+      }
+    }
+
+    const std::string& getUpperBound() const override {
+      if (hasUpperBound()) {
+        return _stats.getMaximum();
+      } else {
+        throw ParseError("UpperBound is not defined.");
+      }
+    }
+
     void setMinimum(std::string minimum) {
       _stats.setHasMinimum(true);
       _stats.setMinimum(minimum);
+      _isMinimumTruncated = false;
     }
 
     void setMaximum(std::string maximum) {
       _stats.setHasMaximum(true);
       _stats.setMaximum(maximum);
+      _isMaximumTruncated = false;
     }
 
     uint64_t getTotalLength() const override {
@@ -1180,42 +1411,88 @@ namespace orc {
 
     void update(const char* value, size_t length) {
       if (value != nullptr) {
-        if (!_stats.hasMinimum()) {
-          std::string tempStr(value, value + length);
-          setMinimum(tempStr);
-          setMaximum(tempStr);
-        } else {
-          // update min
-          int minCmp = strncmp(_stats.getMinimum().c_str(), value,
-                               std::min(_stats.getMinimum().length(), length));
-          if (minCmp > 0 || (minCmp == 0 && length < _stats.getMinimum().length())) {
-            setMinimum(std::string(value, value + length));
-          }
+        updateMinMax(value, length);
+      }
+
+      _stats.setTotalLength(_stats.getTotalLength() + length);
+    }
 
-          // update max
-          int maxCmp = strncmp(_stats.getMaximum().c_str(), value,
-                               std::min(_stats.getMaximum().length(), length));
-          if (maxCmp < 0 || (maxCmp == 0 && length > _stats.getMaximum().length())) {
-            setMaximum(std::string(value, value + length));
+    // update with the values of a batch that are not null, including their
+    // count. The minimum and maximum of the batch are found first, so the
+    // members are compared and copied at most twice per batch.
+    void updateBatch(char* const* values, const int64_t* lengths, const char* notNull,
+                     uint64_t numValues) {
+      const char* minimum = nullptr;
+      const char* maximum = nullptr;
+      size_t minLength = 0;
+      size_t maxLength = 0;
+      uint64_t totalLength = 0;
+      uint64_t count = 0;
+      for (uint64_t i = 0; i < numValues; ++i) {
+        if (notNull == nullptr || notNull[i]) {
+          const char* value = values[i];
+          size_t length = static_cast<size_t>(lengths[i]);
+          totalLength += length;
+          ++count;
+          if (value == nullptr) {
+            continue;
+          }
+          if (minimum == nullptr) {
+            minimum = maximum = value;
+            minLength = maxLength = length;
+          } else if (compareStrings(minimum, minLength, value, length) > 0) {
+            minimum = value;
+            minLength = length;
+          } else if (compareStrings(maximum, maxLength, value, length) < 0) {
+            maximum = value;
+            maxLength = length;
           }
         }
       }
-
-      _stats.setTotalLength(_stats.getTotalLength() + length);
+      if (minimum != nullptr) {
+        updateMinMax(minimum, minLength);
+        updateMinMax(maximum, maxLength);
+      }
+      _stats.setTotalLength(_stats.getTotalLength() + totalLength);
+      increase(count);
+      if (count < numValues) {
+        setHasNull(true);
+      }
     }
 
     void update(std::string value) {
       update(value.c_str(), value.length());
     }
 
+    // add the length of values already passed to update()
+    void increaseTotalLength(uint64_t length) {
+      _stats.setTotalLength(_stats.getTotalLength() + length);
+    }
+
     void merge(const MutableColumnStatistics& other) override {
       const StringColumnStatisticsImpl& strStats =
           dynamic_cast<const StringColumnStatisticsImpl&>(other);
+      // the bound that wins decides whether the result is a bound; when
+      // they are equal, one exact value makes the result exact
+      if (strStats._stats.hasMinimum()) {
+        if (!_stats.hasMinimum() || strStats._stats.getMinimum() < _stats.getMinimum()) {
+          _isMinimumTruncated = strStats._isMinimumTruncated;
+        } else if (strStats._stats.getMinimum() == _stats.getMinimum()) {
+          _isMinimumTruncated = _isMinimumTruncated && strStats._isMinimumTruncated;
+        }
+        if (!_stats.hasMaximum() || _stats.getMaximum() < strStats._stats.getMaximum()) {
+          _isMaximumTruncated = strStats._isMaximumTruncated;
+        } else if (strStats._stats.getMaximum() == _stats.getMaximum()) {
+          _isMaximumTruncated = _isMaximumTruncated && strStats._isMaximumTruncated;
+        }
+      }
       _stats.merge(strStats._stats);
     }
 
     void reset() override {
       _stats.reset();
+      _isMinimumTruncated = false;
+      _isMaximumTruncated = false;
       setTotalLength(0);
     }
 
@@ -1224,12 +1501,21 @@ namespace orc {
       pbStats.set_number_of_values(_stats.getNumberOfValues());
 
       proto::StringStatistics* strStats = pbStats.mutable_string_statistics();
+      strStats->clear_minimum();
+      strStats->clear_maximum();
+      strStats->clear_lower_bound();
+      strStats->clear_upper_bound();
       if (_stats.hasMinimum()) {
-        strStats->set_minimum(_stats.getMinimum());
-        strStats->set_maximum(_stats.getMaximum());
-      } else {
-        strStats->clear_minimum();
-        strStats->clear_maximum();
+        if (_isMinimumTruncated) {
+          strStats->set_lower_bound(_stats.getMinimum());
+        } else {
+          strStats->set_minimum(_stats.getMinimum());
+        }
+        if (_isMaximumTruncated) {
+          strStats->set_upper_bound(_stats.getMaximum());
+        } else {
+          strStats->set_maximum(_stats.getMaximum());
+        }
       }
       if (_stats.hasTotalLength()) {
         strStats->set_sum(static_cast<int64_t>(_stats.getTotalLength()));
@@ -1245,12 +1531,16 @@ namespace orc {
              << "Has null: " << (hasNull() ? "yes" : "no") << std::endl;
       if (hasMinimum()) {
         buffer << "Minimum: " << getMinimum() << std::endl;
+      } else if (hasLowerBound()) {
+        buffer << "LowerBound: " << getLowerBound() << std::endl;
       } else {
         buffer << "Minimum is not defined" << std::endl;
       }
 
       if (hasMaximum()) {
         buffer << "Maximum: " << getMaximum() << std::endl;
+      } else if (hasUpperBound()) {
+        buffer << "UpperBound: " << getUpperBound() << std::endl;
       } else {
         buffer << "Maximum is not defined" << std::endl;
       }
@@ -1748,9 +2038,12 @@ namespace orc {
   /**
    * Create ColumnStatistics for writers
    * @param type of column
+   * @param maxStringLength the longest string minimum and maximum kept, 0
+   * for no limit
    * @return MutableColumnStatistics instances
    */
-  std::unique_ptr<MutableColumnStatistics> createColumnStatistics(const Type& type);
+  std::unique_ptr<MutableColumnStatistics> createColumnStatistics(const Type& type,
+                                                                  uint64_t maxStringLength = 0);
 
 }  // namespace orc
 
@@ -82,7 +82,7 @@ namespace orc {
                                                                     bool shouldStream) const {
     uint64_t offset = stripeStart;
     uint64_t dataEnd = stripeInfo.offset() + stripeInfo.index_length() + stripeInfo.data_length();
-    MemoryPool* pool = reader.getFileContents().pool;
+    MemoryPool* pool = &getColumnMemoryPool(*reader.getFileContents().pool, columnId);
     for (int i = 0; i < footer.streams_size(); ++i) {
       const proto::Stream& stream = footer.streams(i);
       if (stream.has_kind() && stream.kind() == kind &&
@@ -98,11 +98,19 @@ namespace orc {
               << ", stripeDataLength=" << stripeInfo.data_length();
           throw ParseError(msg.str());
         }
-        return createDecompressor(reader.getCompression(),
-                                  std::make_unique<SeekableFileInputStream>(
-                                      &input, offset, stream.length(), *pool, myBlock),
-                                  reader.getCompressionSize(), *pool,
-                                  reader.getFileContents().readerMetrics);
+        // Defer allocating the decompression buffers until the column reader
+        // actually reads or seeks the stream.
+        CompressionKind compression = reader.getCompression();
+        uint64_t blockSize = reader.getCompressionSize();
+        ReaderMetrics* metrics = reader.getFileContents().readerMetrics;
+        InputStream* file = &input;
+        return std::make_unique<LazySeekableInputStream>(
+            [=]() -> std::unique_ptr<SeekableInputStream> {
+              return createDecompressor(compression,
+                                        std::make_unique<SeekableFileInputStream>(
+                                            file, offset, streamLength, *pool, myBlock),
+                                        blockSize, *pool, metrics);
+            });
       }
       offset += stream.length();
     }
@@ -133,6 +141,11 @@ namespace orc {
     return reader.getSchemaEvolution();
   }
 
+  std::shared_ptr<StringDictionary>* StripeStreamsImpl::getSharedDictionary(
+      uint64_t columnId) const {
+    return reader.getSharedDictionary(columnId);
+  }
+
   void StripeInformationImpl::ensureStripeFooterLoaded() const {
     if (stripeFooter.get() == nullptr) {
       std::unique_ptr<SeekableInputStream> pbStream =
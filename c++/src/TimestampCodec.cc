@@ -0,0 +1,149 @@
+/**
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "TimestampCodec.hh"
+#include "orc/Exceptions.hh"
+
+#include "Dispatch.hh"
+
+namespace orc {
+
+  // the multiplication is done unsigned, so the garbage of null slots that
+  // are decoded along with their neighbours cannot overflow
+  static inline int64_t decodeNano(int64_t encoded) {
+    return static_cast<int64_t>(static_cast<uint64_t>(encoded >> 3) *
+                                static_cast<uint64_t>(NANO_SCALES[encoded & 7]));
+  }
+
+  static inline int64_t decodeSeconds(int64_t seconds, int64_t nanos, int64_t epochOffset) {
+    seconds += epochOffset;
+    return seconds - static_cast<int64_t>(seconds < 0 && nanos > 999999);
+  }
+
+  // Because the number of nanoseconds often has a large number of trailing
+  // zeros, the zeros are removed and their number is kept in the low three
+  // bits if it is at least two. At most eight zeros are removed.
+  static inline int64_t encodeNano(int64_t nanos) {
+    if (nanos == 0) {
+      return 0;
+    }
+    int64_t zeros = 0;
+    if (nanos % 100000000 == 0) {
+      nanos /= 100000000;
+      zeros = 8;
+    } else {
+      if (nanos % 10000 == 0) {
+        nanos /= 10000;
+        zeros = 4;
+      }
+      if (nanos % 100 == 0) {
+        nanos /= 100;
+        zeros += 2;
+      }
+      if (nanos % 10 == 0) {
+        nanos /= 10;
+        zeros += 1;
+      }
+    }
+    if (zeros < 2) {
+      // put back the removed zero
+      return (zeros == 0 ? nanos : nanos * 10) << 3;
+    }
+    return nanos << 3 | (zeros - 1);
+  }
+
+  void decodeTimestampsDefault(int64_t* seconds, int64_t* nanos, int64_t epochOffset,
+                               const char* notNull, uint64_t numValues) {
+    if (notNull == nullptr) {
+      for (uint64_t i = 0; i < numValues; ++i) {
+        nanos[i] = decodeNano(nanos[i]);
+        seconds[i] = decodeSeconds(seconds[i], nanos[i], epochOffset);
+      }
+    } else {
+      for (uint64_t i = 0; i < numValues; ++i) {
+        int64_t nano = decodeNano(nanos[i]);
+        int64_t second = decodeSeconds(seconds[i], nano, epochOffset);
+        nanos[i] = notNull[i] ? nano : nanos[i];
+        seconds[i] = notNull[i] ? second : seconds[i];
+      }
+    }
+  }
+
+  void decodeNanosDefault(int64_t* nanos, const char* notNull, uint64_t numValues) {
+    if (notNull == nullptr) {
+      for (uint64_t i = 0; i < numValues; ++i) {
+        nanos[i] = decodeNano(nanos[i]);
+      }
+    } else {
+      for (uint64_t i = 0; i < numValues; ++i) {
+        nanos[i] = notNull[i] ? decodeNano(nanos[i]) : nanos[i];
+      }
+    }
+  }
+
+  struct DecodeTimestampsDynamicFunction {
+    using FunctionType = decltype(&decodeTimestampsDefault);
+
+    static std::vector<std::pair<DispatchLevel, FunctionType>> implementations() {
+#if defined(ORC_HAVE_RUNTIME_AVX512)
+      return {{DispatchLevel::NONE, decodeTimestampsDefault},
+              {DispatchLevel::AVX512, decodeTimestampsAvx512}};
+#else
+      return {{DispatchLevel::NONE, decodeTimestampsDefault}};
+#endif
+    }
+  };
+
+  struct DecodeNanosDynamicFunction {
+    using FunctionType = decltype(&decodeNanosDefault);
+
+    static std::vector<std::pair<DispatchLevel, FunctionType>> implementations() {
+#if defined(ORC_HAVE_RUNTIME_AVX512)
+      return {{DispatchLevel::NONE, decodeNanosDefault},
+              {DispatchLevel::AVX512, decodeNanosAvx512}};
+#else
+      return {{DispatchLevel::NONE, decodeNanosDefault}};
+#endif
+    }
+  };
+
+  void decodeTimestamps(int64_t* seconds, int64_t* nanos, int64_t epochOffset,
+                        const char* notNull, uint64_t numValues) {
+    static DynamicDispatch<DecodeTimestampsDynamicFunction> dispatch;
+    return dispatch.func(seconds, nanos, epochOffset, notNull, numValues);
+  }
+
+  void decodeNanos(int64_t* nanos, const char* notNull, uint64_t numValues) {
+    static DynamicDispatch<DecodeNanosDynamicFunction> dispatch;
+    return dispatch.func(nanos, notNull, numValues);
+  }
+
+  void encodeTimestamps(int64_t* seconds, int64_t* nanos, int64_t epochOffset,
+                        const char* notNull, uint64_t numValues) {
+    for (uint64_t i = 0; i < numValues; ++i) {
+      if (notNull == nullptr || notNull[i]) {
+        if (seconds[i] < 0 && nanos[i] > 999999) {
+          seconds[i] += 1;
+        }
+        seconds[i] -= epochOffset;
+        nanos[i] = encodeNano(nanos[i]);
+      }
+    }
+  }
+
+}  // namespace orc
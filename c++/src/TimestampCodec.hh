@@ -0,0 +1,69 @@
+/**
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ORC_TIMESTAMP_CODEC_HH
+#define ORC_TIMESTAMP_CODEC_HH
+
+#include <cstdint>
+
+// Kernels converting between the timestamps of a TimestampVectorBatch and the
+// seconds and nanoseconds written to the DATA and SECONDARY streams. The
+// seconds are relative to the ORC epoch in the streams and the nanoseconds
+// have their trailing decimal zeros removed, with the number of removed
+// zeros minus one in the low three bits. Only the non-null values given by
+// notNull, which may be null, are converted.
+
+namespace orc {
+
+  // the factor of a decoded nanosecond value by the low three bits
+  alignas(64) constexpr int64_t NANO_SCALES[8] = {1,      100,     1000,     10000,
+                                                  100000, 1000000, 10000000, 100000000};
+
+  /**
+   * Decode the nanoseconds and move the seconds from the writer's epoch to
+   * the unix epoch, borrowing a second for negative seconds as the writer
+   * carried one.
+   */
+  void decodeTimestamps(int64_t* seconds, int64_t* nanos, int64_t epochOffset,
+                        const char* notNull, uint64_t numValues);
+
+  /**
+   * Decode the nanoseconds only, for readers that adjust the seconds between
+   * timezones themselves.
+   */
+  void decodeNanos(int64_t* nanos, const char* notNull, uint64_t numValues);
+
+  /**
+   * The inverse of decodeTimestamps().
+   */
+  void encodeTimestamps(int64_t* seconds, int64_t* nanos, int64_t epochOffset,
+                        const char* notNull, uint64_t numValues);
+
+  void decodeTimestampsDefault(int64_t* seconds, int64_t* nanos, int64_t epochOffset,
+                               const char* notNull, uint64_t numValues);
+  void decodeNanosDefault(int64_t* nanos, const char* notNull, uint64_t numValues);
+
+#if defined(ORC_HAVE_RUNTIME_AVX512)
+  void decodeTimestampsAvx512(int64_t* seconds, int64_t* nanos, int64_t epochOffset,
+                              const char* notNull, uint64_t numValues);
+  void decodeNanosAvx512(int64_t* nanos, const char* notNull, uint64_t numValues);
+#endif
+
+}  // namespace orc
+
+#endif
@@ -0,0 +1,73 @@
+/**
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "TimestampCodec.hh"
+
+#include <immintrin.h>
+
+namespace orc {
+
+  static inline __mmask8 loadNotNullMask(const char* notNull, uint64_t i) {
+    if (notNull == nullptr) {
+      return 0xff;
+    }
+    __m128i flags = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(notNull + i));
+    return static_cast<__mmask8>(_mm_test_epi8_mask(flags, flags));
+  }
+
+  // look the scale of each value up by its low three bits, as the eight
+  // scales fill a register
+  static inline __m512i decodeNanoVector(__m512i encoded, __m512i scales) {
+    __m512i index = _mm512_and_si512(encoded, _mm512_set1_epi64(7));
+    return _mm512_mullo_epi64(_mm512_srai_epi64(encoded, 3),
+                              _mm512_permutexvar_epi64(index, scales));
+  }
+
+  void decodeTimestampsAvx512(int64_t* seconds, int64_t* nanos, int64_t epochOffset,
+                              const char* notNull, uint64_t numValues) {
+    const __m512i scales = _mm512_load_si512(NANO_SCALES);
+    const __m512i offset = _mm512_set1_epi64(epochOffset);
+    const __m512i maxNanos = _mm512_set1_epi64(999999);
+    const __m512i one = _mm512_set1_epi64(1);
+    uint64_t i = 0;
+    for (; i + 8 <= numValues; i += 8) {
+      __mmask8 mask = loadNotNullMask(notNull, i);
+      __m512i nano = decodeNanoVector(_mm512_maskz_loadu_epi64(mask, nanos + i), scales);
+      __m512i second = _mm512_add_epi64(_mm512_maskz_loadu_epi64(mask, seconds + i), offset);
+      __mmask8 borrow = _mm512_mask_cmplt_epi64_mask(mask, second, _mm512_setzero_si512()) &
+                        _mm512_cmpgt_epi64_mask(nano, maxNanos);
+      second = _mm512_mask_sub_epi64(second, borrow, second, one);
+      _mm512_mask_storeu_epi64(nanos + i, mask, nano);
+      _mm512_mask_storeu_epi64(seconds + i, mask, second);
+    }
+    decodeTimestampsDefault(seconds + i, nanos + i, epochOffset,
+                            notNull == nullptr ? nullptr : notNull + i, numValues - i);
+  }
+
+  void decodeNanosAvx512(int64_t* nanos, const char* notNull, uint64_t numValues) {
+    const __m512i scales = _mm512_load_si512(NANO_SCALES);
+    uint64_t i = 0;
+    for (; i + 8 <= numValues; i += 8) {
+      __mmask8 mask = loadNotNullMask(notNull, i);
+      __m512i nano = decodeNanoVector(_mm512_maskz_loadu_epi64(mask, nanos + i), scales);
+      _mm512_mask_storeu_epi64(nanos + i, mask, nano);
+    }
+    decodeNanosDefault(nanos + i, notNull == nullptr ? nullptr : notNull + i, numValues - i);
+  }
+
+}  // namespace orc
@@ -24,9 +24,12 @@
 #include <stdlib.h>
 #include <string.h>
 #include <time.h>
+#include <algorithm>
+#include <atomic>
 #include <filesystem>
 #include <map>
 #include <sstream>
+#include <unordered_map>
 
 namespace orc {
 
@@ -233,6 +236,8 @@ namespace orc {
     virtual ~FutureRuleImpl() override;
     bool isDefined() const override;
     const TimezoneVariant& getVariant(int64_t clk) const override;
+    const TimezoneVariant& getVariant(int64_t clk, int64_t* intervalStart,
+                                      int64_t* intervalEnd) const override;
     void print(std::ostream& out) const override;
 
     friend class FutureRuleParser;
@@ -267,6 +272,32 @@ namespace orc {
     }
   }
 
+  const TimezoneVariant& FutureRuleImpl::getVariant(int64_t clk, int64_t* intervalStart,
+                                                    int64_t* intervalEnd) const {
+    if (!hasDst) {
+      *intervalStart = INT64_MIN;
+      *intervalEnd = INT64_MAX;
+      return standard;
+    }
+    int64_t adjusted = clk % SECONDS_PER_400_YEARS;
+    if (adjusted < 0) {
+      adjusted += SECONDS_PER_400_YEARS;
+    }
+    int64_t idx = binarySearch(offsets, adjusted);
+    // the interval between the transitions around clk, which ends early at
+    // the end of the 400 year cycle
+    uint64_t next = static_cast<uint64_t>(idx) + 1;
+    int64_t cycleStart = clk - adjusted;
+    *intervalStart = cycleStart + offsets[static_cast<size_t>(idx)];
+    *intervalEnd =
+        cycleStart + (next < offsets.size() ? offsets[next] : SECONDS_PER_400_YEARS);
+    if (startInStd == (idx % 2 == 0)) {
+      return standard;
+    } else {
+      return dst;
+    }
+  }
+
   void FutureRuleImpl::print(std::ostream& out) const {
     if (isDefined()) {
       out << "  Future rule: " << ruleString << "\n";
@@ -573,6 +604,9 @@ namespace orc {
      */
     const TimezoneVariant& getVariant(int64_t clk) const override;
 
+    const TimezoneVariant& getVariant(int64_t clk, int64_t* intervalStart,
+                                      int64_t* intervalEnd) const override;
+
     void print(std::ostream&) const override;
 
     uint64_t getVersion() const override {
@@ -633,6 +667,49 @@ namespace orc {
 #endif
   static std::mutex timezone_mutex;
   static std::map<std::string, std::shared_ptr<Timezone> > timezoneCache;
+  // the timezones registered by registerTimezone(), by zone name
+  static std::map<std::string, std::shared_ptr<Timezone> > registeredTimezones;
+  // every version registered for a zone name, by its TZif data
+  static std::map<std::string, std::map<std::vector<unsigned char>, std::shared_ptr<Timezone> > >
+      registeredVersions;
+  DIAGNOSTIC_POP
+
+  // Changes whenever a timezone is registered, so that the threads drop the
+  // lookups they cached before.
+  static std::atomic<uint64_t> timezoneGeneration(0);
+
+  /**
+   * The timezones a thread has looked up, so that it only takes the mutex
+   * the first time it uses a timezone. The timezones are never freed, which
+   * keeps the pointers valid.
+   */
+  struct ThreadTimezoneCache {
+    typedef std::unordered_map<std::string, const Timezone*> TimezoneMap;
+
+    uint64_t generation = 0;
+    // Both are keyed by file name. They are kept apart because a registered
+    // timezone replaces the file of the same name only for lookups by name.
+    TimezoneMap byFilename;
+    TimezoneMap byName;
+
+    const Timezone* find(const TimezoneMap& timezones, const std::string& filename) {
+      uint64_t current = timezoneGeneration.load(std::memory_order_acquire);
+      if (generation != current) {
+        byFilename.clear();
+        byName.clear();
+        generation = current;
+      }
+      auto itr = timezones.find(filename);
+      return itr == timezones.end() ? nullptr : itr->second;
+    }
+  };
+
+  DIAGNOSTIC_PUSH
+#ifdef __clang__
+  DIAGNOSTIC_IGNORE("-Wglobal-constructors")
+  DIAGNOSTIC_IGNORE("-Wexit-time-destructors")
+#endif
+  static thread_local ThreadTimezoneCache threadTimezones;
   DIAGNOSTIC_POP
 
   Timezone::~Timezone() {
@@ -665,12 +742,9 @@ namespace orc {
   }
 
   /**
-   * Get a timezone by absolute filename.
-   * Results are cached.
+   * Get a timezone by absolute filename with timezone_mutex held.
    */
-  const Timezone& getTimezoneByFilename(const std::string& filename) {
-    // ORC-110
-    std::lock_guard<std::mutex> timezone_lock(timezone_mutex);
+  static const Timezone& loadTimezoneFile(const std::string& filename) {
     std::map<std::string, std::shared_ptr<Timezone> >::iterator itr = timezoneCache.find(filename);
     if (itr != timezoneCache.end()) {
       return *(itr->second).get();
@@ -693,6 +767,21 @@ namespace orc {
     return *timezoneCache[filename].get();
   }
 
+  /**
+   * Get a timezone by absolute filename.
+   * Results are cached.
+   */
+  const Timezone& getTimezoneByFilename(const std::string& filename) {
+    const Timezone* result = threadTimezones.find(threadTimezones.byFilename, filename);
+    if (result == nullptr) {
+      // ORC-110
+      std::lock_guard<std::mutex> timezone_lock(timezone_mutex);
+      result = &loadTimezoneFile(filename);
+      threadTimezones.byFilename[filename] = result;
+    }
+    return *result;
+  }
+
   /**
    * Get the local timezone.
    */
@@ -712,7 +801,43 @@ namespace orc {
     std::string filename(getTimezoneDirectory());
     filename += "/";
     filename += zone;
-    return getTimezoneByFilename(filename);
+    const Timezone* result = threadTimezones.find(threadTimezones.byName, filename);
+    if (result == nullptr) {
+      std::lock_guard<std::mutex> timezone_lock(timezone_mutex);
+      auto itr = registeredTimezones.find(zone);
+      if (itr != registeredTimezones.end()) {
+        result = itr->second.get();
+      } else {
+        result = &loadTimezoneFile(filename);
+      }
+      threadTimezones.byName[filename] = result;
+    }
+    return *result;
+  }
+
+  void preloadTimezones(const std::vector<std::string>& zoneNames) {
+    for (const auto& zone : zoneNames) {
+      getTimezoneByName(zone);
+    }
+  }
+
+  void registerTimezone(const std::string& zoneName, const std::vector<unsigned char>& data) {
+    std::shared_ptr<Timezone> timezone;
+    try {
+      timezone = std::make_shared<TimezoneImpl>(zoneName, data);
+    } catch (ParseError& err) {
+      throw TimezoneError(err.what());
+    }
+    std::lock_guard<std::mutex> timezone_lock(timezone_mutex);
+    // Readers may still use a replaced version, so versions are never freed.
+    // Registering the same data again reuses its version, which bounds the
+    // memory by the distinct data registered.
+    auto& version = registeredVersions[zoneName].emplace(data, timezone).first->second;
+    auto& registered = registeredTimezones[zoneName];
+    if (registered != version) {
+      registered = version;
+      timezoneGeneration.fetch_add(1, std::memory_order_release);
+    }
   }
 
   /**
@@ -868,6 +993,24 @@ namespace orc {
     }
   }
 
+  const TimezoneVariant& TimezoneImpl::getVariant(int64_t clk, int64_t* intervalStart,
+                                                  int64_t* intervalEnd) const {
+    if (clk > lastTransition) {
+      const TimezoneVariant& result = futureRule->getVariant(clk, intervalStart, intervalEnd);
+      *intervalStart = std::max(*intervalStart, lastTransition + 1);
+      return result;
+    }
+    int64_t transition = binarySearch(transitions, clk);
+    uint64_t next = static_cast<uint64_t>(transition + 1);
+    *intervalStart = transition < 0 ? INT64_MIN : transitions[static_cast<size_t>(transition)];
+    *intervalEnd = next < transitions.size() ? transitions[next] : INT64_MAX;
+    if (lastTransition != INT64_MAX) {
+      // the future rule takes over after the last transition
+      *intervalEnd = std::min(*intervalEnd, lastTransition + 1);
+    }
+    return getVariant(clk);
+  }
+
   void TimezoneImpl::print(std::ostream& out) const {
     out << "Timezone file: " << filename << "\n";
     out << "  Version: " << version << "\n";
@@ -63,6 +63,13 @@ namespace orc {
      */
     virtual const TimezoneVariant& getVariant(int64_t clk) const = 0;
 
+    /**
+     * Get the variant for the given time (time_t) and the interval of times
+     * [intervalStart, intervalEnd) around it that have the same variant.
+     */
+    virtual const TimezoneVariant& getVariant(int64_t clk, int64_t* intervalStart,
+                                              int64_t* intervalEnd) const = 0;
+
     /**
      * Get the number of seconds between the ORC epoch in this timezone
      * and Unix epoch.
@@ -92,6 +99,32 @@ namespace orc {
     virtual int64_t convertFromUTC(int64_t clk) const = 0;
   };
 
+  /**
+   * Remembers the interval of times around the last lookup that have the
+   * same variant, so that looking up times that are close to each other,
+   * like the timestamps of a stripe, skips searching the transitions.
+   */
+  class TimezoneVariantCache {
+   public:
+    explicit TimezoneVariantCache(const Timezone& _timezone)
+        : timezone(_timezone), variant(nullptr), intervalStart(0), intervalEnd(0) {
+      // PASS
+    }
+
+    const TimezoneVariant& getVariant(int64_t clk) {
+      if (clk < intervalStart || clk >= intervalEnd) {
+        variant = &timezone.getVariant(clk, &intervalStart, &intervalEnd);
+      }
+      return *variant;
+    }
+
+   private:
+    const Timezone& timezone;
+    const TimezoneVariant* variant;
+    int64_t intervalStart;
+    int64_t intervalEnd;
+  };
+
   /**
    * Get the local timezone.
    * Results are cached.
@@ -104,6 +137,12 @@ namespace orc {
    */
   const Timezone& getTimezoneByName(const std::string& zone);
 
+  /**
+   * Get a timezone by absolute filename, ignoring registered timezones.
+   * Results are cached.
+   */
+  const Timezone& getTimezoneByFilename(const std::string& filename);
+
   /**
    * Parse a set of bytes as a timezone file as if they came from filename.
    */
@@ -127,6 +166,8 @@ namespace orc {
     virtual ~FutureRule();
     virtual bool isDefined() const = 0;
     virtual const TimezoneVariant& getVariant(int64_t clk) const = 0;
+    virtual const TimezoneVariant& getVariant(int64_t clk, int64_t* intervalStart,
+                                              int64_t* intervalEnd) const = 0;
     virtual void print(std::ostream& out) const = 0;
   };
 
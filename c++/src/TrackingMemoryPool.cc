@@ -0,0 +1,215 @@
+/**
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "orc/Exceptions.hh"
+#include "orc/MemoryPool.hh"
+
+#include "Utils.hh"
+
+#include <atomic>
+#include <map>
+#include <mutex>
+#include <sstream>
+
+namespace orc {
+
+  TrackingMemoryPool::~TrackingMemoryPool() {
+    // PASS
+  }
+
+  class TrackingMemoryPoolImpl;
+
+  class ColumnMemoryPool : public MemoryPool {
+   public:
+    explicit ColumnMemoryPool(TrackingMemoryPoolImpl& _owner)
+        : owner(_owner), currentBytes(0), peakBytes(0) {}
+    ~ColumnMemoryPool() override;
+
+    char* malloc(uint64_t size) override;
+    void free(char* p) override;
+
+    TrackingMemoryPoolImpl& owner;
+    std::atomic<uint64_t> currentBytes;
+    std::atomic<uint64_t> peakBytes;
+  };
+
+  class TrackingMemoryPoolImpl : public TrackingMemoryPool {
+   public:
+    TrackingMemoryPoolImpl(const TrackingMemoryPoolOptions& options, MemoryPool& parent);
+    ~TrackingMemoryPoolImpl() override;
+
+    char* malloc(uint64_t size) override {
+      return allocate(size, nullptr);
+    }
+
+    void free(char* p) override;
+
+    uint64_t getCurrentBytes() const override {
+      return currentBytes.load();
+    }
+
+    uint64_t getPeakBytes() const override {
+      return peakBytes.load();
+    }
+
+    uint64_t getLimit() const override {
+      return limit;
+    }
+
+    MemoryPool& getColumnPool(uint64_t columnId) override;
+    uint64_t getColumnCurrentBytes(uint64_t columnId) const override;
+    uint64_t getColumnPeakBytes(uint64_t columnId) const override;
+    bool shouldFlush() const override;
+
+    char* allocate(uint64_t size, ColumnMemoryPool* column);
+
+   private:
+    // The size and column of each allocation are kept in front of it. A
+    // caching pool below leaves room for a few of these headers in each size
+    // class, so they don't change the class of a power-of-two request.
+    struct Header {
+      uint64_t size;
+      ColumnMemoryPool* column;
+    };
+    static_assert(sizeof(Header) <= 16, "the header must keep allocations 16-byte aligned");
+    static const uint64_t HEADER_SIZE = 16;
+
+    const ColumnMemoryPool* findColumnPool(uint64_t columnId) const;
+
+    MemoryPool& parent;
+    const TrackingMemoryPool* trackingParent;
+    uint64_t limit;
+    uint64_t flushThreshold;
+    std::atomic<uint64_t> currentBytes;
+    std::atomic<uint64_t> peakBytes;
+    mutable std::mutex columnsMutex;
+    std::map<uint64_t, std::unique_ptr<ColumnMemoryPool>> columns;
+  };
+
+  ColumnMemoryPool::~ColumnMemoryPool() {
+    // PASS
+  }
+
+  char* ColumnMemoryPool::malloc(uint64_t size) {
+    return owner.allocate(size, this);
+  }
+
+  void ColumnMemoryPool::free(char* p) {
+    owner.free(p);
+  }
+
+  TrackingMemoryPoolImpl::TrackingMemoryPoolImpl(const TrackingMemoryPoolOptions& options,
+                                                 MemoryPool& _parent)
+      : parent(_parent),
+        trackingParent(dynamic_cast<const TrackingMemoryPool*>(&_parent)),
+        limit(options.limit),
+        flushThreshold(options.flushThreshold),
+        currentBytes(0),
+        peakBytes(0) {
+    // PASS
+  }
+
+  TrackingMemoryPoolImpl::~TrackingMemoryPoolImpl() {
+    // PASS
+  }
+
+  char* TrackingMemoryPoolImpl::allocate(uint64_t size, ColumnMemoryPool* column) {
+    uint64_t newBytes = currentBytes.fetch_add(size) + size;
+    if (limit != 0 && newBytes > limit) {
+      currentBytes.fetch_sub(size);
+      std::stringstream msg;
+      msg << "Allocating " << size << " bytes exceeds the memory limit of " << limit
+          << " bytes with " << newBytes - size << " bytes in use";
+      throw MemoryLimitExceeded(msg.str());
+    }
+    char* block;
+    try {
+      block = parent.malloc(size + HEADER_SIZE);
+    } catch (...) {
+      currentBytes.fetch_sub(size);
+      throw;
+    }
+    updateMaximum(peakBytes, newBytes);
+    if (column != nullptr) {
+      updateMaximum(column->peakBytes, column->currentBytes.fetch_add(size) + size);
+    }
+    Header* header = reinterpret_cast<Header*>(block);
+    header->size = size;
+    header->column = column;
+    return block + HEADER_SIZE;
+  }
+
+  void TrackingMemoryPoolImpl::free(char* p) {
+    if (p == nullptr) {
+      return;
+    }
+    char* block = p - HEADER_SIZE;
+    const Header* header = reinterpret_cast<const Header*>(block);
+    currentBytes.fetch_sub(header->size);
+    if (header->column != nullptr) {
+      header->column->currentBytes.fetch_sub(header->size);
+    }
+    parent.free(block);
+  }
+
+  MemoryPool& TrackingMemoryPoolImpl::getColumnPool(uint64_t columnId) {
+    std::lock_guard<std::mutex> lock(columnsMutex);
+    std::unique_ptr<ColumnMemoryPool>& column = columns[columnId];
+    if (column == nullptr) {
+      column = std::make_unique<ColumnMemoryPool>(*this);
+    }
+    return *column;
+  }
+
+  const ColumnMemoryPool* TrackingMemoryPoolImpl::findColumnPool(uint64_t columnId) const {
+    std::lock_guard<std::mutex> lock(columnsMutex);
+    auto column = columns.find(columnId);
+    return column == columns.end() ? nullptr : column->second.get();
+  }
+
+  uint64_t TrackingMemoryPoolImpl::getColumnCurrentBytes(uint64_t columnId) const {
+    const ColumnMemoryPool* column = findColumnPool(columnId);
+    return column == nullptr ? 0 : column->currentBytes.load();
+  }
+
+  uint64_t TrackingMemoryPoolImpl::getColumnPeakBytes(uint64_t columnId) const {
+    const ColumnMemoryPool* column = findColumnPool(columnId);
+    return column == nullptr ? 0 : column->peakBytes.load();
+  }
+
+  bool TrackingMemoryPoolImpl::shouldFlush() const {
+    if (flushThreshold != 0 && currentBytes.load() > flushThreshold) {
+      return true;
+    }
+    return trackingParent != nullptr && trackingParent->shouldFlush();
+  }
+
+  std::unique_ptr<TrackingMemoryPool> createTrackingMemoryPool(
+      const TrackingMemoryPoolOptions& options, MemoryPool* parent) {
+    if (parent == nullptr) {
+      throw InvalidArgument("The parent of a tracking memory pool can't be null");
+    }
+    return std::make_unique<TrackingMemoryPoolImpl>(options, *parent);
+  }
+
+  MemoryPool& getColumnMemoryPool(MemoryPool& pool, uint64_t columnId) {
+    TrackingMemoryPool* tracking = dynamic_cast<TrackingMemoryPool*>(&pool);
+    return tracking == nullptr ? pool : tracking->getColumnPool(columnId);
+  }
+
+}  // namespace orc
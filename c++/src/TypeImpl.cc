@@ -29,6 +29,12 @@ namespace orc {
     // PASS
   }
 
+  std::unique_ptr<ColumnVectorBatch> Type::createRowBatch(uint64_t size, MemoryPool& pool,
+                                                          bool encoded, bool useTightNumericVector,
+                                                          bool) const {
+    return createRowBatch(size, pool, encoded, useTightNumericVector);
+  }
+
   TypeImpl::TypeImpl(TypeKind _kind) {
     parent = nullptr;
     columnId = -1;
@@ -285,6 +291,14 @@ namespace orc {
   std::unique_ptr<ColumnVectorBatch> TypeImpl::createRowBatch(uint64_t capacity,
                                                               MemoryPool& memoryPool, bool encoded,
                                                               bool useTightNumericVector) const {
+    return createRowBatch(capacity, memoryPool, encoded, useTightNumericVector,
+                          /*useOffsetStringVector=*/false);
+  }
+
+  std::unique_ptr<ColumnVectorBatch> TypeImpl::createRowBatch(uint64_t capacity,
+                                                              MemoryPool& memoryPool, bool encoded,
+                                                              bool useTightNumericVector,
+                                                              bool useOffsetStringVector) const {
     switch (static_cast<int64_t>(kind)) {
       case BOOLEAN:
         if (useTightNumericVector) {
@@ -322,6 +336,9 @@ namespace orc {
       case BINARY:
       case CHAR:
       case VARCHAR:
+        if (useOffsetStringVector) {
+          return std::make_unique<OffsetStringVectorBatch>(capacity, memoryPool);
+        }
         return encoded ? std::make_unique<EncodedStringVectorBatch>(capacity, memoryPool)
                        : std::make_unique<StringVectorBatch>(capacity, memoryPool);
 
@@ -332,10 +349,9 @@ namespace orc {
       case STRUCT: {
         auto result = std::make_unique<StructVectorBatch>(capacity, memoryPool);
         for (uint64_t i = 0; i < getSubtypeCount(); ++i) {
-          result->fields.push_back(
-              getSubtype(i)
-                  ->createRowBatch(capacity, memoryPool, encoded, useTightNumericVector)
-                  .release());
+          auto child = getSubtype(i)->createRowBatch(capacity, memoryPool, encoded,
+                                                     useTightNumericVector, useOffsetStringVector);
+          result->fields.push_back(child.release());
         }
         return std::move(result);
       }
@@ -343,8 +359,8 @@ namespace orc {
       case LIST: {
         auto result = std::make_unique<ListVectorBatch>(capacity, memoryPool);
         if (getSubtype(0) != nullptr) {
-          result->elements =
-              getSubtype(0)->createRowBatch(capacity, memoryPool, encoded, useTightNumericVector);
+          result->elements = getSubtype(0)->createRowBatch(
+              capacity, memoryPool, encoded, useTightNumericVector, useOffsetStringVector);
         }
         return std::move(result);
       }
@@ -352,12 +368,12 @@ namespace orc {
       case MAP: {
         auto result = std::make_unique<MapVectorBatch>(capacity, memoryPool);
         if (getSubtype(0) != nullptr) {
-          result->keys =
-              getSubtype(0)->createRowBatch(capacity, memoryPool, encoded, useTightNumericVector);
+          result->keys = getSubtype(0)->createRowBatch(
+              capacity, memoryPool, encoded, useTightNumericVector, useOffsetStringVector);
         }
         if (getSubtype(1) != nullptr) {
-          result->elements =
-              getSubtype(1)->createRowBatch(capacity, memoryPool, encoded, useTightNumericVector);
+          result->elements = getSubtype(1)->createRowBatch(
+              capacity, memoryPool, encoded, useTightNumericVector, useOffsetStringVector);
         }
         return std::move(result);
       }
@@ -373,10 +389,9 @@ namespace orc {
       case UNION: {
         auto result = std::make_unique<UnionVectorBatch>(capacity, memoryPool);
         for (uint64_t i = 0; i < getSubtypeCount(); ++i) {
-          result->children.push_back(
-              getSubtype(i)
-                  ->createRowBatch(capacity, memoryPool, encoded, useTightNumericVector)
-                  .release());
+          auto child = getSubtype(i)->createRowBatch(capacity, memoryPool, encoded,
+                                                     useTightNumericVector, useOffsetStringVector);
+          result->children.push_back(child.release());
         }
         return std::move(result);
       }
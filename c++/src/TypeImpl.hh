@@ -99,6 +99,10 @@ namespace orc {
         uint64_t size, MemoryPool& memoryPool, bool encoded = false,
         bool useTightNumericVector = false) const override;
 
+    std::unique_ptr<ColumnVectorBatch> createRowBatch(uint64_t size, MemoryPool& memoryPool,
+                                                      bool encoded, bool useTightNumericVector,
+                                                      bool useOffsetStringVector) const override;
+
     /**
      * Explicitly set the column ids. Only for internal usage.
      */
@@ -57,6 +57,14 @@ namespace orc {
     }
   };
 
+  // raise an atomic maximum, such as a peak memory metric, to the value
+  inline void updateMaximum(std::atomic<uint64_t>& maximum, uint64_t value) {
+    uint64_t current = maximum.load();
+    while (current < value && !maximum.compare_exchange_weak(current, value)) {
+      // PASS
+    }
+  }
+
 #if ENABLE_METRICS
 #define SCOPED_STOPWATCH(METRICS_PTR, LATENCY_VAR, COUNT_VAR)                           \
   AutoStopwatch measure((METRICS_PTR == nullptr ? nullptr : &METRICS_PTR->LATENCY_VAR), \
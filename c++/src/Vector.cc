@@ -19,6 +19,7 @@
 #include "orc/Vector.hh"
 
 #include "Adaptor.hh"
+#include "Bitmap.hh"
 #include "orc/Exceptions.hh"
 
 #include <cstdlib>
@@ -33,6 +34,8 @@ namespace orc {
         notNull(pool, cap),
         hasNulls(false),
         isEncoded(false),
+        useNotNullBitmap(false),
+        notNullBitmap(pool, 0),
         memoryPool(pool) {
     std::memset(notNull.data(), 1, capacity);
   }
@@ -44,7 +47,11 @@ namespace orc {
   void ColumnVectorBatch::resize(uint64_t cap) {
     if (capacity < cap) {
       capacity = cap;
-      notNull.resize(cap);
+      if (useNotNullBitmap) {
+        notNullBitmap.resize(bitmapWords(cap));
+      } else {
+        notNull.resize(cap);
+      }
     }
   }
 
@@ -53,13 +60,39 @@ namespace orc {
   }
 
   uint64_t ColumnVectorBatch::getMemoryUsage() {
-    return static_cast<uint64_t>(notNull.capacity() * sizeof(char));
+    return static_cast<uint64_t>(notNull.capacity() * sizeof(char) +
+                                 notNullBitmap.capacity() * sizeof(uint64_t));
   }
 
   bool ColumnVectorBatch::hasVariableLength() {
     return false;
   }
 
+  void ColumnVectorBatch::enableNotNullBitmap() {
+    if (useNotNullBitmap) {
+      return;
+    }
+    useNotNullBitmap = true;
+    notNullBitmap.resize(bitmapWords(capacity));
+    setAllBits(notNullBitmap.data(), capacity);
+    notNull.resize(0);
+    notNull.shrinkToFit();
+  }
+
+  uint64_t ColumnVectorBatch::getNullCount() const {
+    if (!hasNulls) {
+      return 0;
+    }
+    if (useNotNullBitmap) {
+      return numElements - countSetBits(notNullBitmap.data(), 0, numElements);
+    }
+    uint64_t nullCount = 0;
+    for (uint64_t i = 0; i < numElements; ++i) {
+      nullCount += notNull[i] == 0;
+    }
+    return nullCount;
+  }
+
   StringDictionary::StringDictionary(MemoryPool& pool)
       : dictionaryBlob(pool), dictionaryOffset(pool) {
     // PASS
@@ -87,6 +120,11 @@ namespace orc {
     }
   }
 
+  uint64_t EncodedStringVectorBatch::getMemoryUsage() {
+    return StringVectorBatch::getMemoryUsage() +
+           static_cast<uint64_t>(index.capacity() * sizeof(int32_t));
+  }
+
   StringVectorBatch::StringVectorBatch(uint64_t _capacity, MemoryPool& pool)
       : ColumnVectorBatch(_capacity, pool),
         data(pool, _capacity),
@@ -123,6 +161,37 @@ namespace orc {
                                  length.capacity() * sizeof(int64_t));
   }
 
+  OffsetStringVectorBatch::OffsetStringVectorBatch(uint64_t _capacity, MemoryPool& pool)
+      : ColumnVectorBatch(_capacity, pool), offsets(pool, _capacity + 1), blob(pool) {
+    // PASS
+  }
+
+  OffsetStringVectorBatch::~OffsetStringVectorBatch() {
+    // PASS
+  }
+
+  std::string OffsetStringVectorBatch::toString() const {
+    std::ostringstream buffer;
+    buffer << "Offset string vector <" << numElements << " of " << capacity << ">";
+    return buffer.str();
+  }
+
+  void OffsetStringVectorBatch::resize(uint64_t cap) {
+    if (capacity < cap) {
+      ColumnVectorBatch::resize(cap);
+      offsets.resize(cap + 1);
+    }
+  }
+
+  void OffsetStringVectorBatch::clear() {
+    numElements = 0;
+  }
+
+  uint64_t OffsetStringVectorBatch::getMemoryUsage() {
+    return ColumnVectorBatch::getMemoryUsage() +
+           static_cast<uint64_t>(offsets.capacity() * sizeof(int64_t) + blob.capacity());
+  }
+
   StructVectorBatch::StructVectorBatch(uint64_t cap, MemoryPool& pool)
       : ColumnVectorBatch(cap, pool) {
     // PASS
@@ -173,6 +242,13 @@ namespace orc {
     return false;
   }
 
+  void StructVectorBatch::enableNotNullBitmap() {
+    ColumnVectorBatch::enableNotNullBitmap();
+    for (size_t i = 0; i < fields.size(); i++) {
+      fields[i]->enableNotNullBitmap();
+    }
+  }
+
   ListVectorBatch::ListVectorBatch(uint64_t cap, MemoryPool& pool)
       : ColumnVectorBatch(cap, pool), offsets(pool, cap + 1) {
     // PASS
@@ -210,6 +286,13 @@ namespace orc {
     return true;
   }
 
+  void ListVectorBatch::enableNotNullBitmap() {
+    ColumnVectorBatch::enableNotNullBitmap();
+    if (elements) {
+      elements->enableNotNullBitmap();
+    }
+  }
+
   MapVectorBatch::MapVectorBatch(uint64_t cap, MemoryPool& pool)
       : ColumnVectorBatch(cap, pool), offsets(pool, cap + 1) {
     // PASS
@@ -250,6 +333,16 @@ namespace orc {
     return true;
   }
 
+  void MapVectorBatch::enableNotNullBitmap() {
+    ColumnVectorBatch::enableNotNullBitmap();
+    if (keys) {
+      keys->enableNotNullBitmap();
+    }
+    if (elements) {
+      elements->enableNotNullBitmap();
+    }
+  }
+
   UnionVectorBatch::UnionVectorBatch(uint64_t cap, MemoryPool& pool)
       : ColumnVectorBatch(cap, pool), tags(pool, cap), offsets(pool, cap) {
     // PASS
@@ -308,6 +401,13 @@ namespace orc {
     return false;
   }
 
+  void UnionVectorBatch::enableNotNullBitmap() {
+    ColumnVectorBatch::enableNotNullBitmap();
+    for (size_t i = 0; i < children.size(); ++i) {
+      children[i]->enableNotNullBitmap();
+    }
+  }
+
   Decimal64VectorBatch::Decimal64VectorBatch(uint64_t cap, MemoryPool& pool)
       : ColumnVectorBatch(cap, pool),
         precision(0),
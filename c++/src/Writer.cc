@@ -20,8 +20,10 @@
 #include "orc/OrcFile.hh"
 
 #include "ColumnWriter.hh"
+#include "MemoryManager.hh"
 #include "Timezone.hh"
 #include "Utils.hh"
+#include "ZoneMap.hh"
 
 #include <memory>
 
@@ -46,6 +48,9 @@ namespace orc {
     WriterMetrics* metrics;
     bool useTightNumericVector;
     uint64_t outputBufferCapacity;
+    uint64_t zoneMapGranularity;
+    uint64_t stringStatisticsMaxLength;
+    std::shared_ptr<MemoryManager> memoryManager;
 
     WriterOptionsPrivate() : fileVersion(FileVersion::v_0_12()) {  // default to Hive_0_12
       stripeSize = 64 * 1024 * 1024;                               // 64M
@@ -67,6 +72,8 @@ namespace orc {
       metrics = nullptr;
       useTightNumericVector = false;
       outputBufferCapacity = 1024 * 1024;
+      zoneMapGranularity = 0;
+      stringStatisticsMaxLength = 0;
     }
   };
 
@@ -284,10 +291,78 @@ namespace orc {
     return privateBits->outputBufferCapacity;
   }
 
+  WriterOptions& WriterOptions::setZoneMapGranularity(uint64_t rows) {
+    privateBits->zoneMapGranularity = rows;
+    return *this;
+  }
+
+  uint64_t WriterOptions::getZoneMapGranularity() const {
+    return privateBits->zoneMapGranularity;
+  }
+
+  WriterOptions& WriterOptions::setStringStatisticsMaxLength(uint64_t bytes) {
+    privateBits->stringStatisticsMaxLength = bytes;
+    return *this;
+  }
+
+  uint64_t WriterOptions::getStringStatisticsMaxLength() const {
+    return privateBits->stringStatisticsMaxLength;
+  }
+
+  WriterOptions& WriterOptions::setMemoryManager(std::shared_ptr<MemoryManager> manager) {
+    // the writers talk to the manager through the built-in implementation
+    if (manager != nullptr && dynamic_cast<MemoryManagerImpl*>(manager.get()) == nullptr) {
+      throw InvalidArgument("Only memory managers from createMemoryManager() are supported");
+    }
+    privateBits->memoryManager = std::move(manager);
+    return *this;
+  }
+
+  std::shared_ptr<MemoryManager> WriterOptions::getMemoryManager() const {
+    return privateBits->memoryManager;
+  }
+
   Writer::~Writer() {
     // PASS
   }
 
+  /**
+   * Keeps the compressed zone maps of a stripe in memory until the section
+   * header giving their lengths is written.
+   */
+  class ZoneMapOutputStream : public OutputStream {
+   public:
+    ZoneMapOutputStream() : name("ZoneMapOutputStream") {}
+
+    virtual uint64_t getLength() const override {
+      return data.size();
+    }
+
+    virtual uint64_t getNaturalWriteSize() const override {
+      return 128 * 1024;
+    }
+
+    virtual void write(const void* buf, size_t length) override {
+      data.append(static_cast<const char*>(buf), length);
+    }
+
+    virtual const std::string& getName() const override {
+      return name;
+    }
+
+    virtual void close() override {
+      // PASS
+    }
+
+    const std::string& getData() const {
+      return data;
+    }
+
+   private:
+    std::string name;
+    std::string data;
+  };
+
   class WriterImpl : public Writer {
    private:
     std::unique_ptr<ColumnWriter> columnWriter;
@@ -309,10 +384,20 @@ namespace orc {
     bool useTightNumericVector;
     int32_t stripesAtLastFlush;
     uint64_t lastFlushOffset;
+    // the pool of the writer if it tracks its memory use
+    const TrackingMemoryPool* trackingPool;
+    // memory in use right after the last stripe was written
+    uint64_t memoryAfterLastStripe;
+    // the memory manager shared with other writers and this writer's state
+    // in it, if set
+    std::shared_ptr<MemoryManagerImpl> memoryManager;
+    MemoryManagerImpl::WriterState* memoryManagerState;
 
    public:
     WriterImpl(const Type& type, OutputStream* stream, const WriterOptions& options);
 
+    ~WriterImpl() override;
+
     std::unique_ptr<ColumnVectorBatch> createRowBatch(uint64_t size) const override;
 
     void add(ColumnVectorBatch& rowsToAdd) override;
@@ -327,6 +412,7 @@ namespace orc {
     void init();
     void initStripe();
     void writeStripe();
+    uint64_t writeZoneMaps();
     void writeMetadata();
     void writeFileFooter();
     void writePostscript();
@@ -340,12 +426,20 @@ namespace orc {
 
   WriterImpl::WriterImpl(const Type& t, OutputStream* stream, const WriterOptions& opts)
       : outStream(stream), options(opts), type(t) {
+    if (options.getEnableIndex() && options.getZoneMapGranularity() != 0 &&
+        options.getRowIndexStride() % options.getZoneMapGranularity() != 0) {
+      throw InvalidArgument("Zone map granularity must divide the row index stride");
+    }
     streamsFactory = createStreamsFactory(options, outStream);
     columnWriter = buildWriter(type, *streamsFactory, options);
     stripeRows = totalRows = indexRows = 0;
     currentOffset = 0;
     stripesAtLastFlush = 0;
     lastFlushOffset = 0;
+    trackingPool = dynamic_cast<const TrackingMemoryPool*>(options.getMemoryPool());
+    memoryAfterLastStripe = 0;
+    memoryManager = std::dynamic_pointer_cast<MemoryManagerImpl>(options.getMemoryManager());
+    memoryManagerState = nullptr;
 
     useTightNumericVector = opts.getUseTightNumericVector();
 
@@ -362,6 +456,16 @@ namespace orc {
                                                   options.getWriterMetrics()));
 
     init();
+
+    if (memoryManager) {
+      memoryManagerState = memoryManager->addWriter(options.getStripeSize());
+    }
+  }
+
+  WriterImpl::~WriterImpl() {
+    if (memoryManagerState != nullptr) {
+      memoryManager->removeWriter(memoryManagerState);
+    }
   }
 
   std::unique_ptr<ColumnVectorBatch> WriterImpl::createRowBatch(uint64_t size) const {
@@ -373,8 +477,17 @@ namespace orc {
       uint64_t pos = 0;
       uint64_t chunkSize = 0;
       uint64_t rowIndexStride = options.getRowIndexStride();
+      uint64_t zoneMapGranularity = options.getZoneMapGranularity();
       while (pos < rowsToAdd.numElements) {
         chunkSize = std::min(rowsToAdd.numElements - pos, rowIndexStride - indexRows);
+        if (zoneMapGranularity != 0) {
+          // a full page is closed lazily since the last page of a row group
+          // is closed together with its row index entry
+          if (indexRows != 0 && indexRows % zoneMapGranularity == 0) {
+            columnWriter->createZoneMapEntry();
+          }
+          chunkSize = std::min(chunkSize, zoneMapGranularity - indexRows % zoneMapGranularity);
+        }
         columnWriter->add(rowsToAdd, pos, chunkSize, nullptr);
 
         pos += chunkSize;
@@ -391,8 +504,36 @@ namespace orc {
       columnWriter->add(rowsToAdd, 0, rowsToAdd.numElements, nullptr);
     }
 
-    if (columnWriter->getEstimatedSize() >= options.getStripeSize()) {
+    uint64_t estimatedSize = columnWriter->getEstimatedSize();
+    if (estimatedSize >= options.getStripeSize()) {
+      writeStripe();
+    } else if (memoryManagerState != nullptr &&
+               memoryManager->addedRows(memoryManagerState, rowsToAdd.numElements,
+                                        estimatedSize)) {
+      // the stripe is among the largest ones of the writers sharing the
+      // budget they exceed
+      writeStripe();
+      if (options.getWriterMetrics() != nullptr) {
+        options.getWriterMetrics()->EarlyStripeFlushCount.fetch_add(1);
+      }
+    } else if (memoryManagerState != nullptr &&
+               estimatedSize >= memoryManagerState->scaledStripeSize) {
+      // the stripe size is scaled down to share the budget with other writers
+      writeStripe();
+      if (options.getWriterMetrics() != nullptr) {
+        options.getWriterMetrics()->ScaledStripeFlushCount.fetch_add(1);
+      }
+    } else if (trackingPool != nullptr && stripeRows > 0 && trackingPool->shouldFlush() &&
+               trackingPool->getCurrentBytes() > memoryAfterLastStripe) {
+      // Under memory pressure, write the stripe as soon as it needs more
+      // memory than the buffers the last stripe left behind.
       writeStripe();
+      if (options.getWriterMetrics() != nullptr) {
+        options.getWriterMetrics()->EarlyStripeFlushCount.fetch_add(1);
+      }
+    }
+    if (trackingPool != nullptr && options.getWriterMetrics() != nullptr) {
+      updateMaximum(options.getWriterMetrics()->PeakMemoryBytes, trackingPool->getPeakBytes());
     }
   }
 
@@ -404,6 +545,13 @@ namespace orc {
     writeFileFooter();
     writePostscript();
     outStream->close();
+    if (trackingPool != nullptr && options.getWriterMetrics() != nullptr) {
+      updateMaximum(options.getWriterMetrics()->PeakMemoryBytes, trackingPool->getPeakBytes());
+    }
+    if (memoryManagerState != nullptr) {
+      memoryManager->removeWriter(memoryManagerState);
+      memoryManagerState = nullptr;
+    }
   }
 
   uint64_t WriterImpl::writeIntermediateFooter() {
@@ -473,6 +621,12 @@ namespace orc {
     stripeInfo.set_number_of_rows(0);
 
     stripeRows = indexRows = 0;
+    if (trackingPool != nullptr) {
+      memoryAfterLastStripe = trackingPool->getCurrentBytes();
+    }
+    if (memoryManagerState != nullptr) {
+      memoryManager->updateWriter(memoryManagerState, 0);
+    }
   }
 
   void WriterImpl::writeStripe() {
@@ -524,6 +678,12 @@ namespace orc {
     }
     uint64_t footerLength = compressionStream->flush();
 
+    // zone maps have no stream kind and follow the stripe footer
+    uint64_t zoneMapLength = 0;
+    if (options.getEnableIndex() && options.getZoneMapGranularity() != 0) {
+      zoneMapLength = writeZoneMaps();
+    }
+
     // calculate data length and index length
     uint64_t dataLength = 0;
     uint64_t indexLength = 0;
@@ -544,7 +704,7 @@ namespace orc {
 
     *fileFooter.add_stripes() = stripeInfo;
 
-    currentOffset = currentOffset + indexLength + dataLength + footerLength;
+    currentOffset = currentOffset + indexLength + dataLength + footerLength + zoneMapLength;
     totalRows += stripeRows;
 
     columnWriter->reset();
@@ -552,6 +712,34 @@ namespace orc {
     initStripe();
   }
 
+  uint64_t WriterImpl::writeZoneMaps() {
+    std::map<uint64_t, const proto::RowIndex*> zoneMaps;
+    columnWriter->writeZoneMaps(zoneMaps);
+
+    // compress each zone map on its own so that readers fetch only those they need
+    ZoneMapOutputStream zoneMapBuffer;
+    std::unique_ptr<BufferedOutputStream> zoneMapStream = createCompressor(
+        options.getCompression(), &zoneMapBuffer, options.getCompressionStrategy(),
+        options.getOutputBufferCapacity(), options.getCompressionBlockSize(),
+        *options.getMemoryPool(), options.getWriterMetrics());
+    std::vector<std::pair<uint64_t, uint64_t>> lengths;
+    for (const auto& zoneMap : zoneMaps) {
+      if (!zoneMap.second->SerializeToZeroCopyStream(zoneMapStream.get())) {
+        throw std::logic_error("Failed to write zone map.");
+      }
+      lengths.emplace_back(zoneMap.first, zoneMapStream->flush());
+    }
+
+    std::string header = serializeZoneMapHeader(options.getZoneMapGranularity(), lengths);
+    const std::string& data = zoneMapBuffer.getData();
+    {
+      SCOPED_STOPWATCH(options.getWriterMetrics(), IOBlockingLatencyUs, IOCount);
+      outStream->write(header.data(), header.size());
+      outStream->write(data.data(), data.size());
+    }
+    return header.size() + data.size();
+  }
+
   void WriterImpl::writeMetadata() {
     if (!metadata.SerializeToZeroCopyStream(compressionStream.get())) {
       throw std::logic_error("Failed to write metadata.");
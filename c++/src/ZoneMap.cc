@@ -0,0 +1,110 @@
+/**
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ZoneMap.hh"
+#include "orc/Exceptions.hh"
+
+#include <cstring>
+
+namespace orc {
+
+  static const size_t ZONE_MAP_MAGIC_LENGTH = sizeof(ZONE_MAP_MAGIC) - 1;
+
+  static void writeVarint(std::string& out, uint64_t value) {
+    while (value >= 0x80) {
+      out.push_back(static_cast<char>((value & 0x7f) | 0x80));
+      value >>= 7;
+    }
+    out.push_back(static_cast<char>(value));
+  }
+
+  static uint64_t readVarint(const std::string& data, size_t& position) {
+    uint64_t value = 0;
+    for (uint32_t shift = 0; shift < 64 && position < data.size(); shift += 7) {
+      auto byte = static_cast<unsigned char>(data[position++]);
+      value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+      if ((byte & 0x80) == 0) {
+        return value;
+      }
+    }
+    throw ParseError("Malformed zone map directory");
+  }
+
+  std::string serializeZoneMapHeader(uint64_t granularity,
+                                     const std::vector<std::pair<uint64_t, uint64_t>>& lengths) {
+    std::string directory;
+    writeVarint(directory, granularity);
+    writeVarint(directory, lengths.size());
+    for (const auto& length : lengths) {
+      writeVarint(directory, length.first);
+      writeVarint(directory, length.second);
+    }
+
+    std::string header(ZONE_MAP_MAGIC, ZONE_MAP_MAGIC_LENGTH);
+    for (uint32_t i = 0; i < 4; ++i) {
+      header.push_back(static_cast<char>((directory.size() >> (8 * i)) & 0xff));
+    }
+    return header + directory;
+  }
+
+  uint64_t getZoneMapDirectoryLength(const char* header) {
+    if (memcmp(header, ZONE_MAP_MAGIC, ZONE_MAP_MAGIC_LENGTH) != 0) {
+      return 0;
+    }
+    uint64_t length = 0;
+    for (uint32_t i = 0; i < 4; ++i) {
+      length |= static_cast<uint64_t>(static_cast<unsigned char>(header[ZONE_MAP_MAGIC_LENGTH + i]))
+                << (8 * i);
+    }
+    return length;
+  }
+
+  ZoneMapDirectory parseZoneMapDirectory(const std::string& directory) {
+    ZoneMapDirectory result;
+    size_t position = 0;
+    result.granularity = readVarint(directory, position);
+    uint64_t columns = readVarint(directory, position);
+    uint64_t offset = 0;
+    for (uint64_t i = 0; i < columns; ++i) {
+      uint64_t columnId = readVarint(directory, position);
+      uint64_t length = readVarint(directory, position);
+      result.columns[columnId] = std::make_pair(offset, length);
+      offset += length;
+    }
+    return result;
+  }
+
+  bool isZoneMapSupported(TypeKind kind) {
+    switch (kind) {
+      case BYTE:
+      case SHORT:
+      case INT:
+      case LONG:
+      case DATE:
+      case STRING:
+      case CHAR:
+      case VARCHAR:
+      case TIMESTAMP:
+      case TIMESTAMP_INSTANT:
+        return true;
+      default:
+        return false;
+    }
+  }
+
+}  // namespace orc
@@ -0,0 +1,92 @@
+/**
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ORC_ZONE_MAP_HH
+#define ORC_ZONE_MAP_HH
+
+#include "orc/Type.hh"
+#include "wrap/orc-proto-wrapper.hh"
+
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace orc {
+
+  /**
+   * Zone maps are optional min/max statistics recorded for fixed-size pages
+   * of rows inside each row group. They are written for each column as a
+   * serialized proto::RowIndex whose entries only carry statistics, one entry
+   * per page in stripe order.
+   *
+   * The file format has no stream kind for them, so the zone maps of a stripe
+   * are written in a section right after its stripe footer:
+   *
+   *   magic directoryLength directory zoneMap...
+   *
+   * where magic is ZONE_MAP_MAGIC, directoryLength is a 4-byte little endian
+   * integer and the directory is a sequence of varints:
+   *
+   *   granularity numberOfColumns
+   *   for each column:
+   *     columnId length
+   *
+   * giving the rows per page and the compressed length of each zone map in
+   * the order they follow the directory. The section is not covered by the
+   * StripeInformation lengths, so readers that do not know about zone maps
+   * never read it.
+   */
+  constexpr const char ZONE_MAP_MAGIC[] = "ORCZ";
+  constexpr uint64_t ZONE_MAP_HEADER_LENGTH = 8;
+
+  struct ZoneMapDirectory {
+    // rows per zone map page
+    uint64_t granularity = 0;
+    // offset after the directory and length of the zone map of each column
+    std::map<uint64_t, std::pair<uint64_t, uint64_t>> columns;
+  };
+
+  /**
+   * Build the magic, directory length and directory of a zone map section.
+   * @param granularity rows per zone map page
+   * @param lengths column id and compressed length of each zone map in the
+   *        order they are written
+   */
+  std::string serializeZoneMapHeader(uint64_t granularity,
+                                     const std::vector<std::pair<uint64_t, uint64_t>>& lengths);
+
+  /**
+   * Get the directory length from the first ZONE_MAP_HEADER_LENGTH bytes of
+   * a zone map section, or 0 if the bytes do not start one.
+   */
+  uint64_t getZoneMapDirectoryLength(const char* header);
+
+  /**
+   * Parse the directory of a zone map section.
+   */
+  ZoneMapDirectory parseZoneMapDirectory(const std::string& directory);
+
+  /**
+   * Whether zone maps are written for columns of the given type kind.
+   */
+  bool isZoneMapSupported(TypeKind kind);
+
+}  // namespace orc
+
+#endif  // ORC_ZONE_MAP_HH
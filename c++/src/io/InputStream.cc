@@ -210,4 +210,48 @@ namespace orc {
     return result.str();
   }
 
+  LazySeekableInputStream::LazySeekableInputStream(Factory _factory)
+      : factory(std::move(_factory)) {
+    // PASS
+  }
+
+  LazySeekableInputStream::~LazySeekableInputStream() {
+    // PASS
+  }
+
+  SeekableInputStream& LazySeekableInputStream::getStream() {
+    if (stream == nullptr) {
+      stream = factory();
+      factory = nullptr;
+    }
+    return *stream;
+  }
+
+  bool LazySeekableInputStream::Next(const void** data, int* size) {
+    return getStream().Next(data, size);
+  }
+
+  void LazySeekableInputStream::BackUp(int count) {
+    getStream().BackUp(count);
+  }
+
+  bool LazySeekableInputStream::Skip(int count) {
+    return getStream().Skip(count);
+  }
+
+  int64_t LazySeekableInputStream::ByteCount() const {
+    return stream == nullptr ? 0 : stream->ByteCount();
+  }
+
+  void LazySeekableInputStream::seek(PositionProvider& position) {
+    getStream().seek(position);
+  }
+
+  std::string LazySeekableInputStream::getName() const {
+    if (stream == nullptr) {
+      return "LazySeekableInputStream(unopened)";
+    }
+    return stream->getName();
+  }
+
 }  // namespace orc
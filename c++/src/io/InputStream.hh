@@ -24,6 +24,7 @@
 #include "wrap/zero-copy-stream-wrapper.h"
 
 #include <fstream>
+#include <functional>
 #include <iostream>
 #include <list>
 #include <sstream>
@@ -104,6 +105,36 @@ namespace orc {
     virtual std::string getName() const override;
   };
 
+  /**
+   * A seekable input stream that creates the underlying stream on first use.
+   * Streams of columns that are never read don't allocate their buffers.
+   */
+  class LazySeekableInputStream : public SeekableInputStream {
+   public:
+    using Factory = std::function<std::unique_ptr<SeekableInputStream>()>;
+
+   private:
+    Factory factory;
+    std::unique_ptr<SeekableInputStream> stream;
+
+    SeekableInputStream& getStream();
+
+   public:
+    explicit LazySeekableInputStream(Factory factory);
+    virtual ~LazySeekableInputStream() override;
+
+    bool isOpened() const {
+      return stream != nullptr;
+    }
+
+    virtual bool Next(const void** data, int* size) override;
+    virtual void BackUp(int count) override;
+    virtual bool Skip(int count) override;
+    virtual int64_t ByteCount() const override;
+    virtual void seek(PositionProvider& position) override;
+    virtual std::string getName() const override;
+  };
+
 }  // namespace orc
 
 #endif  // ORC_INPUTSTREAM_HH
@@ -34,6 +34,7 @@ namespace orc {
     mLiterals.emplace_back(literal);
     mHashCode = hashCode();
     validate();
+    initTypedLiterals();
   }
 
   PredicateLeaf::PredicateLeaf(Operator op, PredicateDataType type, uint64_t columnId,
@@ -42,6 +43,7 @@ namespace orc {
     mLiterals.emplace_back(literal);
     mHashCode = hashCode();
     validate();
+    initTypedLiterals();
   }
 
   PredicateLeaf::PredicateLeaf(Operator op, PredicateDataType type, const std::string& colName,
@@ -53,6 +55,7 @@ namespace orc {
         mLiterals(literals.begin(), literals.end()) {
     mHashCode = hashCode();
     validate();
+    initTypedLiterals();
   }
 
   PredicateLeaf::PredicateLeaf(Operator op, PredicateDataType type, uint64_t columnId,
@@ -64,6 +67,7 @@ namespace orc {
         mLiterals(literals.begin(), literals.end()) {
     mHashCode = hashCode();
     validate();
+    initTypedLiterals();
   }
 
   PredicateLeaf::PredicateLeaf(Operator op, PredicateDataType type, const std::string& colName,
@@ -75,6 +79,7 @@ namespace orc {
         mLiterals(literals.begin(), literals.end()) {
     mHashCode = hashCode();
     validate();
+    initTypedLiterals();
   }
 
   PredicateLeaf::PredicateLeaf(Operator op, PredicateDataType type, uint64_t columnId,
@@ -86,6 +91,7 @@ namespace orc {
         mLiterals(literals.begin(), literals.end()) {
     mHashCode = hashCode();
     validate();
+    initTypedLiterals();
   }
 
   void PredicateLeaf::validateColumn() const {
@@ -505,6 +511,32 @@ namespace orc {
     return result;
   }
 
+  void PredicateLeaf::initTypedLiterals() {
+    switch (mType) {
+      case PredicateDataType::LONG:
+        mLongLiterals = literal2Long(mLiterals);
+        break;
+      case PredicateDataType::FLOAT:
+        mDoubleLiterals = literal2Double(mLiterals);
+        break;
+      case PredicateDataType::STRING:
+        mStringLiterals = literal2String(mLiterals);
+        break;
+      case PredicateDataType::DATE:
+        mDateLiterals = literal2Date(mLiterals);
+        break;
+      case PredicateDataType::TIMESTAMP:
+        mTimestampLiterals = literal2Timestamp(mLiterals);
+        break;
+      case PredicateDataType::DECIMAL:
+        mDecimalLiterals = literal2Decimal(mLiterals);
+        break;
+      case PredicateDataType::BOOLEAN:
+      default:
+        break;
+    }
+  }
+
   TruthValue PredicateLeaf::evaluatePredicateMinMax(const proto::ColumnStatistics& colStats) const {
     TruthValue result = TruthValue::YES_NO_NULL;
     switch (mType) {
@@ -512,7 +544,7 @@ namespace orc {
         if (colStats.has_int_statistics() && colStats.int_statistics().has_minimum() &&
             colStats.int_statistics().has_maximum()) {
           const auto& stats = colStats.int_statistics();
-          result = evaluatePredicateRange(mOperator, literal2Long(mLiterals), stats.minimum(),
+          result = evaluatePredicateRange(mOperator, mLongLiterals, stats.minimum(),
                                           stats.maximum(), colStats.has_null());
         }
         break;
@@ -524,19 +556,32 @@ namespace orc {
           if (!std::isfinite(stats.sum())) {
             result = colStats.has_null() ? TruthValue::YES_NO_NULL : TruthValue::YES_NO;
           } else {
-            result = evaluatePredicateRange(mOperator, literal2Double(mLiterals), stats.minimum(),
+            result = evaluatePredicateRange(mOperator, mDoubleLiterals, stats.minimum(),
                                             stats.maximum(), colStats.has_null());
           }
         }
         break;
       }
       case PredicateDataType::STRING: {
-        /// TODO: check lowerBound and upperBound as well
-        if (colStats.has_string_statistics() && colStats.string_statistics().has_minimum() &&
-            colStats.string_statistics().has_maximum()) {
+        if (colStats.has_string_statistics()) {
+          // writers truncate long minimums and maximums into lower and upper
+          // bounds, which can rule values out but not in
           const auto& stats = colStats.string_statistics();
-          result = evaluatePredicateRange(mOperator, literal2String(mLiterals), stats.minimum(),
-                                          stats.maximum(), colStats.has_null());
+          bool hasLower = stats.has_minimum() || stats.has_lower_bound();
+          bool hasUpper = stats.has_maximum() || stats.has_upper_bound();
+          if (hasLower && hasUpper) {
+            result = evaluatePredicateRange(
+                mOperator, mStringLiterals,
+                stats.has_minimum() ? stats.minimum() : stats.lower_bound(),
+                stats.has_maximum() ? stats.maximum() : stats.upper_bound(), colStats.has_null());
+            if (!stats.has_minimum() || !stats.has_maximum()) {
+              if (result == TruthValue::YES) {
+                result = TruthValue::YES_NO;
+              } else if (result == TruthValue::YES_NULL) {
+                result = TruthValue::YES_NO_NULL;
+              }
+            }
+          }
         }
         break;
       }
@@ -544,7 +589,7 @@ namespace orc {
         if (colStats.has_date_statistics() && colStats.date_statistics().has_minimum() &&
             colStats.date_statistics().has_maximum()) {
           const auto& stats = colStats.date_statistics();
-          result = evaluatePredicateRange(mOperator, literal2Date(mLiterals), stats.minimum(),
+          result = evaluatePredicateRange(mOperator, mDateLiterals, stats.minimum(),
                                           stats.maximum(), colStats.has_null());
         }
         break;
@@ -566,7 +611,7 @@ namespace orc {
           Literal::Timestamp maxTimestamp(
               stats.maximum_utc() / 1000,
               static_cast<int32_t>((stats.maximum_utc() % 1000) * 1000000) + maxNano);
-          result = evaluatePredicateRange(mOperator, literal2Timestamp(mLiterals), minTimestamp,
+          result = evaluatePredicateRange(mOperator, mTimestampLiterals, minTimestamp,
                                           maxTimestamp, colStats.has_null());
         }
         break;
@@ -575,9 +620,8 @@ namespace orc {
         if (colStats.has_decimal_statistics() && colStats.decimal_statistics().has_minimum() &&
             colStats.decimal_statistics().has_maximum()) {
           const auto& stats = colStats.decimal_statistics();
-          result = evaluatePredicateRange(mOperator, literal2Decimal(mLiterals),
-                                          Decimal(stats.minimum()), Decimal(stats.maximum()),
-                                          colStats.has_null());
+          result = evaluatePredicateRange(mOperator, mDecimalLiterals, Decimal(stats.minimum()),
+                                          Decimal(stats.maximum()), colStats.has_null());
         }
         break;
       }
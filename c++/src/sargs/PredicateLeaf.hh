@@ -142,6 +142,8 @@ namespace orc {
 
     TruthValue evaluatePredicateBloomFiter(const BloomFilter* bloomFilter, bool hasNull) const;
 
+    void initTypedLiterals();
+
    private:
     Operator mOperator;
     PredicateDataType mType;
@@ -150,6 +152,16 @@ namespace orc {
     uint64_t mColumnId;
     std::vector<Literal> mLiterals;
     size_t mHashCode;
+
+    // Non-null literals converted once to the native type of mType, so that
+    // evaluating statistics of many row groups does not convert them again.
+    // Only the vector matching mType is populated.
+    std::vector<int64_t> mLongLiterals;
+    std::vector<int32_t> mDateLiterals;
+    std::vector<double> mDoubleLiterals;
+    std::vector<std::string> mStringLiterals;
+    std::vector<Decimal> mDecimalLiterals;
+    std::vector<Literal::Timestamp> mTimestampLiterals;
   };
 
   struct PredicateLeafHash {
@@ -17,7 +17,8 @@
  */
 
 #include "SargsApplier.hh"
-#include <numeric>
+
+#include <algorithm>
 
 namespace orc {
 
@@ -37,94 +38,253 @@ namespace orc {
     return INVALID_COLUMN_ID;
   }
 
+  static const std::vector<PredicateLeaf>& getSargsLeaves(const SearchArgument* searchArgument) {
+    const SearchArgumentImpl* sargs = dynamic_cast<const SearchArgumentImpl*>(searchArgument);
+    if (sargs == nullptr) {
+      throw InvalidArgument("Failed to cast to SearchArgumentImpl");
+    }
+    return sargs->getLeaves();
+  }
+
   SargsApplier::SargsApplier(const Type& type, const SearchArgument* searchArgument,
                              uint64_t rowIndexStride, WriterVersion writerVersion,
                              ReaderMetrics* metrics, const SchemaEvolution* schemaEvolution)
       : mType(type),
         mSearchArgument(searchArgument),
+        mLeaves(getSargsLeaves(searchArgument)),
         mSchemaEvolution(schemaEvolution),
         mRowIndexStride(rowIndexStride),
+        mSkipStride(rowIndexStride),
         mWriterVersion(writerVersion),
+        mHasZoneMaps(false),
         mHasEvaluatedFileStats(false),
         mFileStatsEvalResult(true),
+        mStripeStatsResult(TruthValue::YES_NO_NULL),
         mMetrics(metrics) {
-    const SearchArgumentImpl* sargs = dynamic_cast<const SearchArgumentImpl*>(mSearchArgument);
-
     // find the mapping from predicate leaves to columns
-    const std::vector<PredicateLeaf>& leaves = sargs->getLeaves();
-    mFilterColumns.resize(leaves.size(), INVALID_COLUMN_ID);
+    mFilterColumns.resize(mLeaves.size(), INVALID_COLUMN_ID);
     for (size_t i = 0; i != mFilterColumns.size(); ++i) {
-      if (leaves[i].hasColumnName()) {
-        mFilterColumns[i] = findColumn(type, leaves[i].getColumnName());
+      if (mLeaves[i].hasColumnName()) {
+        mFilterColumns[i] = findColumn(type, mLeaves[i].getColumnName());
+      } else {
+        mFilterColumns[i] = mLeaves[i].getColumnId();
+      }
+    }
+    mLeafEvaluators.reserve(mLeaves.size());
+    mLeafValues.resize(mLeaves.size(), TruthValue::YES_NO_NULL);
+    mPageLeafValues.resize(mLeaves.size(), TruthValue::YES_NO_NULL);
+  }
+
+  void SargsApplier::compileLeafEvaluators(
+      const std::unordered_map<uint64_t, proto::RowIndex>& rowIndexes,
+      const std::map<uint32_t, BloomFilterIndex>& bloomFilters,
+      const std::unordered_map<uint64_t, proto::RowIndex>& zoneMaps, uint64_t pagesInStripe) {
+    mLeafEvaluators.clear();
+    mHasZoneMaps = false;
+    for (size_t pred = 0; pred != mLeaves.size(); ++pred) {
+      // leaves that are not compiled keep this value for every row group
+      mLeafValues[pred] = TruthValue::YES_NO_NULL;
+
+      uint64_t columnIdx = mFilterColumns[pred];
+      if (columnIdx == INVALID_COLUMN_ID) {
+        // this column does not exist in current file
+        continue;
+      }
+      auto rowIndexIter = rowIndexes.find(columnIdx);
+      if (rowIndexIter == rowIndexes.cend()) {
+        continue;
+      }
+      if (mSchemaEvolution && !mSchemaEvolution->isSafePPDConversion(columnIdx)) {
+        // cannot evaluate predicate when ppd is not safe
+        continue;
+      }
+
+      const BloomFilterIndex* bloomFilter = nullptr;
+      auto bfIter = bloomFilters.find(static_cast<uint32_t>(columnIdx));
+      if (bfIter != bloomFilters.cend()) {
+        bloomFilter = &bfIter->second;
+      }
+      // a zone map is only usable if it has an entry for every page
+      const proto::RowIndex* zoneMap = nullptr;
+      auto zoneMapIter = zoneMaps.find(columnIdx);
+      if (pagesInStripe != 0 && zoneMapIter != zoneMaps.cend() &&
+          static_cast<uint64_t>(zoneMapIter->second.entry_size()) == pagesInStripe) {
+        zoneMap = &zoneMapIter->second;
+        mHasZoneMaps = true;
+      }
+      mLeafEvaluators.push_back(
+          {pred, &mLeaves[pred], &rowIndexIter->second, bloomFilter, zoneMap});
+    }
+  }
+
+  // The set of outcomes {YES, NO, NULL} allowed by a TruthValue.
+  static uint8_t toOutcomes(TruthValue value) {
+    switch (value) {
+      case TruthValue::YES:
+        return 1;
+      case TruthValue::NO:
+        return 2;
+      case TruthValue::IS_NULL:
+        return 4;
+      case TruthValue::YES_NULL:
+        return 1 | 4;
+      case TruthValue::NO_NULL:
+        return 2 | 4;
+      case TruthValue::YES_NO:
+        return 1 | 2;
+      case TruthValue::YES_NO_NULL:
+      default:
+        return 1 | 2 | 4;
+    }
+  }
+
+  /**
+   * Combine the values of a leaf evaluated on a row group and on one of its
+   * pages. Both are valid for the rows of the page, so only the outcomes
+   * allowed by both of them remain possible.
+   */
+  static TruthValue intersect(TruthValue rowGroupValue, TruthValue pageValue) {
+    switch (toOutcomes(rowGroupValue) & toOutcomes(pageValue)) {
+      case 1:
+        return TruthValue::YES;
+      case 2:
+        return TruthValue::NO;
+      case 4:
+        return TruthValue::IS_NULL;
+      case 1 | 4:
+        return TruthValue::YES_NULL;
+      case 2 | 4:
+        return TruthValue::NO_NULL;
+      case 1 | 2:
+        return TruthValue::YES_NO;
+      case 1 | 2 | 4:
+        return TruthValue::YES_NO_NULL;
+      default:
+        // inconsistent statistics, trust the finer-grained one
+        return pageValue;
+    }
+  }
+
+  bool SargsApplier::pickPages(uint64_t rowGroup, uint64_t rowsInStripe,
+                               uint64_t& nextSkippedRow) {
+    uint64_t firstPage = rowGroup * mRowIndexStride / mSkipStride;
+    uint64_t endPage =
+        (std::min(rowsInStripe, (rowGroup + 1) * mRowIndexStride) + mSkipStride - 1) / mSkipStride;
+    bool hasSelectedPage = false;
+    for (uint64_t page = endPage; page-- != firstPage;) {
+      mPageLeafValues = mLeafValues;
+      for (const LeafEvaluator& evaluator : mLeafEvaluators) {
+        if (evaluator.zoneMap != nullptr) {
+          const proto::ColumnStatistics& statistics =
+              evaluator.zoneMap->entry(static_cast<int>(page)).statistics();
+          mPageLeafValues[evaluator.leafIndex] =
+              intersect(mLeafValues[evaluator.leafIndex],
+                        evaluator.leaf->evaluate(mWriterVersion, statistics, nullptr));
+        }
+      }
+
+      if (isNeeded(mSearchArgument->evaluate(mPageLeafValues))) {
+        mNextSkippedRows[page] = nextSkippedRow;
+        hasSelectedPage = true;
       } else {
-        mFilterColumns[i] = leaves[i].getColumnId();
+        mNextSkippedRows[page] = 0;
+        nextSkippedRow = page * mSkipStride;
       }
     }
+    return hasSelectedPage;
   }
 
   bool SargsApplier::pickRowGroups(uint64_t rowsInStripe,
                                    const std::unordered_map<uint64_t, proto::RowIndex>& rowIndexes,
-                                   const std::map<uint32_t, BloomFilterIndex>& bloomFilters) {
+                                   const std::map<uint32_t, BloomFilterIndex>& bloomFilters,
+                                   const std::unordered_map<uint64_t, proto::RowIndex>& zoneMaps,
+                                   uint64_t zoneMapGranularity) {
     // init state of each row group
     uint64_t groupsInStripe = (rowsInStripe + mRowIndexStride - 1) / mRowIndexStride;
+    mSkipStride = mRowIndexStride;
     mNextSkippedRows.resize(groupsInStripe);
     mTotalRowsInStripe = rowsInStripe;
 
+    // reuse the min/max evaluation of needsBloomFilters() for this stripe
+    std::vector<bool> minMaxSelected;
+    minMaxSelected.swap(mMinMaxSelected);
+    bool hasMinMax = minMaxSelected.size() == groupsInStripe;
+
     // row indexes do not exist, simply read all rows
     if (rowIndexes.empty()) {
       return true;
     }
 
-    const auto& leaves = dynamic_cast<const SearchArgumentImpl*>(mSearchArgument)->getLeaves();
-    std::vector<TruthValue> leafValues(leaves.size(), TruthValue::YES_NO_NULL);
+    // zone map pages must not span row groups
+    bool useZoneMaps = !zoneMaps.empty() && zoneMapGranularity != 0 &&
+                       mRowIndexStride % zoneMapGranularity == 0;
+    uint64_t pagesInStripe =
+        useZoneMaps ? (rowsInStripe + zoneMapGranularity - 1) / zoneMapGranularity : 0;
+    compileLeafEvaluators(rowIndexes, bloomFilters, zoneMaps, pagesInStripe);
+    if (mHasZoneMaps) {
+      mSkipStride = zoneMapGranularity;
+      mNextSkippedRows.resize(pagesInStripe);
+    }
+
     mHasSelected = false;
     mHasSkipped = false;
-    uint64_t nextSkippedRowGroup = groupsInStripe;
+    uint64_t selectedRGs = 0;
+    uint64_t nextSkippedRow = rowsInStripe;
     size_t rowGroup = groupsInStripe;
     do {
       --rowGroup;
-      for (size_t pred = 0; pred != leaves.size(); ++pred) {
-        uint64_t columnIdx = mFilterColumns[pred];
-        auto rowIndexIter = rowIndexes.find(columnIdx);
-        if (columnIdx == INVALID_COLUMN_ID || rowIndexIter == rowIndexes.cend()) {
-          // this column does not exist in current file
-          leafValues[pred] = TruthValue::YES_NO_NULL;
-        } else if (mSchemaEvolution && !mSchemaEvolution->isSafePPDConversion(columnIdx)) {
-          // cannot evaluate predicate when ppd is not safe
-          leafValues[pred] = TruthValue::YES_NO_NULL;
-        } else {
-          // get column statistics
+      bool needed = false;
+      if (!hasMinMax) {
+        for (const LeafEvaluator& evaluator : mLeafEvaluators) {
           const proto::ColumnStatistics& statistics =
-              rowIndexIter->second.entry(static_cast<int>(rowGroup)).statistics();
-
-          // get bloom filter
-          std::shared_ptr<BloomFilter> bloomFilter;
-          auto iter = bloomFilters.find(static_cast<uint32_t>(columnIdx));
-          if (iter != bloomFilters.cend()) {
-            bloomFilter = iter->second.entries.at(rowGroup);
+              evaluator.rowIndex->entry(static_cast<int>(rowGroup)).statistics();
+          const BloomFilter* bloomFilter = evaluator.bloomFilter != nullptr
+                                               ? evaluator.bloomFilter->entries.at(rowGroup).get()
+                                               : nullptr;
+          mLeafValues[evaluator.leafIndex] =
+              evaluator.leaf->evaluate(mWriterVersion, statistics, bloomFilter);
+        }
+        needed = isNeeded(mSearchArgument->evaluate(mLeafValues));
+      } else if (minMaxSelected[rowGroup]) {
+        // bloom filters can only reject row groups selected by min/max
+        std::copy_n(mMinMaxLeafValues.begin() + static_cast<int64_t>(rowGroup * mLeaves.size()),
+                    mLeaves.size(), mLeafValues.begin());
+        bool hasBloomFilter = false;
+        for (const LeafEvaluator& evaluator : mLeafEvaluators) {
+          if (evaluator.bloomFilter != nullptr) {
+            mLeafValues[evaluator.leafIndex] = evaluator.leaf->evaluate(
+                mWriterVersion, evaluator.rowIndex->entry(static_cast<int>(rowGroup)).statistics(),
+                evaluator.bloomFilter->entries.at(rowGroup).get());
+            hasBloomFilter = true;
           }
-
-          leafValues[pred] = leaves[pred].evaluate(mWriterVersion, statistics, bloomFilter.get());
         }
+        needed = !hasBloomFilter || isNeeded(mSearchArgument->evaluate(mLeafValues));
       }
-
-      bool needed = isNeeded(mSearchArgument->evaluate(leafValues));
-      if (!needed) {
+      if (needed && mHasZoneMaps) {
+        needed = pickPages(rowGroup, rowsInStripe, nextSkippedRow);
+        mHasSkipped |= nextSkippedRow != rowsInStripe;
+      } else if (mHasZoneMaps) {
+        nextSkippedRow = rowGroup * mRowIndexStride;
+        uint64_t firstPage = nextSkippedRow / mSkipStride;
+        uint64_t endPage = (std::min(rowsInStripe, (rowGroup + 1) * mRowIndexStride) +
+                            mSkipStride - 1) /
+                           mSkipStride;
+        std::fill(mNextSkippedRows.begin() + static_cast<int64_t>(firstPage),
+                  mNextSkippedRows.begin() + static_cast<int64_t>(endPage), 0);
+      } else if (!needed) {
         mNextSkippedRows[rowGroup] = 0;
-        nextSkippedRowGroup = rowGroup;
+        nextSkippedRow = rowGroup * mRowIndexStride;
       } else {
-        mNextSkippedRows[rowGroup] = (nextSkippedRowGroup == groupsInStripe)
-                                         ? rowsInStripe
-                                         : (nextSkippedRowGroup * mRowIndexStride);
+        mNextSkippedRows[rowGroup] = nextSkippedRow;
+      }
+      if (needed) {
+        ++selectedRGs;
       }
       mHasSelected |= needed;
       mHasSkipped |= !needed;
     } while (rowGroup != 0);
 
     // update stats
-    uint64_t selectedRGs = std::accumulate(
-        mNextSkippedRows.cbegin(), mNextSkippedRows.cend(), 0UL,
-        [](uint64_t initVal, uint64_t rg) { return rg > 0 ? initVal + 1 : initVal; });
     if (mMetrics != nullptr) {
       mMetrics->SelectedRowGroupCount.fetch_add(selectedRGs);
       mMetrics->EvaluatedRowGroupCount.fetch_add(groupsInStripe);
@@ -133,33 +293,38 @@ namespace orc {
     return mHasSelected;
   }
 
-  bool SargsApplier::evaluateColumnStatistics(const PbColumnStatistics& colStats) const {
-    const SearchArgumentImpl* sargs = dynamic_cast<const SearchArgumentImpl*>(mSearchArgument);
-    if (sargs == nullptr) {
-      throw InvalidArgument("Failed to cast to SearchArgumentImpl");
-    }
+  TruthValue SargsApplier::evaluateColumnStatistics(
+      const PbColumnStatistics& colStats,
+      const std::unordered_map<uint64_t, const BloomFilter*>* bloomFilters) const {
+    std::vector<TruthValue> leafValues(mLeaves.size(), TruthValue::YES_NO_NULL);
 
-    const std::vector<PredicateLeaf>& leaves = sargs->getLeaves();
-    std::vector<TruthValue> leafValues(leaves.size(), TruthValue::YES_NO_NULL);
-
-    for (size_t pred = 0; pred != leaves.size(); ++pred) {
+    for (size_t pred = 0; pred != mLeaves.size(); ++pred) {
       uint64_t columnId = mFilterColumns[pred];
       if (columnId != INVALID_COLUMN_ID && colStats.size() > static_cast<int>(columnId)) {
-        leafValues[pred] = leaves[pred].evaluate(mWriterVersion,
-                                                 colStats.Get(static_cast<int>(columnId)), nullptr);
+        const BloomFilter* bloomFilter = nullptr;
+        if (bloomFilters != nullptr) {
+          auto bfIter = bloomFilters->find(columnId);
+          if (bfIter != bloomFilters->cend()) {
+            bloomFilter = bfIter->second;
+          }
+        }
+        leafValues[pred] = mLeaves[pred].evaluate(
+            mWriterVersion, colStats.Get(static_cast<int>(columnId)), bloomFilter);
       }
     }
 
-    return isNeeded(mSearchArgument->evaluate(leafValues));
+    return mSearchArgument->evaluate(leafValues);
   }
 
   bool SargsApplier::evaluateStripeStatistics(const proto::StripeStatistics& stripeStats,
                                               uint64_t stripeRowGroupCount) {
     if (stripeStats.col_stats_size() == 0) {
+      mStripeStatsResult = TruthValue::YES_NO_NULL;
       return true;
     }
 
-    bool ret = evaluateColumnStatistics(stripeStats.col_stats());
+    mStripeStatsResult = evaluateColumnStatistics(stripeStats.col_stats());
+    bool ret = isNeeded(mStripeStatsResult);
     if (!ret) {
       // reset mNextSkippedRows when the current stripe does not satisfy the PPD
       mNextSkippedRows.clear();
@@ -170,13 +335,108 @@ namespace orc {
     return ret;
   }
 
+  void SargsApplier::selectAllRowGroups(uint64_t rowsInStripe) {
+    uint64_t groupsInStripe = (rowsInStripe + mRowIndexStride - 1) / mRowIndexStride;
+    mSkipStride = mRowIndexStride;
+    mNextSkippedRows.assign(groupsInStripe, rowsInStripe);
+    mTotalRowsInStripe = rowsInStripe;
+    mHasSelected = groupsInStripe != 0;
+    mHasSkipped = false;
+    if (mMetrics != nullptr) {
+      mMetrics->SelectedRowGroupCount.fetch_add(groupsInStripe);
+      mMetrics->EvaluatedRowGroupCount.fetch_add(groupsInStripe);
+    }
+  }
+
+  bool SargsApplier::canEvaluateLeaf(size_t pred) const {
+    uint64_t columnId = mFilterColumns[pred];
+    return columnId != INVALID_COLUMN_ID &&
+           (mSchemaEvolution == nullptr || mSchemaEvolution->isSafePPDConversion(columnId));
+  }
+
+  bool SargsApplier::needsBloomFilter(uint64_t columnId) const {
+    for (size_t pred = 0; pred != mLeaves.size(); ++pred) {
+      PredicateLeaf::Operator op = mLeaves[pred].getOperator();
+      if (mFilterColumns[pred] == columnId && canEvaluateLeaf(pred) &&
+          (op == PredicateLeaf::Operator::EQUALS ||
+           op == PredicateLeaf::Operator::NULL_SAFE_EQUALS ||
+           op == PredicateLeaf::Operator::IN)) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  bool SargsApplier::needsZoneMap(uint64_t columnId) const {
+    for (size_t pred = 0; pred != mLeaves.size(); ++pred) {
+      if (mFilterColumns[pred] == columnId && canEvaluateLeaf(pred)) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  bool SargsApplier::needsBloomFilters(
+      uint64_t rowsInStripe, const std::unordered_map<uint64_t, proto::RowIndex>& rowIndexes) {
+    mMinMaxSelected.clear();
+    bool anyBloomFilterLeaf = false;
+    std::vector<std::pair<size_t, const proto::RowIndex*>> leafIndexes;
+    for (size_t pred = 0; pred != mLeaves.size(); ++pred) {
+      if (!canEvaluateLeaf(pred)) {
+        continue;
+      }
+      anyBloomFilterLeaf |= needsBloomFilter(mFilterColumns[pred]);
+      auto rowIndexIter = rowIndexes.find(mFilterColumns[pred]);
+      if (rowIndexIter != rowIndexes.cend()) {
+        leafIndexes.emplace_back(pred, &rowIndexIter->second);
+      }
+    }
+    if (!anyBloomFilterLeaf) {
+      return false;
+    }
+
+    // same evaluation as pickRowGroups() without the bloom filters, the
+    // result is reused by pickRowGroups()
+    uint64_t groupsInStripe = (rowsInStripe + mRowIndexStride - 1) / mRowIndexStride;
+    mMinMaxLeafValues.resize(groupsInStripe * mLeaves.size());
+    mMinMaxSelected.resize(groupsInStripe);
+    std::fill(mLeafValues.begin(), mLeafValues.end(), TruthValue::YES_NO_NULL);
+    bool anySelected = false;
+    for (uint64_t rowGroup = 0; rowGroup != groupsInStripe; ++rowGroup) {
+      for (const auto& leafIndex : leafIndexes) {
+        const proto::RowIndex& rowIndex = *leafIndex.second;
+        if (static_cast<uint64_t>(rowIndex.entry_size()) <= rowGroup) {
+          // malformed row index, let pickRowGroups() report it
+          mMinMaxSelected.clear();
+          return true;
+        }
+        mLeafValues[leafIndex.first] = mLeaves[leafIndex.first].evaluate(
+            mWriterVersion, rowIndex.entry(static_cast<int>(rowGroup)).statistics(), nullptr);
+      }
+      mMinMaxSelected[rowGroup] = isNeeded(mSearchArgument->evaluate(mLeafValues));
+      anySelected |= mMinMaxSelected[rowGroup];
+      std::copy(mLeafValues.begin(), mLeafValues.end(),
+                mMinMaxLeafValues.begin() + static_cast<int64_t>(rowGroup * mLeaves.size()));
+    }
+    return anySelected;
+  }
+
+  bool SargsApplier::evaluateStripeSummary(
+      const proto::StripeStatistics& stripeStats,
+      const std::unordered_map<uint64_t, const BloomFilter*>& bloomFilters) const {
+    if (stripeStats.col_stats_size() == 0) {
+      return true;
+    }
+    return isNeeded(evaluateColumnStatistics(stripeStats.col_stats(), &bloomFilters));
+  }
+
   bool SargsApplier::evaluateFileStatistics(const proto::Footer& footer,
                                             uint64_t numRowGroupsInStripeRange) {
     if (!mHasEvaluatedFileStats) {
       if (footer.statistics_size() == 0) {
         mFileStatsEvalResult = true;
       } else {
-        mFileStatsEvalResult = evaluateColumnStatistics(footer.statistics());
+        mFileStatsEvalResult = isNeeded(evaluateColumnStatistics(footer.statistics()));
         if (!mFileStatsEvalResult && mMetrics != nullptr) {
           mMetrics->EvaluatedRowGroupCount.fetch_add(numRowGroupsInStripeRange);
         }
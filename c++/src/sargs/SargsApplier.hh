@@ -60,24 +60,85 @@ namespace orc {
     bool evaluateStripeStatistics(const proto::StripeStatistics& stripeStats,
                                   uint64_t stripeRowGroupCount);
 
+    /**
+     * Whether the last evaluateStripeStatistics() proved that every row of
+     * the stripe matches the search argument. Row indexes and bloom filters
+     * of such a stripe cannot skip anything.
+     */
+    bool isStripeFullyMatched() const {
+      return mStripeStatsResult == TruthValue::YES;
+    }
+
+    /**
+     * Select all row groups of the current stripe without evaluating its
+     * row indexes. Used when isStripeFullyMatched() is true.
+     */
+    void selectAllRowGroups(uint64_t rowsInStripe);
+
+    /**
+     * Whether a bloom filter of the column can change the evaluation of a
+     * predicate leaf, i.e. the column has an EQUALS, NULL_SAFE_EQUALS or IN
+     * leaf that can be safely pushed down.
+     */
+    bool needsBloomFilter(uint64_t columnId) const;
+
+    /**
+     * Whether the zone map of the column can be used, i.e. the column has a
+     * predicate leaf that can be safely pushed down.
+     */
+    bool needsZoneMap(uint64_t columnId) const;
+
+    /**
+     * Whether the bloom filters of the current stripe are worth reading: some
+     * leaf can use them and the min/max statistics of the row indexes leave
+     * at least one row group to be checked against them. The min/max values
+     * of the leaves are kept for the next pickRowGroups() of the same stripe.
+     */
+    bool needsBloomFilters(uint64_t rowsInStripe,
+                           const std::unordered_map<uint64_t, proto::RowIndex>& rowIndexes);
+
+    /**
+     * Evaluate search argument on stripe statistics together with the bloom
+     * filters of one of its row groups. Unlike evaluateStripeStatistics(),
+     * neither the selected row groups nor Reader Metrics are updated.
+     * @param bloomFilters the bloom filter of each column, keyed by column id
+     * @return true if stripe statistics and bloom filters satisfy the sargs
+     */
+    bool evaluateStripeSummary(
+        const proto::StripeStatistics& stripeStats,
+        const std::unordered_map<uint64_t, const BloomFilter*>& bloomFilters) const;
+
     /**
      * TODO: use proto::RowIndex and proto::BloomFilter to do the evaluation
      * Pick the row groups that we need to load from the current stripe.
+     * If zone maps are provided, the selected row groups are further split
+     * into pages of zoneMapGranularity rows that are picked individually.
      * @return true if any row group is selected
      */
     bool pickRowGroups(uint64_t rowsInStripe,
                        const std::unordered_map<uint64_t, proto::RowIndex>& rowIndexes,
-                       const std::map<uint32_t, BloomFilterIndex>& bloomFilters);
+                       const std::map<uint32_t, BloomFilterIndex>& bloomFilters,
+                       const std::unordered_map<uint64_t, proto::RowIndex>& zoneMaps = {},
+                       uint64_t zoneMapGranularity = 0);
 
     /**
-     * Return a vector of the next skipped row for each RowGroup. Each value is the row id
-     * in stripe. 0 means the current RowGroup is entirely skipped.
+     * Return a vector of the next skipped row for each RowGroup, or for each
+     * zone map page if pages were picked. Each value is the row id in stripe.
+     * 0 means the current RowGroup or page is entirely skipped.
      * Only valid after invoking pickRowGroups().
      */
     const std::vector<uint64_t>& getNextSkippedRows() const {
       return mNextSkippedRows;
     }
 
+    /**
+     * Return the number of rows covered by each entry of getNextSkippedRows(),
+     * i.e. the row index stride or the zone map granularity.
+     */
+    uint64_t getSkipStride() const {
+      return mSkipStride;
+    }
+
     /**
      * Indicate whether any row group is selected in the last evaluation
      */
@@ -96,7 +157,7 @@ namespace orc {
      * Whether any row group from current row in the stripe matches PPD.
      */
     bool hasSelectedFrom(uint64_t currentRowInStripe) const {
-      uint64_t rg = currentRowInStripe / mRowIndexStride;
+      uint64_t rg = currentRowInStripe / mSkipStride;
       for (; rg < mNextSkippedRows.size(); ++rg) {
         if (mNextSkippedRows[rg]) {
           return true;
@@ -117,7 +178,42 @@ namespace orc {
    private:
     // evaluate column statistics in the form of protobuf::RepeatedPtrField
     typedef ::google::protobuf::RepeatedPtrField<proto::ColumnStatistics> PbColumnStatistics;
-    bool evaluateColumnStatistics(const PbColumnStatistics& colStats) const;
+    TruthValue evaluateColumnStatistics(
+        const PbColumnStatistics& colStats,
+        const std::unordered_map<uint64_t, const BloomFilter*>* bloomFilters = nullptr) const;
+
+    // whether the predicate leaf can be evaluated against the column statistics
+    bool canEvaluateLeaf(size_t pred) const;
+
+    /**
+     * A predicate leaf bound to the row index and bloom filter of its column
+     * in the current stripe.
+     */
+    struct LeafEvaluator {
+      size_t leafIndex;
+      const PredicateLeaf* leaf;
+      const proto::RowIndex* rowIndex;
+      const BloomFilterIndex* bloomFilter;
+      // nullptr if the column has no usable zone map in the current stripe
+      const proto::RowIndex* zoneMap;
+    };
+
+    /**
+     * Resolve the predicate leaves against the row indexes and bloom filters
+     * of the current stripe. Leaves that cannot be evaluated are left out and
+     * their value in mLeafValues is fixed to YES_NO_NULL.
+     */
+    void compileLeafEvaluators(const std::unordered_map<uint64_t, proto::RowIndex>& rowIndexes,
+                               const std::map<uint32_t, BloomFilterIndex>& bloomFilters,
+                               const std::unordered_map<uint64_t, proto::RowIndex>& zoneMaps,
+                               uint64_t pagesInStripe);
+
+    /**
+     * Pick the zone map pages of a selected row group whose leaf values are
+     * in mLeafValues, updating mNextSkippedRows from the last page backwards.
+     * @return true if any page is selected
+     */
+    bool pickPages(uint64_t rowGroup, uint64_t rowsInStripe, uint64_t& nextSkippedRow);
 
     friend class TestSargsApplier_findColumnTest_Test;
     friend class TestSargsApplier_findArrayColumnTest_Test;
@@ -127,11 +223,23 @@ namespace orc {
    private:
     const Type& mType;
     const SearchArgument* mSearchArgument;
+    const std::vector<PredicateLeaf>& mLeaves;
     const SchemaEvolution* mSchemaEvolution;
     uint64_t mRowIndexStride;
+    // number of rows per entry of mNextSkippedRows
+    uint64_t mSkipStride;
     WriterVersion mWriterVersion;
     // column ids for each predicate leaf in the search argument
     std::vector<uint64_t> mFilterColumns;
+    // per-stripe evaluators and the leaf values they fill in, reused across stripes
+    std::vector<LeafEvaluator> mLeafEvaluators;
+    std::vector<TruthValue> mLeafValues;
+    std::vector<TruthValue> mPageLeafValues;
+    bool mHasZoneMaps;
+    // leaf values of each row group evaluated by needsBloomFilters() on min/max
+    // statistics only, and whether they select the row group
+    std::vector<TruthValue> mMinMaxLeafValues;
+    std::vector<bool> mMinMaxSelected;
 
     // Map from RowGroup index to the next skipped row of the selected range it
     // locates. If the RowGroup is not selected, set the value to 0.
@@ -143,6 +251,8 @@ namespace orc {
     // store result of file stats evaluation
     bool mHasEvaluatedFileStats;
     bool mFileStatsEvalResult;
+    // result of the last stripe stats evaluation
+    TruthValue mStripeStatsResult;
     // use the SelectedRowGroupCount and EvaluatedRowGroupCount to
     // keep stats of selected RGs and evaluated RGs
     ReaderMetrics* mMetrics;
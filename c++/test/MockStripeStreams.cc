@@ -35,6 +35,10 @@ namespace orc {
     return getTimezoneByName("GMT");
   }
 
+  std::shared_ptr<StringDictionary>* MockStripeStreams::getSharedDictionary(uint64_t) const {
+    return nullptr;
+  }
+
   std::unique_ptr<SeekableInputStream> MockStripeStreams::getStream(uint64_t columnId,
                                                                     proto::Stream_Kind kind,
                                                                     bool stream) const {
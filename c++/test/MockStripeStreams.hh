@@ -42,6 +42,8 @@ namespace orc {
     MOCK_CONST_METHOD0(isDecimalAsLong, bool());
     MOCK_CONST_METHOD0(getSchemaEvolution, const SchemaEvolution*());
 
+    std::shared_ptr<StringDictionary>* getSharedDictionary(uint64_t columnId) const override;
+
     MemoryPool& getMemoryPool() const override;
 
     ReaderMetrics* getReaderMetrics() const override;
@@ -0,0 +1,302 @@
+/**
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "MemoryInputStream.hh"
+#include "MemoryOutputStream.hh"
+#include "orc/ArrowExport.hh"
+#include "orc/OrcFile.hh"
+#include "wrap/gtest-wrapper.h"
+
+#include <cstring>
+#include <limits>
+#include <string>
+
+namespace orc {
+
+  static bool isValid(const ArrowArray& array, uint64_t i) {
+    const auto* bitmap = static_cast<const uint8_t*>(array.buffers[0]);
+    return bitmap == nullptr || (bitmap[i / 8] >> (i % 8)) & 1;
+  }
+
+  static std::string getString(const ArrowArray& array, uint64_t i) {
+    const auto* offsets = static_cast<const int64_t*>(array.buffers[1]);
+    const auto* data = static_cast<const char*>(array.buffers[2]);
+    return std::string(data + offsets[i], static_cast<size_t>(offsets[i + 1] - offsets[i]));
+  }
+
+  TEST(TestArrowExport, schema) {
+    std::unique_ptr<Type> type(Type::buildTypeFromString(
+        "struct<a:boolean,b:tinyint,c:smallint,d:int,e:bigint,f:float,g:double,h:string,"
+        "i:binary,j:timestamp,k:timestamp with local time zone,l:date,m:decimal(10,2),"
+        "n:array<int>,o:map<string,double>,p:uniontype<int,string>,q:varchar(4)>"));
+    ArrowSchema schema;
+    exportArrowSchema(*type, &schema);
+    EXPECT_STREQ("+s", schema.format);
+    ASSERT_EQ(17, schema.n_children);
+    const char* formats[] = {"b", "c", "s", "i", "l", "f", "g", "U", "Z", "tsn:", "tsn:UTC",
+                             "tdD", "d:10,2", "+L", "+m", "+ud:0,1", "U"};
+    for (int64_t i = 0; i < schema.n_children; ++i) {
+      EXPECT_STREQ(formats[i], schema.children[i]->format);
+      EXPECT_EQ(type->getFieldName(static_cast<uint64_t>(i)), schema.children[i]->name);
+      EXPECT_EQ(ARROW_FLAG_NULLABLE, schema.children[i]->flags);
+    }
+    ArrowSchema* map = schema.children[14];
+    ASSERT_EQ(1, map->n_children);
+    EXPECT_STREQ("+s", map->children[0]->format);
+    EXPECT_STREQ("key", map->children[0]->children[0]->name);
+    EXPECT_EQ(0, map->children[0]->children[0]->flags);
+    schema.release(&schema);
+    EXPECT_EQ(nullptr, schema.release);
+
+    exportArrowSchema(*type, &schema, true);
+    EXPECT_STREQ("i", schema.children[7]->format);
+    ASSERT_NE(nullptr, schema.children[7]->dictionary);
+    EXPECT_STREQ("U", schema.children[7]->dictionary->format);
+    EXPECT_STREQ("Z", schema.children[8]->format);
+    schema.release(&schema);
+  }
+
+  TEST(TestArrowExport, primitives) {
+    std::unique_ptr<Type> type(Type::buildTypeFromString(
+        "struct<a:boolean,b:int,c:string,d:double,e:timestamp,f:decimal(20,2),g:date>"));
+    auto batch = type->createRowBatch(10, *getDefaultPool());
+    auto& structBatch = dynamic_cast<StructVectorBatch&>(*batch);
+    auto& bools = dynamic_cast<LongVectorBatch&>(*structBatch.fields[0]);
+    auto& ints = dynamic_cast<LongVectorBatch&>(*structBatch.fields[1]);
+    auto& strings = dynamic_cast<StringVectorBatch&>(*structBatch.fields[2]);
+    auto& doubles = dynamic_cast<DoubleVectorBatch&>(*structBatch.fields[3]);
+    auto& timestamps = dynamic_cast<TimestampVectorBatch&>(*structBatch.fields[4]);
+    auto& decimals = dynamic_cast<Decimal128VectorBatch&>(*structBatch.fields[5]);
+    auto& dates = dynamic_cast<LongVectorBatch&>(*structBatch.fields[6]);
+
+    std::vector<std::string> values(10);
+    for (uint64_t i = 0; i < 10; ++i) {
+      bools.data[i] = i % 3 == 0;
+      ints.data[i] = static_cast<int64_t>(i) - 5;
+      values[i] = std::string(i, 'x');
+      strings.data[i] = const_cast<char*>(values[i].c_str());
+      strings.length[i] = static_cast<int64_t>(i);
+      strings.notNull[i] = i % 4 != 1;
+      doubles.data[i] = static_cast<double>(i) / 2;
+      timestamps.data[i] = static_cast<int64_t>(i);
+      timestamps.nanoseconds[i] = 7;
+      decimals.values[i] = Int128(-static_cast<int64_t>(i));
+      dates.data[i] = static_cast<int64_t>(i) * 100;
+    }
+    strings.hasNulls = true;
+    structBatch.numElements = 10;
+    for (auto* field : structBatch.fields) {
+      field->numElements = 10;
+    }
+
+    ArrowArray array;
+    exportArrowArray(*type, *batch, &array);
+    EXPECT_EQ(10, array.length);
+    EXPECT_EQ(0, array.null_count);
+    ASSERT_EQ(7, array.n_children);
+
+    const auto* boolBits = static_cast<const uint8_t*>(array.children[0]->buffers[1]);
+    const auto* intValues = static_cast<const int32_t*>(array.children[1]->buffers[1]);
+    const ArrowArray& stringArray = *array.children[2];
+    const auto* doubleValues = static_cast<const double*>(array.children[3]->buffers[1]);
+    const auto* timestampValues = static_cast<const int64_t*>(array.children[4]->buffers[1]);
+    const auto* decimalValues = static_cast<const uint64_t*>(array.children[5]->buffers[1]);
+    const auto* dateValues = static_cast<const int32_t*>(array.children[6]->buffers[1]);
+    EXPECT_EQ(3, stringArray.null_count);
+    for (uint64_t i = 0; i < 10; ++i) {
+      EXPECT_EQ(i % 3 == 0, ((boolBits[i / 8] >> (i % 8)) & 1) == 1);
+      EXPECT_EQ(static_cast<int32_t>(i) - 5, intValues[i]);
+      EXPECT_EQ(i % 4 != 1, isValid(stringArray, i));
+      EXPECT_EQ(i % 4 != 1 ? values[i] : "", getString(stringArray, i));
+      EXPECT_EQ(static_cast<double>(i) / 2, doubleValues[i]);
+      EXPECT_EQ(static_cast<int64_t>(i) * 1000000000 + 7, timestampValues[i]);
+      EXPECT_EQ(static_cast<uint64_t>(-static_cast<int64_t>(i)), decimalValues[2 * i]);
+      EXPECT_EQ(i == 0 ? 0 : ~0ULL, decimalValues[2 * i + 1]);
+      EXPECT_EQ(static_cast<int32_t>(i) * 100, dateValues[i]);
+    }
+
+    // the array does not reference the batch
+    batch.reset();
+    EXPECT_EQ("xxxxxxxx", getString(*array.children[2], 8));
+
+    // a consumer may move a child out and release it separately
+    ArrowArray child = *array.children[1];
+    array.children[1]->release = nullptr;
+    array.release(&array);
+    EXPECT_EQ(nullptr, array.release);
+    EXPECT_EQ(-5, static_cast<const int32_t*>(child.buffers[1])[0]);
+    child.release(&child);
+  }
+
+  TEST(TestArrowExport, nested) {
+    std::unique_ptr<Type> type(
+        Type::buildTypeFromString("struct<a:array<bigint>,b:map<string,int>>"));
+    auto batch = type->createRowBatch(4, *getDefaultPool());
+    auto& structBatch = dynamic_cast<StructVectorBatch&>(*batch);
+    auto& lists = dynamic_cast<ListVectorBatch&>(*structBatch.fields[0]);
+    auto& elements = dynamic_cast<LongVectorBatch&>(*lists.elements);
+    auto& maps = dynamic_cast<MapVectorBatch&>(*structBatch.fields[1]);
+    auto& keys = dynamic_cast<StringVectorBatch&>(*maps.keys);
+    auto& mapValues = dynamic_cast<LongVectorBatch&>(*maps.elements);
+
+    // [[0], null, [1, 2], []] and {"k0":0} {} {"k1":1,"k2":2} {}
+    int64_t offsets[] = {0, 1, 1, 3, 3};
+    std::string keyStrings[] = {"k0", "k1", "k2"};
+    elements.resize(3);
+    keys.resize(3);
+    mapValues.resize(3);
+    for (uint64_t i = 0; i < 5; ++i) {
+      lists.offsets[i] = maps.offsets[i] = offsets[i];
+    }
+    for (uint64_t i = 0; i < 3; ++i) {
+      elements.data[i] = static_cast<int64_t>(i);
+      mapValues.data[i] = static_cast<int64_t>(i);
+      keys.data[i] = const_cast<char*>(keyStrings[i].c_str());
+      keys.length[i] = 2;
+    }
+    lists.notNull[1] = 0;
+    lists.hasNulls = true;
+    elements.numElements = keys.numElements = mapValues.numElements = 3;
+    structBatch.numElements = lists.numElements = maps.numElements = 4;
+
+    ArrowArray array;
+    exportArrowArray(*type, *batch, &array);
+    const ArrowArray& listArray = *array.children[0];
+    EXPECT_EQ(1, listArray.null_count);
+    EXPECT_FALSE(isValid(listArray, 1));
+    const auto* listOffsets = static_cast<const int64_t*>(listArray.buffers[1]);
+    for (uint64_t i = 0; i < 5; ++i) {
+      EXPECT_EQ(offsets[i], listOffsets[i]);
+    }
+    EXPECT_EQ(3, listArray.children[0]->length);
+    EXPECT_EQ(2, static_cast<const int64_t*>(listArray.children[0]->buffers[1])[2]);
+
+    const ArrowArray& mapArray = *array.children[1];
+    const auto* mapOffsets = static_cast<const int32_t*>(mapArray.buffers[1]);
+    EXPECT_EQ(3, mapOffsets[3]);
+    const ArrowArray& entries = *mapArray.children[0];
+    EXPECT_EQ(3, entries.length);
+    EXPECT_EQ("k1", getString(*entries.children[0], 1));
+    EXPECT_EQ(2, static_cast<const int32_t*>(entries.children[1]->buffers[1])[2]);
+    array.release(&array);
+  }
+
+  TEST(TestArrowExport, outOfRange) {
+    std::unique_ptr<Type> type(Type::buildTypeFromString("timestamp"));
+    auto batch = type->createRowBatch(2, *getDefaultPool());
+    auto& timestamps = dynamic_cast<TimestampVectorBatch&>(*batch);
+    // 2262-04-11 23:47:16.854775807 is the last nanosecond timestamp
+    timestamps.data[0] = 9223372036;
+    timestamps.nanoseconds[0] = 854775807;
+    timestamps.data[1] = -9223372037;
+    timestamps.nanoseconds[1] = 145224192;
+    timestamps.numElements = 2;
+    ArrowArray array;
+    exportArrowArray(*type, *batch, &array);
+    const auto* values = static_cast<const int64_t*>(array.buffers[1]);
+    EXPECT_EQ(std::numeric_limits<int64_t>::max(), values[0]);
+    EXPECT_EQ(std::numeric_limits<int64_t>::min(), values[1]);
+    array.release(&array);
+    timestamps.nanoseconds[0] = 854775808;
+    EXPECT_THROW(exportArrowArray(*type, *batch, &array), InvalidArgument);
+    EXPECT_EQ(nullptr, array.release);
+    timestamps.data[0] = 9223372037;
+    timestamps.nanoseconds[0] = 0;
+    EXPECT_THROW(exportArrowArray(*type, *batch, &array), InvalidArgument);
+    // null values are not checked
+    timestamps.notNull[0] = 0;
+    timestamps.hasNulls = true;
+    exportArrowArray(*type, *batch, &array);
+    EXPECT_EQ(1, array.null_count);
+    array.release(&array);
+
+    // maps and unions have 32-bit offsets
+    type = Type::buildTypeFromString("map<int,int>");
+    batch = type->createRowBatch(1, *getDefaultPool());
+    auto& maps = dynamic_cast<MapVectorBatch&>(*batch);
+    maps.offsets[0] = 0;
+    maps.offsets[1] = int64_t(1) << 31;
+    maps.numElements = 1;
+    EXPECT_THROW(exportArrowArray(*type, *batch, &array), InvalidArgument);
+    EXPECT_EQ(nullptr, array.release);
+
+    type = Type::buildTypeFromString("uniontype<int,string>");
+    batch = type->createRowBatch(1, *getDefaultPool());
+    auto& unions = dynamic_cast<UnionVectorBatch&>(*batch);
+    unions.tags[0] = 0;
+    unions.offsets[0] = uint64_t(1) << 31;
+    unions.numElements = 1;
+    EXPECT_THROW(exportArrowArray(*type, *batch, &array), InvalidArgument);
+    EXPECT_EQ(nullptr, array.release);
+  }
+
+  TEST(TestArrowExport, readDictionaries) {
+    MemoryOutputStream memStream(10 * 1024 * 1024);
+    std::unique_ptr<Type> type(Type::buildTypeFromString("struct<a:string>"));
+    {
+      WriterOptions options;
+      options.setDictionaryKeySizeThreshold(1.0);
+      auto writer = createWriter(*type, &memStream, options);
+      auto batch = writer->createRowBatch(1000);
+      auto& structBatch = dynamic_cast<StructVectorBatch&>(*batch);
+      auto& strings = dynamic_cast<StringVectorBatch&>(*structBatch.fields[0]);
+      std::string values[] = {"red", "green", "blue"};
+      for (uint64_t i = 0; i < 1000; ++i) {
+        strings.data[i] = const_cast<char*>(values[i % 3].c_str());
+        strings.length[i] = static_cast<int64_t>(values[i % 3].size());
+      }
+      structBatch.numElements = strings.numElements = 1000;
+      writer->add(*batch);
+      writer->close();
+    }
+
+    for (bool dictionaryStrings : {false, true}) {
+      auto inStream =
+          std::make_unique<MemoryInputStream>(memStream.getData(), memStream.getLength());
+      auto reader = createReader(std::move(inStream), ReaderOptions());
+      RowReaderOptions rowReaderOptions;
+      rowReaderOptions.setEnableLazyDecoding(true);
+      auto rowReader = reader->createRowReader(rowReaderOptions);
+      auto batch = rowReader->createRowBatch(400);
+
+      uint64_t rows = 0;
+      ArrowArray array;
+      while (readArrowArray(*rowReader, *batch, &array, dictionaryStrings)) {
+        const ArrowArray& column = *array.children[0];
+        for (uint64_t i = 0; i < static_cast<uint64_t>(column.length); ++i) {
+          std::string expected = (rows + i) % 3 == 0   ? "red"
+                                 : (rows + i) % 3 == 1 ? "green"
+                                                       : "blue";
+          if (dictionaryStrings) {
+            ASSERT_NE(nullptr, column.dictionary);
+            // the dictionary of the stripe is shared, not copied
+            EXPECT_EQ(3, column.dictionary->length);
+            int32_t index = static_cast<const int32_t*>(column.buffers[1])[i];
+            EXPECT_EQ(expected, getString(*column.dictionary, static_cast<uint64_t>(index)));
+          } else {
+            EXPECT_EQ(expected, getString(column, i));
+          }
+        }
+        rows += static_cast<uint64_t>(column.length);
+        array.release(&array);
+      }
+      EXPECT_EQ(1000, rows);
+    }
+  }
+
+}  // namespace orc
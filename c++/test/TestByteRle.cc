@@ -757,6 +757,29 @@ namespace orc {
     }
   }
 
+  TEST(BooleanRle, nextBits) {
+    const unsigned char buffer[] = {0x61, 0xf0, 0xfd, 0x55, 0xAA, 0x55};
+    std::unique_ptr<ByteRleDecoder> bytes = createBooleanRleDecoder(
+        std::make_unique<SeekableArrayInputStream>(buffer, ARRAY_SIZE(buffer)),
+        getDefaultReaderMetrics());
+    std::unique_ptr<ByteRleDecoder> bits = createBooleanRleDecoder(
+        std::make_unique<SeekableArrayInputStream>(buffer, ARRAY_SIZE(buffer)),
+        getDefaultReaderMetrics());
+    // chunks that start and end in the middle of bytes and words
+    for (uint64_t chunk : {3, 61, 64, 70, 129, 5, 200, 292}) {
+      std::vector<char> expected(chunk);
+      bytes->next(expected.data(), chunk, nullptr);
+      std::vector<uint64_t> bitmap((chunk + 63) / 64, ~uint64_t(0));
+      bits->nextBits(bitmap.data(), chunk);
+      for (uint64_t i = 0; i < chunk; ++i) {
+        EXPECT_EQ(expected[i], (bitmap[i / 64] >> (i % 64)) & 1) << "Output wrong at " << i;
+      }
+      if (chunk % 64 != 0) {
+        EXPECT_EQ(0, bitmap.back() >> (chunk % 64)) << "Bits after the values are set";
+      }
+    }
+  }
+
   TEST(BooleanRle, runsTest) {
     const unsigned char buffer[] = {0xf7, 0xff, 0x80, 0x3f, 0xe0, 0x0f, 0xf8, 0x03, 0xfe, 0x00};
     std::unique_ptr<ByteRleDecoder> rle = createBooleanRleDecoder(
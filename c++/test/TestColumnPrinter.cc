@@ -355,6 +355,40 @@ namespace orc {
     }
   }
 
+  TEST(TestColumnPrinter, OffsetStringColumnPrinter) {
+    std::string line;
+    std::unique_ptr<Type> stringType = createPrimitiveType(STRING);
+    std::unique_ptr<Type> binaryType = createPrimitiveType(BINARY);
+    std::unique_ptr<ColumnPrinter> stringPrinter = createColumnPrinter(line, stringType.get());
+    std::unique_ptr<ColumnPrinter> binaryPrinter = createColumnPrinter(line, binaryType.get());
+    OffsetStringVectorBatch batch(1024, *getDefaultPool());
+    const std::string blob = "thisisatest";
+    batch.numElements = 4;
+    batch.hasNulls = true;
+    batch.blob.resize(blob.size());
+    memcpy(batch.blob.data(), blob.data(), blob.size());
+    const int64_t offsets[] = {0, 4, 6, 6, 11};
+    for (size_t i = 0; i < 5; ++i) {
+      batch.offsets[i] = offsets[i];
+    }
+    for (size_t i = 0; i < batch.numElements; ++i) {
+      batch.notNull[i] = i != 2;
+    }
+    const char* expectedStrings[] = {"\"this\"", "\"is\"", "null", "\"atest\""};
+    const char* expectedBinaries[] = {"[116, 104, 105, 115]", "[105, 115]", "null",
+                                      "[97, 116, 101, 115, 116]"};
+    stringPrinter->reset(batch);
+    binaryPrinter->reset(batch);
+    for (uint64_t i = 0; i < batch.numElements; ++i) {
+      line.clear();
+      stringPrinter->printRow(i);
+      EXPECT_EQ(expectedStrings[i], line) << "for i = " << i;
+      line.clear();
+      binaryPrinter->printRow(i);
+      EXPECT_EQ(expectedBinaries[i], line) << "for i = " << i;
+    }
+  }
+
   TEST(TestColumnPrinter, BinaryColumnPrinter) {
     std::string line;
     std::unique_ptr<Type> type = createPrimitiveType(BINARY);
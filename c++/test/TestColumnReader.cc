@@ -2436,6 +2436,73 @@ namespace orc {
     }
   }
 
+  // Reads 100 rows with every third row null from a DATA stream whose 7 byte
+  // chunks split most values between two chunks.
+  template <typename BatchType, typename ValueType, typename FileValueType>
+  void testFloatingAcrossChunks(TypeKind kind, bool useTightNumericVector) {
+    MockStripeStreams streams;
+    std::vector<bool> selectedColumns(2, true);
+    EXPECT_CALL(streams, getSelectedColumns()).WillRepeatedly(testing::Return(selectedColumns));
+    proto::ColumnEncoding directEncoding;
+    directEncoding.set_kind(proto::ColumnEncoding_Kind_DIRECT);
+    EXPECT_CALL(streams, getEncoding(testing::_)).WillRepeatedly(testing::Return(directEncoding));
+    EXPECT_CALL(streams, getStreamProxy(0, proto::Stream_Kind_PRESENT, true))
+        .WillRepeatedly(testing::Return(nullptr));
+
+    const uint64_t numRows = 100;
+    std::vector<char> present(1 + (numRows + 7) / 8, 0);
+    // a literal run of the bytes of the bitmap
+    present[0] = static_cast<char>(-static_cast<int>(present.size() - 1));
+    std::vector<char> data;
+    for (uint64_t row = 0; row < numRows; ++row) {
+      if (row % 3 != 0) {
+        present[1 + row / 8] = static_cast<char>(present[1 + row / 8] | (0x80 >> (row % 8)));
+        FileValueType value = static_cast<FileValueType>(row) * 1.5f;
+        const char* bytes = reinterpret_cast<const char*>(&value);
+        data.insert(data.end(), bytes, bytes + sizeof(value));
+      }
+    }
+    EXPECT_CALL(streams, getStreamProxy(1, proto::Stream_Kind_PRESENT, true))
+        .WillRepeatedly(
+            testing::Return(new SeekableArrayInputStream(present.data(), present.size())));
+    EXPECT_CALL(streams, getStreamProxy(1, proto::Stream_Kind_DATA, true))
+        .WillRepeatedly(
+            testing::Return(new SeekableArrayInputStream(data.data(), data.size(), 7)));
+
+    std::unique_ptr<Type> rowType = createStructType();
+    rowType->addStructField("col0", createPrimitiveType(kind));
+    std::unique_ptr<ColumnReader> reader = buildReader(*rowType, streams, useTightNumericVector);
+
+    BatchType* valueBatch = new BatchType(1024, *getDefaultPool());
+    StructVectorBatch batch(1024, *getDefaultPool());
+    batch.fields.push_back(valueBatch);
+    // the first batch ends in the middle of a chunk
+    reader->next(batch, 40, nullptr);
+    for (uint64_t row = 0; row < 40; ++row) {
+      ASSERT_EQ(row % 3 != 0, valueBatch->notNull[row]) << row;
+      if (row % 3 != 0) {
+        EXPECT_EQ(static_cast<ValueType>(static_cast<FileValueType>(row) * 1.5f),
+                  valueBatch->data[row])
+            << row;
+      }
+    }
+    reader->next(batch, 60, nullptr);
+    for (uint64_t row = 40; row < numRows; ++row) {
+      ASSERT_EQ(row % 3 != 0, valueBatch->notNull[row - 40]) << row;
+      if (row % 3 != 0) {
+        EXPECT_EQ(static_cast<ValueType>(static_cast<FileValueType>(row) * 1.5f),
+                  valueBatch->data[row - 40])
+            << row;
+      }
+    }
+  }
+
+  TEST(TestColumnReader, testFloatingAcrossChunksWithNulls) {
+    testFloatingAcrossChunks<FloatVectorBatch, float, float>(FLOAT, true);
+    testFloatingAcrossChunks<DoubleVectorBatch, double, float>(FLOAT, false);
+    testFloatingAcrossChunks<DoubleVectorBatch, double, double>(DOUBLE, true);
+  }
+
   TEST(TestColumnReader, testTimestampSkipWithNulls) {
     MockStripeStreams streams;
 
@@ -2811,6 +2878,82 @@ namespace orc {
     EXPECT_EQ(32, decimals->values.data()[63].toLong());
   }
 
+  // append the zigzag encoded varint of a value
+  static void appendZigZagVarint(std::vector<char>& buffer, const Int128& value) {
+    Int128 zigzag = value.abs();
+    zigzag <<= 1;
+    if (value < 0) {
+      zigzag -= 1;
+    }
+    uint64_t low = zigzag.getLowBits();
+    uint64_t high = static_cast<uint64_t>(zigzag.getHighBits());
+    while (high != 0 || low > 0x7f) {
+      buffer.push_back(static_cast<char>(0x80 | (low & 0x7f)));
+      low = (low >> 7) | (high << 57);
+      high >>= 7;
+    }
+    buffer.push_back(static_cast<char>(low));
+  }
+
+  TEST(DecimalColumnReader, testDecimal128Rescale) {
+    MockStripeStreams streams;
+
+    // set getSelectedColumns()
+    std::vector<bool> selectedColumns(2, true);
+    EXPECT_CALL(streams, getSelectedColumns()).WillRepeatedly(testing::Return(selectedColumns));
+
+    // set getEncoding
+    proto::ColumnEncoding directEncoding;
+    directEncoding.set_kind(proto::ColumnEncoding_Kind_DIRECT);
+    EXPECT_CALL(streams, getEncoding(testing::_)).WillRepeatedly(testing::Return(directEncoding));
+
+    // set getStream
+    EXPECT_CALL(streams, getStreamProxy(testing::_, proto::Stream_Kind_PRESENT, true))
+        .WillRepeatedly(testing::Return(nullptr));
+
+    // the values written with their scales and as read with scale 2
+    const Int128 maximum("99999999999999999999999999999999999999");
+    const Int128 minimum("-99999999999999999999999999999999999999");
+    const Int128 large("-100000000000000000000000000000000007");
+    std::vector<Int128> written = {123, 5, -5, 12345, -12345};
+    written.insert(written.end(),
+                   {Int128("1000000000000000000000000000000"), maximum, minimum, 7, large});
+    std::vector<int64_t> scales = {2, 0, 0, 4, 4, 22, 2, 2, 1, 2};
+    std::vector<Int128> expected = {123, 500, -500, 123, -123};
+    expected.insert(expected.end(), {10000000000, maximum, minimum, 70, large});
+
+    std::vector<char> data;
+    for (const auto& value : written) {
+      appendZigZagVarint(data, value);
+    }
+    EXPECT_CALL(streams, getStreamProxy(1, proto::Stream_Kind_DATA, true))
+        .WillRepeatedly(testing::Return(new SeekableArrayInputStream(data.data(), data.size(), 5)));
+
+    // a literal run of the scales
+    std::vector<char> scaleData = {static_cast<char>(-static_cast<int>(scales.size()))};
+    for (int64_t scale : scales) {
+      appendZigZagVarint(scaleData, scale);
+    }
+    EXPECT_CALL(streams, getStreamProxy(1, proto::Stream_Kind_SECONDARY, true))
+        .WillRepeatedly(
+            testing::Return(new SeekableArrayInputStream(scaleData.data(), scaleData.size())));
+
+    // create the row type
+    std::unique_ptr<Type> rowType = createStructType();
+    rowType->addStructField("col0", createDecimalType(38, 2));
+
+    std::unique_ptr<ColumnReader> reader = buildReader(*rowType, streams);
+
+    StructVectorBatch batch(64, *getDefaultPool());
+    Decimal128VectorBatch* decimals = new Decimal128VectorBatch(64, *getDefaultPool());
+    batch.fields.push_back(decimals);
+    reader->next(batch, expected.size(), 0);
+    EXPECT_EQ(expected.size(), decimals->numElements);
+    for (size_t i = 0; i < expected.size(); ++i) {
+      EXPECT_EQ(expected[i], decimals->values[i]) << i;
+    }
+  }
+
   TEST(DecimalColumnReader, testDecimal128Skip) {
     MockStripeStreams streams;
 
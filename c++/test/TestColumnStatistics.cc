@@ -531,4 +531,173 @@ namespace orc {
     collectionStats->merge(*other);
     EXPECT_FALSE(collectionStats->hasTotalChildren());
   }
+
+  TEST(ColumnStatistics, intColumnStatisticsBatch) {
+    const int64_t max = std::numeric_limits<int64_t>::max();
+    const int64_t min = std::numeric_limits<int64_t>::min();
+    std::vector<std::vector<int64_t>> batches = {
+        {5, -3, 7, 0}, {max - 10, 11, -11}, {max, 1, -1}, {min, -1, 1}, {min / 2, min / 2, -1}};
+    const char notNull[] = {1, 0, 1, 1};
+    for (const std::vector<int64_t>& values : batches) {
+      for (const char* mask : {static_cast<const char*>(nullptr), notNull}) {
+        for (int64_t start : {int64_t(0), int64_t(100), max - 5, min + 5}) {
+          IntegerColumnStatisticsImpl expected;
+          IntegerColumnStatisticsImpl actual;
+          expected.setSum(start);
+          actual.setSum(start);
+          uint64_t numValues = std::min<uint64_t>(values.size(), mask ? 4 : values.size());
+          uint64_t count = 0;
+          for (uint64_t i = 0; i < numValues; ++i) {
+            if (mask == nullptr || mask[i]) {
+              expected.update(values[i], 1);
+              ++count;
+            }
+          }
+          expected.increase(count);
+          if (count < numValues) {
+            expected.setHasNull(true);
+          }
+          actual.updateBatch(values.data(), mask, numValues);
+          EXPECT_EQ(expected.getNumberOfValues(), actual.getNumberOfValues());
+          EXPECT_EQ(expected.hasNull(), actual.hasNull());
+          EXPECT_EQ(expected.getMinimum(), actual.getMinimum());
+          EXPECT_EQ(expected.getMaximum(), actual.getMaximum());
+          ASSERT_EQ(expected.hasSum(), actual.hasSum());
+          if (expected.hasSum()) {
+            EXPECT_EQ(expected.getSum(), actual.getSum());
+          }
+        }
+      }
+    }
+
+    // narrower types are widened
+    IntegerColumnStatisticsImpl byteStats;
+    const char bytes[] = {-128, 127, 3};
+    byteStats.updateBatch(bytes, nullptr, 3);
+    EXPECT_EQ(-128, byteStats.getMinimum());
+    EXPECT_EQ(127, byteStats.getMaximum());
+    EXPECT_EQ(2, byteStats.getSum());
+  }
+
+  TEST(ColumnStatistics, doubleColumnStatisticsBatch) {
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+    std::vector<std::vector<double>> batches = {
+        {1.5, -2.5, 3.0}, {nan, 1.0, 2.0}, {1.0, nan, -1.0}};
+    for (const std::vector<double>& values : batches) {
+      DoubleColumnStatisticsImpl expected;
+      DoubleColumnStatisticsImpl actual;
+      for (double value : values) {
+        expected.update(value);
+      }
+      expected.increase(values.size());
+      actual.updateBatch(values.data(), nullptr, values.size());
+      EXPECT_EQ(expected.getNumberOfValues(), actual.getNumberOfValues());
+      EXPECT_EQ(std::isnan(expected.getMinimum()), std::isnan(actual.getMinimum()));
+      if (!std::isnan(expected.getMinimum())) {
+        EXPECT_EQ(expected.getMinimum(), actual.getMinimum());
+        EXPECT_EQ(expected.getMaximum(), actual.getMaximum());
+      }
+    }
+
+    // leading nulls are skipped and counted
+    DoubleColumnStatisticsImpl stats;
+    const float floats[] = {9.0f, 2.0f, 4.0f};
+    const char notNull[] = {0, 1, 1};
+    stats.updateBatch(floats, notNull, 3);
+    EXPECT_EQ(2, stats.getNumberOfValues());
+    EXPECT_TRUE(stats.hasNull());
+    EXPECT_EQ(2.0, stats.getMinimum());
+    EXPECT_EQ(4.0, stats.getMaximum());
+    EXPECT_EQ(6.0, stats.getSum());
+  }
+
+  TEST(ColumnStatistics, stringColumnStatisticsBatch) {
+    std::string values[] = {"bcd", "bc", "a", "zz", "bcde"};
+    char* data[5];
+    int64_t lengths[5];
+    for (size_t i = 0; i < 5; ++i) {
+      data[i] = const_cast<char*>(values[i].c_str());
+      lengths[i] = static_cast<int64_t>(values[i].size());
+    }
+    const char notNull[] = {1, 1, 0, 0, 1};
+
+    StringColumnStatisticsImpl stats;
+    stats.updateBatch(data, lengths, notNull, 5);
+    EXPECT_EQ(3, stats.getNumberOfValues());
+    EXPECT_TRUE(stats.hasNull());
+    EXPECT_EQ("bc", stats.getMinimum());
+    EXPECT_EQ("bcde", stats.getMaximum());
+    EXPECT_EQ(9, stats.getTotalLength());
+
+    stats.updateBatch(data, lengths, nullptr, 5);
+    EXPECT_EQ(8, stats.getNumberOfValues());
+    EXPECT_EQ("a", stats.getMinimum());
+    EXPECT_EQ("zz", stats.getMaximum());
+    EXPECT_EQ(21, stats.getTotalLength());
+  }
+
+  TEST(ColumnStatistics, stringColumnStatisticsTruncated) {
+    EXPECT_EQ("abc", StringColumnStatisticsImpl::truncateLowerBound("abcdef", 6, 3));
+    // \xc3\xa9 is a two byte character that is not split
+    EXPECT_EQ("ab", StringColumnStatisticsImpl::truncateLowerBound("ab\xc3\xa9z", 5, 3));
+    std::string bound;
+    EXPECT_TRUE(StringColumnStatisticsImpl::truncateUpperBound("abcdef", 6, 3, bound));
+    EXPECT_EQ("abd", bound);
+    EXPECT_TRUE(StringColumnStatisticsImpl::truncateUpperBound("ab\xc3\xa9z", 5, 3, bound));
+    EXPECT_EQ("ac", bound);
+    EXPECT_TRUE(StringColumnStatisticsImpl::truncateUpperBound("a\xc3\xbfz", 4, 3, bound));
+    EXPECT_EQ("a\xc4\x80", bound);
+    // the largest code point cannot be incremented, so the one before it is
+    EXPECT_TRUE(StringColumnStatisticsImpl::truncateUpperBound("a\xf4\x8f\xbf\xbfz", 6, 5, bound));
+    EXPECT_EQ("b", bound);
+    EXPECT_FALSE(StringColumnStatisticsImpl::truncateUpperBound("\xf4\x8f\xbf\xbfz", 5, 4, bound));
+
+    StringColumnStatisticsImpl stats(4);
+    stats.update("abcdefgh", 8);
+    stats.increase(1);
+    EXPECT_FALSE(stats.hasMinimum());
+    EXPECT_FALSE(stats.hasMaximum());
+    EXPECT_EQ("abcd", stats.getLowerBound());
+    EXPECT_EQ("abce", stats.getUpperBound());
+    EXPECT_THROW(stats.getMinimum(), ParseError);
+
+    // a shorter value replaces the bounds with exact values
+    stats.update("aa", 2);
+    stats.update("b", 1);
+    stats.increase(2);
+    EXPECT_EQ("aa", stats.getMinimum());
+    EXPECT_EQ("b", stats.getMaximum());
+    EXPECT_EQ(11, stats.getTotalLength());
+
+    stats.update("bbbbbb", 6);
+    stats.increase(1);
+    EXPECT_EQ("aa", stats.getMinimum());
+    EXPECT_FALSE(stats.hasMaximum());
+    EXPECT_EQ("bbbc", stats.getUpperBound());
+
+    proto::ColumnStatistics pbStats;
+    stats.toProtoBuf(pbStats);
+    EXPECT_EQ("aa", pbStats.string_statistics().minimum());
+    EXPECT_FALSE(pbStats.string_statistics().has_lower_bound());
+    EXPECT_FALSE(pbStats.string_statistics().has_maximum());
+    EXPECT_EQ("bbbc", pbStats.string_statistics().upper_bound());
+    StringColumnStatisticsImpl read(pbStats, StatContext(true));
+    EXPECT_EQ("aa", read.getMinimum());
+    EXPECT_EQ("aa", read.getLowerBound());
+    EXPECT_FALSE(read.hasMaximum());
+    EXPECT_EQ("bbbc", read.getUpperBound());
+
+    // merging takes the flag of the winning bound
+    StringColumnStatisticsImpl other(4);
+    other.update("bbbc", 4);
+    other.update("a", 1);
+    stats.merge(other);
+    EXPECT_EQ("a", stats.getMinimum());
+    EXPECT_EQ("bbbc", stats.getMaximum());
+    other.reset();
+    other.update("zzzzzz", 6);
+    stats.merge(other);
+    EXPECT_FALSE(stats.hasMaximum());
+    EXPECT_EQ("zzz{", stats.getUpperBound());
+  }
 }  // namespace orc
@@ -27,6 +27,9 @@
 #include "MemoryInputStream.hh"
 #include "MemoryOutputStream.hh"
 
+#include <cmath>
+#include <limits>
+
 namespace orc {
 
   using BooleanVectorBatch = ByteVectorBatch;
@@ -358,6 +361,106 @@ namespace orc {
     }
   }
 
+  // Test conversion from string/char/varchar to numeric, where invalid or out of range values
+  // become null, or throw if throwOnSchemaEvolutionOverflow is set
+  TEST(ConvertColumnReader, TestConvertStringVariantToNumeric) {
+    constexpr int DEFAULT_MEM_STREAM_SIZE = 10 * 1024 * 1024;
+    MemoryOutputStream memStream(DEFAULT_MEM_STREAM_SIZE);
+    std::unique_ptr<Type> fileType(Type::buildTypeFromString(
+        "struct<t1:string,t2:string,t3:string,t4:char(24),t5:varchar(24),t6:varchar(24)>"));
+    std::shared_ptr<Type> readType(Type::buildTypeFromString(
+        "struct<t1:bigint,t2:tinyint,t3:double,t4:int,t5:float,t6:boolean>"));
+    WriterOptions options;
+    auto writer = createWriter(*fileType, &memStream, options);
+    auto batch = writer->createRowBatch(6);
+    auto& structBatch = dynamic_cast<StructVectorBatch&>(*batch);
+
+    const std::vector<std::vector<std::string>> values = {
+        {"9223372036854775807", "-42", "+7", "9223372036854775808", "12a", ""},
+        {"127", "-128", "128", " 1", "0", "null"},
+        {"1.5", "-2.25e10", "inf", "1e400", "1.5.", "123"},
+        {"2147483647", "-12", "2147483648", "abc", "+-1", "0"},
+        {"3.25", "-0.5", "1e39", "nan", "7", "x"},
+        {"1", "0", "-3", "true", "", "10"}};
+    for (size_t col = 0; col < values.size(); ++col) {
+      auto& strBatch = dynamic_cast<StringVectorBatch&>(*structBatch.fields[col]);
+      for (size_t row = 0; row < values[col].size(); ++row) {
+        strBatch.data[row] = const_cast<char*>(values[col][row].c_str());
+        strBatch.length[row] = static_cast<int64_t>(values[col][row].size());
+      }
+      strBatch.numElements = values[col].size();
+    }
+    // the last row of the first column is null
+    auto& c0 = dynamic_cast<StringVectorBatch&>(*structBatch.fields[0]);
+    c0.notNull[5] = false;
+    c0.hasNulls = true;
+    structBatch.numElements = 6;
+    writer->add(*batch);
+    writer->close();
+
+    auto inStream = std::make_unique<MemoryInputStream>(memStream.getData(), memStream.getLength());
+    auto pool = getDefaultPool();
+    auto reader = createReader(*pool, std::move(inStream));
+    RowReaderOptions rowReaderOpts;
+    rowReaderOpts.setReadType(readType);
+    rowReaderOpts.setUseTightNumericVector(true);
+    auto rowReader = reader->createRowReader(rowReaderOpts);
+    auto readBatch = rowReader->createRowBatch(6);
+    EXPECT_EQ(true, rowReader->next(*readBatch));
+    auto& readStructBatch = dynamic_cast<StructVectorBatch&>(*readBatch);
+
+    auto& readC0 = dynamic_cast<LongVectorBatch&>(*readStructBatch.fields[0]);
+    EXPECT_EQ(std::vector<char>({1, 1, 1, 0, 0, 0}),
+              std::vector<char>(readC0.notNull.data(), readC0.notNull.data() + 6));
+    EXPECT_EQ(9223372036854775807L, readC0.data[0]);
+    EXPECT_EQ(-42, readC0.data[1]);
+    EXPECT_EQ(7, readC0.data[2]);
+
+    auto& readC1 = dynamic_cast<ByteVectorBatch&>(*readStructBatch.fields[1]);
+    EXPECT_EQ(std::vector<char>({1, 1, 0, 0, 1, 0}),
+              std::vector<char>(readC1.notNull.data(), readC1.notNull.data() + 6));
+    EXPECT_EQ(127, readC1.data[0]);
+    EXPECT_EQ(-128, readC1.data[1]);
+    EXPECT_EQ(0, readC1.data[4]);
+
+    auto& readC2 = dynamic_cast<DoubleVectorBatch&>(*readStructBatch.fields[2]);
+    EXPECT_EQ(std::vector<char>({1, 1, 1, 0, 0, 1}),
+              std::vector<char>(readC2.notNull.data(), readC2.notNull.data() + 6));
+    EXPECT_EQ(1.5, readC2.data[0]);
+    EXPECT_EQ(-2.25e10, readC2.data[1]);
+    EXPECT_EQ(std::numeric_limits<double>::infinity(), readC2.data[2]);
+    EXPECT_EQ(123, readC2.data[5]);
+
+    // the values of a char column are padded with spaces
+    auto& readC3 = dynamic_cast<IntVectorBatch&>(*readStructBatch.fields[3]);
+    EXPECT_EQ(std::vector<char>({1, 1, 0, 0, 0, 1}),
+              std::vector<char>(readC3.notNull.data(), readC3.notNull.data() + 6));
+    EXPECT_EQ(2147483647, readC3.data[0]);
+    EXPECT_EQ(-12, readC3.data[1]);
+    EXPECT_EQ(0, readC3.data[5]);
+
+    auto& readC4 = dynamic_cast<FloatVectorBatch&>(*readStructBatch.fields[4]);
+    EXPECT_EQ(std::vector<char>({1, 1, 0, 1, 1, 0}),
+              std::vector<char>(readC4.notNull.data(), readC4.notNull.data() + 6));
+    EXPECT_EQ(3.25f, readC4.data[0]);
+    EXPECT_EQ(-0.5f, readC4.data[1]);
+    EXPECT_TRUE(std::isnan(readC4.data[3]));
+    EXPECT_EQ(7.0f, readC4.data[4]);
+
+    auto& readC5 = dynamic_cast<BooleanVectorBatch&>(*readStructBatch.fields[5]);
+    EXPECT_EQ(std::vector<char>({1, 1, 1, 0, 0, 1}),
+              std::vector<char>(readC5.notNull.data(), readC5.notNull.data() + 6));
+    EXPECT_EQ(1, readC5.data[0]);
+    EXPECT_EQ(0, readC5.data[1]);
+    EXPECT_EQ(1, readC5.data[2]);
+    EXPECT_EQ(1, readC5.data[5]);
+
+    rowReaderOpts.throwOnSchemaEvolutionOverflow(true);
+    rowReader = reader->createRowReader(rowReaderOpts);
+    readBatch = rowReader->createRowBatch(6);
+    EXPECT_THROW(rowReader->next(*readBatch), SchemaEvolutionError);
+  }
+
   // Test conversion from numeric to decimal64/decimal128
   TEST(ConvertColumnReader, TestConvertNumericToDecimal) {
     constexpr int DEFAULT_MEM_STREAM_SIZE = 10 * 1024 * 1024;
@@ -672,4 +775,188 @@ namespace orc {
     }
   }
 
+  TEST(ConvertColumnReader, TestWidenDecimals) {
+    constexpr int DEFAULT_MEM_STREAM_SIZE = 10 * 1024 * 1024;
+    constexpr int TEST_CASES = 1024;
+    MemoryOutputStream memStream(DEFAULT_MEM_STREAM_SIZE);
+    std::unique_ptr<Type> fileType(Type::buildTypeFromString(
+        "struct<c1:decimal(10,4),c2:decimal(10,4),c3:decimal(10,4),c4:decimal(20,4),"
+        "c5:decimal(20,4)>"));
+    std::shared_ptr<Type> readType(Type::buildTypeFromString(
+        "struct<c1:decimal(12,4),c2:decimal(16,6),c3:decimal(25,4),c4:decimal(30,4),"
+        "c5:decimal(38,10)>"));
+    WriterOptions options;
+    options.setUseTightNumericVector(true);
+    auto writer = createWriter(*fileType, &memStream, options);
+    auto batch = writer->createRowBatch(TEST_CASES);
+    auto structBatch = dynamic_cast<StructVectorBatch*>(batch.get());
+    auto& c1 = dynamic_cast<Decimal64VectorBatch&>(*structBatch->fields[0]);
+    auto& c2 = dynamic_cast<Decimal64VectorBatch&>(*structBatch->fields[1]);
+    auto& c3 = dynamic_cast<Decimal64VectorBatch&>(*structBatch->fields[2]);
+    auto& c4 = dynamic_cast<Decimal128VectorBatch&>(*structBatch->fields[3]);
+    auto& c5 = dynamic_cast<Decimal128VectorBatch&>(*structBatch->fields[4]);
+
+    for (int i = 0; i < TEST_CASES; i++) {
+      size_t idx = static_cast<size_t>(i);
+      int64_t value = (i % 2 ? 1 : -1) * (static_cast<int64_t>(i) * 9999991 % 9999999999);
+      bool isNull = i % 7 == 0;
+      for (auto field : structBatch->fields) {
+        field->notNull[idx] = !isNull;
+        field->hasNulls = true;
+      }
+      c1.values[idx] = c2.values[idx] = c3.values[idx] = value;
+      c4.values[idx] = c5.values[idx] = Int128(value) *= Int128("10000000000");
+    }
+    structBatch->numElements = TEST_CASES;
+    for (auto field : structBatch->fields) {
+      field->numElements = TEST_CASES;
+    }
+    writer->add(*batch);
+    writer->close();
+
+    auto inStream = std::make_unique<MemoryInputStream>(memStream.getData(), memStream.getLength());
+    auto pool = getDefaultPool();
+    auto reader = createReader(*pool, std::move(inStream));
+    RowReaderOptions rowReaderOptions;
+    rowReaderOptions.setUseTightNumericVector(true);
+    rowReaderOptions.setReadType(readType);
+    auto rowReader = reader->createRowReader(rowReaderOptions);
+    auto readBatch = rowReader->createRowBatch(TEST_CASES);
+    EXPECT_EQ(true, rowReader->next(*readBatch));
+
+    auto& readStructBatch = dynamic_cast<StructVectorBatch&>(*readBatch);
+    auto& readC1 = dynamic_cast<Decimal64VectorBatch&>(*readStructBatch.fields[0]);
+    auto& readC2 = dynamic_cast<Decimal64VectorBatch&>(*readStructBatch.fields[1]);
+    auto& readC3 = dynamic_cast<Decimal128VectorBatch&>(*readStructBatch.fields[2]);
+    auto& readC4 = dynamic_cast<Decimal128VectorBatch&>(*readStructBatch.fields[3]);
+    auto& readC5 = dynamic_cast<Decimal128VectorBatch&>(*readStructBatch.fields[4]);
+    EXPECT_EQ(TEST_CASES, readBatch->numElements);
+    EXPECT_EQ(12, readC1.precision);
+    EXPECT_EQ(4, readC1.scale);
+    EXPECT_EQ(16, readC2.precision);
+    EXPECT_EQ(6, readC2.scale);
+    EXPECT_EQ(30, readC4.precision);
+    EXPECT_EQ(10, readC5.scale);
+    for (int i = 0; i < TEST_CASES; i++) {
+      size_t idx = static_cast<size_t>(i);
+      int64_t value = (i % 2 ? 1 : -1) * (static_cast<int64_t>(i) * 9999991 % 9999999999);
+      bool isNull = i % 7 == 0;
+      for (auto field : readStructBatch.fields) {
+        EXPECT_EQ(!isNull, field->notNull[idx]) << i;
+      }
+      if (isNull) {
+        continue;
+      }
+      EXPECT_EQ(value, readC1.values[idx]) << i;
+      EXPECT_EQ(value * 100, readC2.values[idx]) << i;
+      EXPECT_EQ(Int128(value), readC3.values[idx]) << i;
+      EXPECT_EQ(Int128(value) *= Int128("10000000000"), readC4.values[idx]) << i;
+      EXPECT_EQ(Int128(value) *= Int128("10000000000000000"), readC5.values[idx]) << i;
+    }
+  }
+
+  // expect the values read through a widening conversion to be the casts of
+  // the values read as the file type, one value at a time
+  template <typename ReadBatch, typename FileBatch>
+  static void expectWidened(const ColumnVectorBatch& readBatch,
+                            const ColumnVectorBatch& fileBatch, uint64_t firstRow) {
+    const auto& read = dynamic_cast<const ReadBatch&>(readBatch);
+    const auto& file = dynamic_cast<const FileBatch&>(fileBatch);
+    using ReadValue = typename std::remove_reference<decltype(read.data[0])>::type;
+    ASSERT_EQ(file.numElements, read.numElements);
+    ASSERT_EQ(file.hasNulls, read.hasNulls);
+    for (uint64_t i = 0; i < read.numElements; ++i) {
+      EXPECT_EQ(file.notNull[i], read.notNull[i]) << "row " << firstRow + i;
+      if (!read.notNull[i]) {
+        continue;
+      }
+      ReadValue expected = static_cast<ReadValue>(file.data[i]);
+      if (std::isnan(static_cast<double>(expected))) {
+        EXPECT_TRUE(std::isnan(static_cast<double>(read.data[i]))) << "row " << firstRow + i;
+      } else {
+        EXPECT_EQ(expected, read.data[i]) << "row " << firstRow + i;
+      }
+    }
+  }
+
+  TEST(ConvertColumnReader, TestWidenNumerics) {
+    constexpr int DEFAULT_MEM_STREAM_SIZE = 10 * 1024 * 1024;
+    constexpr uint64_t TEST_CASES = 2500;
+    MemoryOutputStream memStream(DEFAULT_MEM_STREAM_SIZE);
+    std::unique_ptr<Type> fileType(
+        Type::buildTypeFromString("struct<c1:int,c2:float,c3:smallint,c4:tinyint,c5:int>"));
+    std::shared_ptr<Type> readType(
+        Type::buildTypeFromString("struct<c1:bigint,c2:double,c3:int,c4:double,c5:float>"));
+    WriterOptions options;
+    options.setUseTightNumericVector(true);
+    auto writer = createWriter(*fileType, &memStream, options);
+    auto batch = writer->createRowBatch(TEST_CASES);
+    auto& structBatch = dynamic_cast<StructVectorBatch&>(*batch);
+    auto& c1 = dynamic_cast<IntVectorBatch&>(*structBatch.fields[0]);
+    auto& c2 = dynamic_cast<FloatVectorBatch&>(*structBatch.fields[1]);
+    auto& c3 = dynamic_cast<ShortVectorBatch&>(*structBatch.fields[2]);
+    auto& c4 = dynamic_cast<ByteVectorBatch&>(*structBatch.fields[3]);
+    auto& c5 = dynamic_cast<IntVectorBatch&>(*structBatch.fields[4]);
+    const float specials[] = {std::numeric_limits<float>::infinity(),
+                              -std::numeric_limits<float>::infinity(),
+                              std::numeric_limits<float>::quiet_NaN(),
+                              std::numeric_limits<float>::max(),
+                              std::numeric_limits<float>::denorm_min(), -0.0f};
+    for (uint64_t i = 0; i < TEST_CASES; ++i) {
+      int64_t value = static_cast<int64_t>(i * 2654435761) - (int64_t{1} << 31);
+      c1.data[i] = c5.data[i] = i % 11 == 0 ? std::numeric_limits<int32_t>::min()
+                                             : static_cast<int32_t>(value);
+      c2.data[i] = i % 13 == 0 ? specials[i / 13 % 6] : static_cast<float>(value) / 7;
+      c3.data[i] = static_cast<int16_t>(value);
+      c4.data[i] = static_cast<int8_t>(value);
+      // null runs of varying length, and one column without nulls
+      for (size_t col = 0; col < 4; ++col) {
+        structBatch.fields[col]->notNull[i] = (i + col) % 5 != 0 && i % 97 > 3;
+      }
+      c5.notNull[i] = 1;
+    }
+    structBatch.numElements = TEST_CASES;
+    for (size_t col = 0; col < 5; ++col) {
+      structBatch.fields[col]->numElements = TEST_CASES;
+      structBatch.fields[col]->hasNulls = col < 4;
+    }
+    writer->add(*batch);
+    writer->close();
+
+    auto pool = getDefaultPool();
+    auto reader = createReader(
+        *pool, std::make_unique<MemoryInputStream>(memStream.getData(), memStream.getLength()));
+    // batch sizes that leave partial vectors at the end of each batch
+    for (uint64_t batchSize : {1, 7, 333, 1000}) {
+      RowReaderOptions fileOptions;
+      fileOptions.setUseTightNumericVector(true);
+      RowReaderOptions readOptions;
+      readOptions.setUseTightNumericVector(true);
+      readOptions.setReadType(readType);
+      auto fileRowReader = reader->createRowReader(fileOptions);
+      auto readRowReader = reader->createRowReader(readOptions);
+      auto fileBatch = fileRowReader->createRowBatch(batchSize);
+      auto readBatch = readRowReader->createRowBatch(batchSize);
+      auto& fileStruct = dynamic_cast<StructVectorBatch&>(*fileBatch);
+      auto& readStruct = dynamic_cast<StructVectorBatch&>(*readBatch);
+      uint64_t rows = 0;
+      while (fileRowReader->next(*fileBatch)) {
+        ASSERT_TRUE(readRowReader->next(*readBatch));
+        expectWidened<LongVectorBatch, IntVectorBatch>(*readStruct.fields[0],
+                                                       *fileStruct.fields[0], rows);
+        expectWidened<DoubleVectorBatch, FloatVectorBatch>(*readStruct.fields[1],
+                                                           *fileStruct.fields[1], rows);
+        expectWidened<IntVectorBatch, ShortVectorBatch>(*readStruct.fields[2],
+                                                        *fileStruct.fields[2], rows);
+        expectWidened<DoubleVectorBatch, ByteVectorBatch>(*readStruct.fields[3],
+                                                          *fileStruct.fields[3], rows);
+        expectWidened<FloatVectorBatch, IntVectorBatch>(*readStruct.fields[4],
+                                                        *fileStruct.fields[4], rows);
+        rows += fileBatch->numElements;
+      }
+      EXPECT_FALSE(readRowReader->next(*readBatch));
+      EXPECT_EQ(TEST_CASES, rows);
+    }
+  }
+
 }  // namespace orc
@@ -0,0 +1,118 @@
+/**
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "MemoryInputStream.hh"
+#include "MemoryOutputStream.hh"
+#include "orc/DatasetIndex.hh"
+#include "orc/sargs/SearchArgument.hh"
+#include "wrap/gtest-wrapper.h"
+
+namespace orc {
+
+  static const int DEFAULT_MEM_STREAM_SIZE = 10 * 1024 * 1024;  // 10M
+
+  // Write 3000 rows of "x<i>" for every i = first + 2 * k, with bloom filters.
+  static void writeBloomFilterFile(MemoryOutputStream& memStream, int64_t first) {
+    auto type = std::unique_ptr<Type>(Type::buildTypeFromString("struct<s:string>"));
+    WriterOptions options;
+    options.setStripeSize(1024 * 1024)
+        .setCompression(CompressionKind_ZSTD)
+        .setMemoryPool(getDefaultPool())
+        .setRowIndexStride(1000)
+        .setColumnsUseBloomFilter({1})
+        .setBloomFilterFPP(0.001);
+
+    auto writer = createWriter(*type, &memStream, options);
+    auto batch = writer->createRowBatch(3000);
+    auto& structBatch = dynamic_cast<StructVectorBatch&>(*batch);
+    auto& strBatch = dynamic_cast<StringVectorBatch&>(*structBatch.fields[0]);
+    std::vector<std::string> values(3000);
+    for (size_t i = 0; i < values.size(); ++i) {
+      values[i] = "x" + std::to_string(first + 2 * static_cast<int64_t>(i));
+      strBatch.data[i] = const_cast<char*>(values[i].c_str());
+      strBatch.length[i] = static_cast<int64_t>(values[i].size());
+    }
+    structBatch.numElements = strBatch.numElements = values.size();
+    writer->add(*batch);
+    writer->close();
+  }
+
+  static std::vector<std::pair<uint64_t, uint64_t>> findStripes(const DatasetIndex& index,
+                                                                const std::string& value) {
+    auto sarg = SearchArgumentFactory::newBuilder()
+                    ->equals("s", PredicateDataType::STRING, Literal(value.c_str(), value.size()))
+                    .build();
+    std::vector<std::pair<uint64_t, uint64_t>> result;
+    for (const DatasetStripe& stripe : index.findStripes(*sarg)) {
+      result.emplace_back(stripe.fileIndex, stripe.stripeIndex);
+    }
+    return result;
+  }
+
+  TEST(TestDatasetIndex, testBloomFilters) {
+    MemoryOutputStream evenStream(DEFAULT_MEM_STREAM_SIZE);
+    MemoryOutputStream oddStream(DEFAULT_MEM_STREAM_SIZE);
+    writeBloomFilterFile(evenStream, 0);
+    writeBloomFilterFile(oddStream, 1);
+
+    auto builder = createDatasetIndexBuilder();
+    ReaderOptions readerOptions;
+    for (MemoryOutputStream* stream : {&evenStream, &oddStream}) {
+      auto reader = createReader(
+          std::make_unique<MemoryInputStream>(stream->getData(), stream->getLength()),
+          readerOptions);
+      builder->addFile(stream == &evenStream ? "even.orc" : "odd.orc", *reader);
+    }
+    EXPECT_EQ(2, builder->getNumberOfFiles());
+
+    MemoryOutputStream indexStream(DEFAULT_MEM_STREAM_SIZE);
+    builder->write(indexStream);
+    auto index = readDatasetIndex(
+        std::make_unique<MemoryInputStream>(indexStream.getData(), indexStream.getLength()));
+    ASSERT_EQ(2, index->getNumberOfFiles());
+    EXPECT_EQ("even.orc", index->getFileName(0));
+    EXPECT_EQ("odd.orc", index->getFileName(1));
+
+    // min/max statistics of both files cover the values, so only the bloom
+    // filters can tell the files apart
+    using Stripes = std::vector<std::pair<uint64_t, uint64_t>>;
+    EXPECT_EQ(Stripes({{0, 0}}), findStripes(*index, "x1000"));
+    EXPECT_EQ(Stripes({{1, 0}}), findStripes(*index, "x4001"));
+    EXPECT_EQ(Stripes(), findStripes(*index, "x-1"));
+  }
+
+  TEST(TestDatasetIndex, testMalformedIndex) {
+    std::string data = "ORCIDX";
+    EXPECT_THROW(readDatasetIndex(std::make_unique<MemoryInputStream>(data.data(), data.size())),
+                 ParseError);
+    data = "NOTIDX\x01\x00";
+    EXPECT_THROW(readDatasetIndex(std::make_unique<MemoryInputStream>(data.data(), data.size())),
+                 ParseError);
+    data = std::string("ORCIDX\x02\x00", 8);
+    EXPECT_THROW(readDatasetIndex(std::make_unique<MemoryInputStream>(data.data(), data.size())),
+                 ParseError);
+    data = std::string("ORCIDX\x01\x01\x05", 9);
+    EXPECT_THROW(readDatasetIndex(std::make_unique<MemoryInputStream>(data.data(), data.size())),
+                 ParseError);
+    // a huge number of files is rejected before anything is allocated for them
+    data = std::string("ORCIDX\x01\xff\xff\xff\xff\xff\xff\xff\xff\x7f\x00", 16);
+    EXPECT_THROW(readDatasetIndex(std::make_unique<MemoryInputStream>(data.data(), data.size())),
+                 ParseError);
+  }
+
+}  // namespace orc
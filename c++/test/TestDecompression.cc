@@ -311,6 +311,35 @@ namespace orc {
     }
   }
 
+  TEST_F(TestDecompression, testLazyFileStream) {
+    SCOPED_TRACE("testLazyFileStream");
+    std::unique_ptr<InputStream> file = readLocalFile(simpleFile, getDefaultReaderMetrics());
+    int opened = 0;
+    LazySeekableInputStream stream([&]() -> std::unique_ptr<SeekableInputStream> {
+      ++opened;
+      return std::make_unique<SeekableFileInputStream>(file.get(), 0, 200, *getDefaultPool(), 20);
+    });
+    EXPECT_FALSE(stream.isOpened());
+    EXPECT_EQ(0, stream.ByteCount());
+    EXPECT_EQ(0, opened);
+
+    std::list<uint64_t> offsets(1, 100);
+    PositionProvider posn(offsets);
+    stream.seek(posn);
+    EXPECT_TRUE(stream.isOpened());
+    EXPECT_EQ(1, opened);
+    const void* ptr;
+    int len;
+    EXPECT_TRUE(stream.Next(&ptr, &len));
+    EXPECT_EQ(20, len);
+    checkBytes(static_cast<const char*>(ptr), len, 100);
+    EXPECT_TRUE(stream.Skip(60));
+    EXPECT_TRUE(stream.Next(&ptr, &len));
+    checkBytes(static_cast<const char*>(ptr), len, 180);
+    EXPECT_EQ(200, stream.ByteCount());
+    EXPECT_EQ(1, opened);
+  }
+
   TEST_F(TestDecompression, testCreateNone) {
     std::vector<char> bytes(10);
     for (unsigned int i = 0; i < bytes.size(); ++i) {
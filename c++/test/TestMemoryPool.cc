@@ -0,0 +1,438 @@
+/**
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "MemoryInputStream.hh"
+#include "MemoryOutputStream.hh"
+#include "orc/Int128.hh"
+#include "orc/MemoryPool.hh"
+#include "orc/OrcFile.hh"
+#include "wrap/gtest-wrapper.h"
+
+#include <cstring>
+#include <thread>
+#include <vector>
+
+namespace orc {
+
+  // the block header and size class slack a caching pool allocates on top of
+  // the payload of a block
+  static const uint64_t BLOCK_OVERHEAD = 16 + 64;
+
+  TEST(TestCachingMemoryPool, reuseSizeClasses) {
+    CachingMemoryPoolOptions options;
+    options.minBlockSize = 4096;
+    options.maxBlockSize = 64 * 1024;
+    auto pool = createCachingMemoryPool(options);
+
+    char* first = pool->malloc(1000);
+    memset(first, 1, 1000);
+    pool->free(first);
+    EXPECT_EQ(4096 + BLOCK_OVERHEAD, pool->getCachedBytes());
+
+    // an allocation of the same size class gets the cached block back
+    char* second = pool->malloc(4000);
+    EXPECT_EQ(first, second);
+    EXPECT_EQ(0, pool->getCachedBytes());
+
+    // a larger size class needs a new block
+    char* third = pool->malloc(5000);
+    EXPECT_NE(second, third);
+    pool->free(second);
+    pool->free(third);
+    EXPECT_EQ(4096 + 8192 + 2 * BLOCK_OVERHEAD, pool->getCachedBytes());
+
+    // allocations above maxBlockSize are never cached
+    char* large = pool->malloc(128 * 1024);
+    memset(large, 2, 128 * 1024);
+    pool->free(large);
+    EXPECT_EQ(4096 + 8192 + 2 * BLOCK_OVERHEAD, pool->getCachedBytes());
+
+    pool->free(nullptr);
+    pool->releaseCache();
+    EXPECT_EQ(0, pool->getCachedBytes());
+  }
+
+  TEST(TestCachingMemoryPool, powerOfTwoSizes) {
+    auto pool = createCachingMemoryPool();
+    for (uint64_t size : {4096, 256 * 1024, 1024 * 1024, 2 * 1024 * 1024}) {
+      char* block = pool->malloc(size);
+      memset(block, 4, size);
+      pool->free(block);
+      // the header of the block does not push it into the next size class
+      EXPECT_EQ(size + BLOCK_OVERHEAD, pool->getCachedBytes());
+      pool->releaseCache();
+    }
+  }
+
+  TEST(TestCachingMemoryPool, maxCachedBytes) {
+    CachingMemoryPoolOptions options;
+    options.minBlockSize = 4096;
+    options.maxCachedBytes = 3 * 4096;
+    auto pool = createCachingMemoryPool(options);
+
+    std::vector<char*> blocks;
+    for (int i = 0; i < 4; ++i) {
+      blocks.push_back(pool->malloc(100));
+    }
+    for (char* block : blocks) {
+      pool->free(block);
+    }
+    // the headers count, so only two blocks fit
+    EXPECT_EQ(2 * (4096 + BLOCK_OVERHEAD), pool->getCachedBytes());
+
+    options.maxBlockSize = 1024;
+    EXPECT_THROW(createCachingMemoryPool(options), InvalidArgument);
+  }
+
+  TEST(TestCachingMemoryPool, hugePages) {
+    CachingMemoryPoolOptions options;
+    options.useHugePages = true;
+    auto pool = createCachingMemoryPool(options);
+    uint64_t size = 3 * 1024 * 1024;
+    char* block = pool->malloc(size);
+    memset(block, 3, size);
+    EXPECT_EQ(3, block[size - 1]);
+    pool->free(block);
+    EXPECT_EQ(4 * 1024 * 1024 + BLOCK_OVERHEAD, pool->getCachedBytes());
+  }
+
+  TEST(TestCachingMemoryPool, threads) {
+    auto pool = createCachingMemoryPool();
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+      threads.emplace_back([&pool, t]() {
+        for (uint64_t i = 1; i < 2000; ++i) {
+          uint64_t size = (i * 37) % 20000 + 1;
+          char* block = pool->malloc(size);
+          memset(block, t, size);
+          EXPECT_EQ(t, block[size - 1]);
+          pool->free(block);
+        }
+      });
+    }
+    for (std::thread& thread : threads) {
+      thread.join();
+    }
+    EXPECT_GT(pool->getCachedBytes(), 0);
+    pool->releaseCache();
+    EXPECT_EQ(0, pool->getCachedBytes());
+  }
+
+  TEST(TestCachingMemoryPool, recycleAcrossStripesAndReaders) {
+    MemoryOutputStream memStream(10 * 1024 * 1024);
+    auto type = std::unique_ptr<Type>(Type::buildTypeFromString("struct<a:bigint,b:string>"));
+    WriterOptions options;
+    options.setStripeSize(16 * 1024)
+        .setCompressionBlockSize(1024)
+        .setCompression(CompressionKind_NONE)
+        .setMemoryPool(getDefaultPool());
+    auto writer = createWriter(*type, &memStream, options);
+    auto batch = writer->createRowBatch(1000);
+    auto& structBatch = dynamic_cast<StructVectorBatch&>(*batch);
+    auto& longBatch = dynamic_cast<LongVectorBatch&>(*structBatch.fields[0]);
+    auto& strBatch = dynamic_cast<StringVectorBatch&>(*structBatch.fields[1]);
+    std::vector<std::string> strings(1000);
+    for (int64_t round = 0; round < 20; ++round) {
+      for (uint64_t i = 0; i < 1000; ++i) {
+        longBatch.data[i] = round * 1000 + static_cast<int64_t>(i);
+        strings[i] = std::to_string(longBatch.data[i]);
+        strBatch.data[i] = const_cast<char*>(strings[i].c_str());
+        strBatch.length[i] = static_cast<int64_t>(strings[i].size());
+      }
+      structBatch.numElements = longBatch.numElements = strBatch.numElements = 1000;
+      writer->add(*batch);
+    }
+    writer->close();
+
+    auto pool = createCachingMemoryPool();
+    uint64_t cachedAfterFirstRead = 0;
+    for (int pass = 0; pass < 2; ++pass) {
+      auto inStream =
+          std::make_unique<MemoryInputStream>(memStream.getData(), memStream.getLength());
+      ReaderOptions readerOptions;
+      readerOptions.setMemoryPool(*pool);
+      auto reader = createReader(std::move(inStream), readerOptions);
+      EXPECT_GT(reader->getNumberOfStripes(), 1);
+      auto rowReader = reader->createRowReader();
+      auto readBatch = rowReader->createRowBatch(1000);
+      auto& readLongs =
+          dynamic_cast<LongVectorBatch&>(*dynamic_cast<StructVectorBatch&>(*readBatch).fields[0]);
+      int64_t expected = 0;
+      while (rowReader->next(*readBatch)) {
+        for (uint64_t i = 0; i < readBatch->numElements; ++i) {
+          EXPECT_EQ(expected++, readLongs.data[i]);
+        }
+      }
+      EXPECT_EQ(20000, expected);
+      readBatch.reset();
+      rowReader.reset();
+      reader.reset();
+      if (pass == 0) {
+        cachedAfterFirstRead = pool->getCachedBytes();
+        EXPECT_GT(cachedAfterFirstRead, 0);
+      } else {
+        // the second reader is served from the blocks freed by the first one
+        EXPECT_EQ(cachedAfterFirstRead, pool->getCachedBytes());
+      }
+    }
+  }
+
+  TEST(TestTrackingMemoryPool, limits) {
+    TrackingMemoryPoolOptions parentOptions;
+    parentOptions.limit = 10000;
+    auto parent = createTrackingMemoryPool(parentOptions);
+    TrackingMemoryPoolOptions childOptions;
+    childOptions.limit = 6000;
+    auto child = createTrackingMemoryPool(childOptions, parent.get());
+    EXPECT_EQ(6000, child->getLimit());
+
+    char* first = child->malloc(4000);
+    EXPECT_EQ(4000, child->getCurrentBytes());
+    // the parent also pays for the bookkeeping of the child
+    EXPECT_GE(parent->getCurrentBytes(), 4000);
+    EXPECT_THROW(child->malloc(4000), MemoryLimitExceeded);
+    EXPECT_EQ(4000, child->getCurrentBytes());
+
+    char* second = parent->malloc(5000);
+    // within the limit of the child, but not of the parent
+    EXPECT_THROW(child->malloc(1500), MemoryLimitExceeded);
+    EXPECT_EQ(4000, child->getCurrentBytes());
+
+    child->free(first);
+    parent->free(second);
+    EXPECT_EQ(0, child->getCurrentBytes());
+    EXPECT_EQ(0, parent->getCurrentBytes());
+    EXPECT_EQ(4000, child->getPeakBytes());
+  }
+
+  TEST(TestTrackingMemoryPool, overCachingPool) {
+    auto caching = createCachingMemoryPool();
+    {
+      auto parent = createTrackingMemoryPool(TrackingMemoryPoolOptions(), caching.get());
+      auto child = createTrackingMemoryPool(TrackingMemoryPoolOptions(), parent.get());
+      MemoryPool& column = child->getColumnPool(1);
+      const uint64_t size = 1024 * 1024;
+      char* block = column.malloc(size);
+      memset(block, 5, size);
+      EXPECT_EQ(size, child->getCurrentBytes());
+      column.free(block);
+      // the headers of both tracking pools fit in the 1 MiB size class
+      EXPECT_EQ(size + BLOCK_OVERHEAD, caching->getCachedBytes());
+    }
+    caching->releaseCache();
+  }
+
+  TEST(TestTrackingMemoryPool, columns) {
+    auto pool = createTrackingMemoryPool();
+    MemoryPool& column = getColumnMemoryPool(*pool, 3);
+    EXPECT_EQ(&column, &pool->getColumnPool(3));
+    EXPECT_EQ(getDefaultPool(), &getColumnMemoryPool(*getDefaultPool(), 3));
+
+    char* p = column.malloc(100);
+    char* q = pool->malloc(50);
+    EXPECT_EQ(100, pool->getColumnCurrentBytes(3));
+    EXPECT_EQ(0, pool->getColumnCurrentBytes(4));
+    EXPECT_EQ(150, pool->getCurrentBytes());
+    column.free(p);
+    pool->free(q);
+    EXPECT_EQ(0, pool->getColumnCurrentBytes(3));
+    EXPECT_EQ(100, pool->getColumnPeakBytes(3));
+    EXPECT_EQ(150, pool->getPeakBytes());
+  }
+
+  static void writeNumbers(MemoryOutputStream& memStream, MemoryPool& pool, uint64_t rows,
+                           WriterMetrics* metrics) {
+    auto type = std::unique_ptr<Type>(Type::buildTypeFromString("struct<a:bigint,b:string>"));
+    WriterOptions options;
+    options.setStripeSize(64 * 1024 * 1024)
+        .setCompressionBlockSize(1024)
+        .setCompression(CompressionKind_ZLIB)
+        .setMemoryPool(&pool)
+        .setWriterMetrics(metrics);
+    auto writer = createWriter(*type, &memStream, options);
+    auto batch = writer->createRowBatch(1000);
+    auto& structBatch = dynamic_cast<StructVectorBatch&>(*batch);
+    auto& longBatch = dynamic_cast<LongVectorBatch&>(*structBatch.fields[0]);
+    auto& strBatch = dynamic_cast<StringVectorBatch&>(*structBatch.fields[1]);
+    std::vector<std::string> strings(1000);
+    for (uint64_t start = 0; start < rows; start += 1000) {
+      for (uint64_t i = 0; i < 1000; ++i) {
+        longBatch.data[i] = static_cast<int64_t>((start + i) * 7919 % 100003);
+        strings[i] = std::to_string(longBatch.data[i]);
+        strBatch.data[i] = const_cast<char*>(strings[i].c_str());
+        strBatch.length[i] = static_cast<int64_t>(strings[i].size());
+      }
+      structBatch.numElements = longBatch.numElements = strBatch.numElements = 1000;
+      writer->add(*batch);
+    }
+    writer->close();
+  }
+
+  TEST(TestTrackingMemoryPool, readerAndWriter) {
+    MemoryOutputStream memStream(10 * 1024 * 1024);
+    auto writerPool = createTrackingMemoryPool();
+    WriterMetrics writerMetrics;
+    writeNumbers(memStream, *writerPool, 20000, &writerMetrics);
+    EXPECT_EQ(0, writerPool->getCurrentBytes());
+    EXPECT_EQ(writerPool->getPeakBytes(), writerMetrics.PeakMemoryBytes.load());
+    EXPECT_GT(writerPool->getColumnPeakBytes(1), 0);
+    EXPECT_GT(writerPool->getColumnPeakBytes(2), 0);
+    EXPECT_EQ(0, writerMetrics.EarlyStripeFlushCount.load());
+
+    auto readerPool = createTrackingMemoryPool();
+    ReaderMetrics readerMetrics;
+    {
+      auto inStream =
+          std::make_unique<MemoryInputStream>(memStream.getData(), memStream.getLength());
+      ReaderOptions readerOptions;
+      readerOptions.setMemoryPool(*readerPool);
+      readerOptions.setReaderMetrics(&readerMetrics);
+      auto reader = createReader(std::move(inStream), readerOptions);
+      auto rowReader = reader->createRowReader();
+      auto batch = rowReader->createRowBatch(1000);
+      uint64_t rows = 0;
+      while (rowReader->next(*batch)) {
+        rows += batch->numElements;
+        // the decompression buffers are charged to the columns
+        EXPECT_GT(readerPool->getColumnCurrentBytes(1), 0);
+        EXPECT_GT(readerPool->getColumnCurrentBytes(2), 0);
+      }
+      EXPECT_EQ(20000, rows);
+    }
+    EXPECT_EQ(0, readerPool->getCurrentBytes());
+    EXPECT_GT(readerMetrics.PeakMemoryBytes.load(), 0);
+    EXPECT_LE(readerMetrics.PeakMemoryBytes.load(), readerPool->getPeakBytes());
+
+    // a reader above its limit fails with a distinct exception
+    TrackingMemoryPoolOptions limited;
+    limited.limit = readerPool->getPeakBytes() / 4;
+    auto limitedPool = createTrackingMemoryPool(limited);
+    EXPECT_THROW(
+        {
+          auto inStream =
+              std::make_unique<MemoryInputStream>(memStream.getData(), memStream.getLength());
+          ReaderOptions readerOptions;
+          readerOptions.setMemoryPool(*limitedPool);
+          auto reader = createReader(std::move(inStream), readerOptions);
+          auto rowReader = reader->createRowReader();
+          auto batch = rowReader->createRowBatch(1000);
+          while (rowReader->next(*batch)) {
+          }
+        },
+        MemoryLimitExceeded);
+  }
+
+  TEST(TestTrackingMemoryPool, flushStripesEarly) {
+    MemoryOutputStream memStream(10 * 1024 * 1024);
+    TrackingMemoryPoolOptions options;
+    options.flushThreshold = 1;
+    auto pool = createTrackingMemoryPool(options);
+    WriterMetrics metrics;
+    writeNumbers(memStream, *pool, 50000, &metrics);
+    EXPECT_GT(metrics.EarlyStripeFlushCount.load(), 0);
+
+    auto inStream = std::make_unique<MemoryInputStream>(memStream.getData(), memStream.getLength());
+    ReaderOptions readerOptions;
+    auto reader = createReader(std::move(inStream), readerOptions);
+    EXPECT_EQ(metrics.EarlyStripeFlushCount.load() + 1, reader->getNumberOfStripes());
+    EXPECT_EQ(50000, reader->getNumberOfRows());
+  }
+
+  // counts the allocations served by the default pool
+  class CountingMemoryPool : public MemoryPool {
+   public:
+    char* malloc(uint64_t size) override {
+      ++allocations;
+      return getDefaultPool()->malloc(size);
+    }
+
+    void free(char* p) override {
+      getDefaultPool()->free(p);
+    }
+
+    uint64_t allocations = 0;
+  };
+
+  TEST(TestRowBatchPool, noAllocationsAfterWarmUp) {
+    MemoryOutputStream memStream(10 * 1024 * 1024);
+    writeNumbers(memStream, *getDefaultPool(), 50000, nullptr);
+
+    CountingMemoryPool pool;
+    auto inStream = std::make_unique<MemoryInputStream>(memStream.getData(), memStream.getLength());
+    ReaderOptions readerOptions;
+    readerOptions.setMemoryPool(pool);
+    auto reader = createReader(std::move(inStream), readerOptions);
+    ASSERT_EQ(1, reader->getNumberOfStripes());
+    auto rowReader = reader->createRowReader();
+    auto batchPool = createRowBatchPool(*rowReader, 1000, 2);
+
+    uint64_t rows = 0;
+    uint64_t allocationsAfterWarmUp = 0;
+    for (uint64_t batches = 0;; ++batches) {
+      if (batches == 5) {
+        allocationsAfterWarmUp = pool.allocations;
+      }
+      auto batch = batchPool->acquire();
+      bool hasRows = rowReader->next(*batch);
+      rows += batch->numElements;
+      batchPool->release(std::move(batch));
+      if (!hasRows) {
+        break;
+      }
+    }
+    EXPECT_EQ(50000, rows);
+    EXPECT_EQ(1, batchPool->getNumberOfIdleBatches());
+    EXPECT_EQ(allocationsAfterWarmUp, pool.allocations);
+
+    // a released batch is handed out again
+    auto first = batchPool->acquire();
+    auto second = batchPool->acquire();
+    ColumnVectorBatch* released = second.get();
+    batchPool->release(std::move(second));
+    EXPECT_EQ(released, batchPool->acquire().get());
+    batchPool->release(std::move(first));
+  }
+
+  TEST(TestRowBatchPool, resizeUninitialized) {
+    CountingMemoryPool pool;
+    DataBuffer<char> buffer(pool, 0);
+    // growing a little at a time reallocates only a few times
+    for (uint64_t size = 1; size <= 10000; ++size) {
+      buffer.resizeUninitialized(size);
+      buffer[size - 1] = static_cast<char>(size);
+    }
+    EXPECT_EQ(10000, buffer.size());
+    EXPECT_LT(pool.allocations, 30);
+    for (uint64_t size = 1; size <= 10000; ++size) {
+      EXPECT_EQ(static_cast<char>(size), buffer[size - 1]);
+    }
+
+    // shrinking keeps the capacity
+    uint64_t capacity = buffer.capacity();
+    buffer.resizeUninitialized(10);
+    EXPECT_EQ(10, buffer.size());
+    EXPECT_EQ(capacity, buffer.capacity());
+
+    DataBuffer<Int128> decimals(pool, 0);
+    decimals.reserveWithGrowth(100);
+    EXPECT_EQ(100, decimals.capacity());
+    decimals.reserveWithGrowth(101);
+    EXPECT_EQ(150, decimals.capacity());
+  }
+
+}  // namespace orc
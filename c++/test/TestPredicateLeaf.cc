@@ -663,4 +663,39 @@ namespace orc {
               evaluate(pred8, createTimestampStats(2114380800, 1109000, 2114380800, 6789100)));
   }
 
+
+  TEST(TestPredicateLeaf, testStringBounds) {
+    proto::ColumnStatistics bounded = createStringStats("", "");
+    proto::StringStatistics* strStats = bounded.mutable_string_statistics();
+    strStats->clear_minimum();
+    strStats->clear_maximum();
+    strStats->set_lower_bound("b");
+    strStats->set_upper_bound("c");
+
+    // bounds rule values out
+    PredicateLeaf before(PredicateLeaf::Operator::EQUALS, PredicateDataType::STRING, "x",
+                         Literal("a", 1));
+    EXPECT_EQ(TruthValue::NO, evaluate(before, bounded));
+    PredicateLeaf after(PredicateLeaf::Operator::LESS_THAN, PredicateDataType::STRING, "x",
+                        Literal("b", 1));
+    EXPECT_EQ(TruthValue::NO, evaluate(after, bounded));
+
+    // but not in
+    strStats->set_upper_bound("b");
+    PredicateLeaf equals(PredicateLeaf::Operator::EQUALS, PredicateDataType::STRING, "x",
+                         Literal("b", 1));
+    EXPECT_EQ(TruthValue::YES, evaluate(equals, createStringStats("b", "b")));
+    EXPECT_EQ(TruthValue::YES_NO, evaluate(equals, bounded));
+    bounded.set_has_null(true);
+    EXPECT_EQ(TruthValue::YES_NO_NULL, evaluate(equals, bounded));
+
+    // an exact minimum with an upper bound
+    proto::ColumnStatistics mixed = createStringStats("b", "");
+    mixed.mutable_string_statistics()->clear_maximum();
+    mixed.mutable_string_statistics()->set_upper_bound("d");
+    PredicateLeaf lessThan(PredicateLeaf::Operator::LESS_THAN, PredicateDataType::STRING, "x",
+                           Literal("e", 1));
+    EXPECT_EQ(TruthValue::YES_NO, evaluate(lessThan, mixed));
+    EXPECT_EQ(TruthValue::NO, evaluate(after, mixed));
+  }
 }  // namespace orc
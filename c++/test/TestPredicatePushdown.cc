@@ -306,6 +306,31 @@ namespace orc {
     EXPECT_EQ(0, readBatch->numElements);
   }
 
+  void TestSeekIntoMiddleRowGroup(Reader* reader, std::unique_ptr<SearchArgument> sarg,
+                                  uint64_t seekRowNumber, uint64_t lastRow) {
+    RowReaderOptions rowReaderOpts;
+    rowReaderOpts.searchArgument(std::move(sarg));
+    auto rowReader = reader->createRowReader(rowReaderOpts);
+    auto readBatch = rowReader->createRowBatch(4000);
+    auto& batch0 = dynamic_cast<StructVectorBatch&>(*readBatch);
+    auto& batch1 = dynamic_cast<LongVectorBatch&>(*batch0.fields[0]);
+    auto& batch2 = dynamic_cast<StringVectorBatch&>(*batch0.fields[1]);
+
+    // the first seek starts the stripe, the second one stays in it
+    for (uint64_t seek : {seekRowNumber, seekRowNumber + 123}) {
+      rowReader->seekToRow(seek);
+      EXPECT_TRUE(rowReader->next(*readBatch));
+      EXPECT_EQ(seek, rowReader->getRowNumber());
+      EXPECT_EQ(lastRow - seek, readBatch->numElements);
+      for (uint64_t i = 0; i < readBatch->numElements; ++i) {
+        EXPECT_EQ(300 * (i + seek), batch1.data[i]);
+        EXPECT_EQ(std::to_string(10 * (i + seek)),
+                  std::string(batch2.data[i], static_cast<size_t>(batch2.length[i])));
+      }
+    }
+    EXPECT_FALSE(rowReader->next(*readBatch));
+  }
+
   TEST(TestPredicatePushdown, testPredicatePushdown) {
     MemoryOutputStream memStream(DEFAULT_MEM_STREAM_SIZE);
     MemoryPool* pool = getDefaultPool();
@@ -326,6 +351,30 @@ namespace orc {
     }
 
     TestMultipleSeeksWithPredicates(reader.get());
+
+    // The 2nd and 3rd row groups are selected, so the row indexes are read
+    // when the stripe starts.
+    TestSeekIntoMiddleRowGroup(reader.get(),
+                               SearchArgumentFactory::newBuilder()
+                                   ->startAnd()
+                                   .startNot()
+                                   .lessThan("int1", PredicateDataType::LONG,
+                                             Literal(static_cast<int64_t>(300000L)))
+                                   .end()
+                                   .lessThan("int1", PredicateDataType::LONG,
+                                             Literal(static_cast<int64_t>(900000L)))
+                                   .end()
+                                   .build(),
+                               1500, 3000);
+    // Every row matches, so the row indexes are only read for the seek.
+    TestSeekIntoMiddleRowGroup(reader.get(),
+                               SearchArgumentFactory::newBuilder()
+                                   ->startNot()
+                                   .lessThan("int1", PredicateDataType::LONG,
+                                             Literal(static_cast<int64_t>(0)))
+                                   .end()
+                                   .build(),
+                               2500, 3500);
   }
 
   void TestMultipleSeeksWithoutRowIndexes(Reader* reader, bool createSarg) {
@@ -546,4 +595,431 @@ namespace orc {
       TestFirstStripeSelectedWithStripeStats(reader.get(), pos);
     }
   }
+
+  TEST(TestPredicatePushdown, testZoneMaps) {
+    MemoryOutputStream memStream(DEFAULT_MEM_STREAM_SIZE);
+    MemoryPool* pool = getDefaultPool();
+    auto type =
+        std::unique_ptr<Type>(Type::buildTypeFromString("struct<int1:bigint,string1:string>"));
+    WriterOptions options;
+    options.setStripeSize(1024 * 1024)
+        .setCompressionBlockSize(1024)
+        .setCompression(CompressionKind_NONE)
+        .setMemoryPool(pool)
+        .setRowIndexStride(1000)
+        .setZoneMapGranularity(300);
+    EXPECT_EQ(300, options.getZoneMapGranularity());
+    // pages must not span row groups
+    EXPECT_THROW(createWriter(*type, &memStream, options), InvalidArgument);
+    options.setZoneMapGranularity(100);
+
+    auto writer = createWriter(*type, &memStream, options);
+    // add rows in chunks which do not align with zone map pages
+    auto batch = writer->createRowBatch(700);
+    auto& structBatch = dynamic_cast<StructVectorBatch&>(*batch);
+    auto& longBatch = dynamic_cast<LongVectorBatch&>(*structBatch.fields[0]);
+    auto& strBatch = dynamic_cast<StringVectorBatch&>(*structBatch.fields[1]);
+    std::vector<std::string> strings(700);
+    for (uint64_t offset = 0; offset < 3500; offset += 700) {
+      for (uint64_t i = 0; i < 700; ++i) {
+        longBatch.data[i] = static_cast<int64_t>((offset + i) * 300);
+        strings[i] = std::to_string(10 * (offset + i));
+        strBatch.data[i] = const_cast<char*>(strings[i].c_str());
+        strBatch.length[i] = static_cast<int64_t>(strings[i].size());
+      }
+      structBatch.numElements = 700;
+      longBatch.numElements = 700;
+      strBatch.numElements = 700;
+      writer->add(*batch);
+    }
+    writer->close();
+
+    auto inStream = std::make_unique<MemoryInputStream>(memStream.getData(), memStream.getLength());
+    ReaderOptions readerOptions;
+    readerOptions.setMemoryPool(*pool);
+    std::unique_ptr<Reader> reader = createReader(std::move(inStream), readerOptions);
+    EXPECT_EQ(3500, reader->getNumberOfRows());
+
+    // Select rows [1100, 1200) and [2550, 2560). Row group statistics select
+    // row groups 1 and 2, zone maps narrow them down to pages 11 and 25.
+    auto sarg =
+        SearchArgumentFactory::newBuilder()
+            ->startOr()
+            .between("int1", PredicateDataType::LONG, Literal(static_cast<int64_t>(330000L)),
+                     Literal(static_cast<int64_t>(359700L)))
+            .between("int1", PredicateDataType::LONG, Literal(static_cast<int64_t>(765000L)),
+                     Literal(static_cast<int64_t>(767700L)))
+            .end()
+            .build();
+    RowReaderOptions rowReaderOpts;
+    rowReaderOpts.searchArgument(std::move(sarg));
+    auto rowReader = reader->createRowReader(rowReaderOpts);
+
+    auto readBatch = rowReader->createRowBatch(1000);
+    auto& batch0 = dynamic_cast<StructVectorBatch&>(*readBatch);
+    auto& batch1 = dynamic_cast<LongVectorBatch&>(*batch0.fields[0]);
+    auto& batch2 = dynamic_cast<StringVectorBatch&>(*batch0.fields[1]);
+
+    uint64_t expectedStarts[] = {1100, 2500};
+    for (uint64_t start : expectedStarts) {
+      EXPECT_TRUE(rowReader->next(*readBatch));
+      EXPECT_EQ(100, readBatch->numElements);
+      EXPECT_EQ(start, rowReader->getRowNumber());
+      for (uint64_t i = 0; i < 100; ++i) {
+        EXPECT_EQ(300 * (start + i), batch1.data[i]);
+        EXPECT_EQ(std::to_string(10 * (start + i)),
+                  std::string(batch2.data[i], static_cast<size_t>(batch2.length[i])));
+      }
+    }
+    EXPECT_FALSE(rowReader->next(*readBatch));
+    EXPECT_EQ(3500, rowReader->getRowNumber());
+
+    // seek into the middle of a selected page and before a skipped one
+    rowReader->seekToRow(1150);
+    EXPECT_TRUE(rowReader->next(*readBatch));
+    EXPECT_EQ(50, readBatch->numElements);
+    EXPECT_EQ(1150, rowReader->getRowNumber());
+    EXPECT_EQ(300 * 1150, batch1.data[0]);
+    rowReader->seekToRow(1300);
+    EXPECT_TRUE(rowReader->next(*readBatch));
+    EXPECT_EQ(2500, rowReader->getRowNumber());
+    EXPECT_EQ(300 * 2500, batch1.data[0]);
+
+    // readers without a search argument see all rows
+    rowReader = reader->createRowReader(RowReaderOptions());
+    uint64_t rows = 0;
+    while (rowReader->next(*readBatch)) {
+      for (uint64_t i = 0; i < readBatch->numElements; ++i) {
+        EXPECT_EQ(300 * (rows + i), batch1.data[i]);
+      }
+      rows += readBatch->numElements;
+    }
+    EXPECT_EQ(3500, rows);
+  }
+
+  TEST(TestPredicatePushdown, testZoneMapsOfDateStringAndTimestamp) {
+    MemoryOutputStream memStream(DEFAULT_MEM_STREAM_SIZE);
+    MemoryPool* pool = getDefaultPool();
+    auto type = std::unique_ptr<Type>(
+        Type::buildTypeFromString("struct<date1:date,string1:string,timestamp1:timestamp>"));
+    WriterOptions options;
+    options.setStripeSize(1024 * 1024)
+        .setCompressionBlockSize(1024)
+        .setCompression(CompressionKind_ZLIB)
+        .setMemoryPool(pool)
+        .setRowIndexStride(1000)
+        .setZoneMapGranularity(100);
+
+    auto writer = createWriter(*type, &memStream, options);
+    auto batch = writer->createRowBatch(3000);
+    auto& structBatch = dynamic_cast<StructVectorBatch&>(*batch);
+    auto& dateBatch = dynamic_cast<LongVectorBatch&>(*structBatch.fields[0]);
+    auto& strBatch = dynamic_cast<StringVectorBatch&>(*structBatch.fields[1]);
+    auto& tsBatch = dynamic_cast<TimestampVectorBatch&>(*structBatch.fields[2]);
+    std::vector<std::string> strings(3000);
+    for (uint64_t i = 0; i < 3000; ++i) {
+      dateBatch.data[i] = static_cast<int64_t>(i);
+      // zero padded so that strings sort like the row numbers
+      strings[i] = std::to_string(10000 + i);
+      strBatch.data[i] = const_cast<char*>(strings[i].c_str());
+      strBatch.length[i] = static_cast<int64_t>(strings[i].size());
+      tsBatch.data[i] = static_cast<int64_t>(60 * i);
+      tsBatch.nanoseconds[i] = 0;
+    }
+    structBatch.numElements = 3000;
+    dateBatch.numElements = 3000;
+    strBatch.numElements = 3000;
+    tsBatch.numElements = 3000;
+    writer->add(*batch);
+    writer->close();
+
+    auto inStream = std::make_unique<MemoryInputStream>(memStream.getData(), memStream.getLength());
+    ReaderOptions readerOptions;
+    readerOptions.setMemoryPool(*pool);
+    std::unique_ptr<Reader> reader = createReader(std::move(inStream), readerOptions);
+    EXPECT_EQ(3000, reader->getNumberOfRows());
+
+    // zone maps follow the stripe, which only has streams of the specification
+    // and none of them is a PRESENT stream since there is no null
+    EXPECT_TRUE(reader->getMetadataKeys().empty());
+    auto stripe = reader->getStripe(0);
+    EXPECT_LT(stripe->getOffset() + stripe->getLength(), memStream.getLength());
+    for (uint64_t i = 0; i < stripe->getNumberOfStreams(); ++i) {
+      EXPECT_NE(StreamKind_PRESENT, stripe->getStreamInformation(i)->getKind());
+    }
+
+    auto readPages = [&](std::unique_ptr<SearchArgument> sarg) {
+      RowReaderOptions rowReaderOpts;
+      rowReaderOpts.searchArgument(std::move(sarg));
+      auto rowReader = reader->createRowReader(rowReaderOpts);
+      auto readBatch = rowReader->createRowBatch(1000);
+      auto& fields = dynamic_cast<StructVectorBatch&>(*readBatch).fields;
+      auto& dates = dynamic_cast<LongVectorBatch&>(*fields[0]);
+      auto& strs = dynamic_cast<StringVectorBatch&>(*fields[1]);
+      auto& timestamps = dynamic_cast<TimestampVectorBatch&>(*fields[2]);
+      std::vector<uint64_t> starts;
+      while (rowReader->next(*readBatch)) {
+        uint64_t start = rowReader->getRowNumber();
+        EXPECT_EQ(100, readBatch->numElements);
+        for (uint64_t i = 0; i < readBatch->numElements; ++i) {
+          EXPECT_EQ(start + i, dates.data[i]);
+          EXPECT_EQ(std::to_string(10000 + start + i),
+                    std::string(strs.data[i], static_cast<size_t>(strs.length[i])));
+          EXPECT_EQ(60 * (start + i), timestamps.data[i]);
+        }
+        starts.push_back(start);
+      }
+      return starts;
+    };
+
+    // each predicate selects a single page inside a row group
+    EXPECT_EQ(std::vector<uint64_t>({1200}),
+              readPages(SearchArgumentFactory::newBuilder()
+                            ->equals("date1", PredicateDataType::DATE,
+                                     Literal(PredicateDataType::DATE, 1234))
+                            .build()));
+    EXPECT_EQ(std::vector<uint64_t>({2500}),
+              readPages(SearchArgumentFactory::newBuilder()
+                            ->between("string1", PredicateDataType::STRING,
+                                      Literal("12550", 5), Literal("12560", 5))
+                            .build()));
+    EXPECT_EQ(std::vector<uint64_t>({700, 2900}),
+              readPages(SearchArgumentFactory::newBuilder()
+                            ->startOr()
+                            .equals("timestamp1", PredicateDataType::TIMESTAMP,
+                                    Literal(static_cast<int64_t>(60 * 789), 0))
+                            .equals("timestamp1", PredicateDataType::TIMESTAMP,
+                                    Literal(static_cast<int64_t>(60 * 2999), 0))
+                            .end()
+                            .build()));
+  }
+
+  TEST(TestPredicatePushdown, testZoneMapsOutsideStripes) {
+    MemoryPool* pool = getDefaultPool();
+    auto type = std::unique_ptr<Type>(Type::buildTypeFromString("struct<int1:bigint>"));
+    auto writeFile = [&](MemoryOutputStream& memStream, uint64_t zoneMapGranularity) {
+      WriterOptions options;
+      options.setStripeSize(1)
+          .setCompressionBlockSize(1024)
+          .setCompression(CompressionKind_NONE)
+          .setMemoryPool(pool)
+          .setRowIndexStride(1000)
+          .setZoneMapGranularity(zoneMapGranularity);
+      auto writer = createWriter(*type, &memStream, options);
+      writer->addUserMetadata("user.key", "user.value");
+      auto batch = writer->createRowBatch(2000);
+      auto& structBatch = dynamic_cast<StructVectorBatch&>(*batch);
+      auto& longBatch = dynamic_cast<LongVectorBatch&>(*structBatch.fields[0]);
+      // one stripe per batch
+      for (uint64_t offset = 0; offset < 6000; offset += 2000) {
+        for (uint64_t i = 0; i < 2000; ++i) {
+          longBatch.data[i] = static_cast<int64_t>(offset + i);
+        }
+        structBatch.numElements = 2000;
+        longBatch.numElements = 2000;
+        writer->add(*batch);
+      }
+      writer->close();
+      ReaderOptions readerOptions;
+      readerOptions.setMemoryPool(*pool);
+      return createReader(
+          std::make_unique<MemoryInputStream>(memStream.getData(), memStream.getLength()),
+          readerOptions);
+    };
+    MemoryOutputStream plainStream(DEFAULT_MEM_STREAM_SIZE);
+    MemoryOutputStream zoneMapStream(DEFAULT_MEM_STREAM_SIZE);
+    std::unique_ptr<Reader> plainReader = writeFile(plainStream, 0);
+    std::unique_ptr<Reader> reader = writeFile(zoneMapStream, 100);
+
+    // zone maps leave the user metadata and the stripes as they are without
+    // them, so readers that only follow the stripe information skip them
+    EXPECT_EQ(std::list<std::string>({"user.key"}), reader->getMetadataKeys());
+    EXPECT_EQ(plainReader->getMetadataKeys(), reader->getMetadataKeys());
+    ASSERT_EQ(3, reader->getNumberOfStripes());
+    ASSERT_EQ(plainReader->getNumberOfStripes(), reader->getNumberOfStripes());
+    for (uint64_t i = 0; i < reader->getNumberOfStripes(); ++i) {
+      auto plainStripe = plainReader->getStripe(i);
+      auto stripe = reader->getStripe(i);
+      EXPECT_EQ(plainStripe->getIndexLength(), stripe->getIndexLength());
+      EXPECT_EQ(plainStripe->getDataLength(), stripe->getDataLength());
+      EXPECT_EQ(plainStripe->getFooterLength(), stripe->getFooterLength());
+      ASSERT_EQ(plainStripe->getNumberOfStreams(), stripe->getNumberOfStreams());
+      for (uint64_t j = 0; j < stripe->getNumberOfStreams(); ++j) {
+        EXPECT_EQ(plainStripe->getStreamInformation(j)->getKind(),
+                  stripe->getStreamInformation(j)->getKind());
+        EXPECT_EQ(plainStripe->getStreamInformation(j)->getLength(),
+                  stripe->getStreamInformation(j)->getLength());
+      }
+      // the zone maps fill the gap up to the next stripe
+      uint64_t nextOffset = i + 1 < reader->getNumberOfStripes()
+                                ? reader->getStripe(i + 1)->getOffset()
+                                : reader->getContentLength() + 3;
+      EXPECT_LT(stripe->getOffset() + stripe->getLength(), nextOffset);
+      EXPECT_EQ(plainStripe->getOffset() + plainStripe->getLength(),
+                i + 1 < plainReader->getNumberOfStripes()
+                    ? plainReader->getStripe(i + 1)->getOffset()
+                    : plainReader->getContentLength() + 3);
+    }
+
+    // a reader without search argument never reads the zone maps
+    RowReaderOptions rowReaderOpts;
+    auto rowReader = reader->createRowReader(rowReaderOpts);
+    auto readBatch = rowReader->createRowBatch(6000);
+    auto& longBatch =
+        dynamic_cast<LongVectorBatch&>(*dynamic_cast<StructVectorBatch&>(*readBatch).fields[0]);
+    uint64_t rows = 0;
+    while (rowReader->next(*readBatch)) {
+      for (uint64_t i = 0; i < readBatch->numElements; ++i) {
+        EXPECT_EQ(rows + i, longBatch.data[i]);
+      }
+      rows += readBatch->numElements;
+    }
+    EXPECT_EQ(6000, rows);
+
+    // with a search argument, the zone maps of the last stripe select one page
+    RowReaderOptions sargReaderOpts;
+    sargReaderOpts.searchArgument(
+        SearchArgumentFactory::newBuilder()
+            ->equals("int1", PredicateDataType::LONG, Literal(static_cast<int64_t>(5555)))
+            .build());
+    rowReader = reader->createRowReader(sargReaderOpts);
+    EXPECT_TRUE(rowReader->next(*readBatch));
+    EXPECT_EQ(5500, rowReader->getRowNumber());
+    EXPECT_EQ(100, readBatch->numElements);
+    EXPECT_EQ(5500, longBatch.data[0]);
+    EXPECT_FALSE(rowReader->next(*readBatch));
+  }
+
+  TEST(TestPredicatePushdown, testSkipUnneededIndexes) {
+    MemoryOutputStream memStream(DEFAULT_MEM_STREAM_SIZE);
+    MemoryPool* pool = getDefaultPool();
+    auto type =
+        std::unique_ptr<Type>(Type::buildTypeFromString("struct<int1:bigint,string1:string>"));
+    WriterOptions options;
+    options.setStripeSize(1024 * 1024)
+        .setCompressionBlockSize(1024)
+        .setCompression(CompressionKind_NONE)
+        .setMemoryPool(pool)
+        .setRowIndexStride(1000)
+        .setColumnsUseBloomFilter({1, 2});
+    auto writer = createWriter(*type, &memStream, options);
+    auto batch = writer->createRowBatch(3500);
+    auto& structBatch = dynamic_cast<StructVectorBatch&>(*batch);
+    auto& longBatch = dynamic_cast<LongVectorBatch&>(*structBatch.fields[0]);
+    auto& strBatch = dynamic_cast<StringVectorBatch&>(*structBatch.fields[1]);
+    std::vector<std::string> strings(3500);
+    for (uint64_t i = 0; i < 3500; ++i) {
+      longBatch.data[i] = static_cast<int64_t>(i * 300);
+      strings[i] = std::to_string(10 * i);
+      strBatch.data[i] = const_cast<char*>(strings[i].c_str());
+      strBatch.length[i] = static_cast<int64_t>(strings[i].size());
+    }
+    structBatch.numElements = 3500;
+    longBatch.numElements = 3500;
+    strBatch.numElements = 3500;
+    writer->add(*batch);
+    writer->close();
+
+    auto readRows = [&](std::unique_ptr<SearchArgument> sarg, ReaderMetrics& metrics,
+                        uint64_t& firstRow) {
+      auto inStream =
+          std::make_unique<MemoryInputStream>(memStream.getData(), memStream.getLength());
+      ReaderOptions readerOptions;
+      readerOptions.setMemoryPool(*pool);
+      readerOptions.setReaderMetrics(&metrics);
+      std::unique_ptr<Reader> reader = createReader(std::move(inStream), readerOptions);
+      RowReaderOptions rowReaderOpts;
+      rowReaderOpts.searchArgument(std::move(sarg));
+      auto rowReader = reader->createRowReader(rowReaderOpts);
+      auto readBatch = rowReader->createRowBatch(3500);
+      uint64_t rows = 0;
+      firstRow = 0;
+      while (rowReader->next(*readBatch)) {
+        if (rows == 0) {
+          firstRow = rowReader->getRowNumber();
+        }
+        rows += readBatch->numElements;
+      }
+      return rows;
+    };
+
+    // Stripe statistics prove that every row matches int1 >= 0, so neither
+    // row indexes nor bloom filters are read.
+    ReaderMetrics allMetrics;
+    uint64_t firstRow;
+    EXPECT_EQ(3500, readRows(SearchArgumentFactory::newBuilder()
+                                 ->startNot()
+                                 .lessThan("int1", PredicateDataType::LONG,
+                                           Literal(static_cast<int64_t>(0)))
+                                 .end()
+                                 .build(),
+                             allMetrics, firstRow));
+    EXPECT_EQ(4, allMetrics.SelectedRowGroupCount.load());
+    uint64_t allIndexBytes = allMetrics.SkippedIndexBytes.load();
+    EXPECT_GT(allIndexBytes, 0);
+
+    // Min/max statistics of the row groups reject all of them, so the bloom
+    // filter of string1 is not read either.
+    ReaderMetrics noneMetrics;
+    EXPECT_EQ(0, readRows(SearchArgumentFactory::newBuilder()
+                              ->startAnd()
+                              .lessThan("int1", PredicateDataType::LONG,
+                                        Literal(static_cast<int64_t>(300000)))
+                              .startNot()
+                              .lessThan("int1", PredicateDataType::LONG,
+                                        Literal(static_cast<int64_t>(600000)))
+                              .end()
+                              .equals("string1", PredicateDataType::STRING, Literal("100", 3))
+                              .end()
+                              .build(),
+                          noneMetrics, firstRow));
+    EXPECT_EQ(0, noneMetrics.SelectedRowGroupCount.load());
+    uint64_t bloomFilterBytes = noneMetrics.SkippedIndexBytes.load();
+    EXPECT_GT(bloomFilterBytes, 0);
+    EXPECT_LT(bloomFilterBytes, allIndexBytes);
+
+    // A seek into the 3rd row group of the stripe that every row matches
+    // loads the row indexes after all, so only the bloom filters are skipped.
+    ReaderMetrics seekMetrics;
+    {
+      auto inStream =
+          std::make_unique<MemoryInputStream>(memStream.getData(), memStream.getLength());
+      ReaderOptions readerOptions;
+      readerOptions.setMemoryPool(*pool);
+      readerOptions.setReaderMetrics(&seekMetrics);
+      std::unique_ptr<Reader> reader = createReader(std::move(inStream), readerOptions);
+      RowReaderOptions rowReaderOpts;
+      rowReaderOpts.searchArgument(SearchArgumentFactory::newBuilder()
+                                       ->startNot()
+                                       .lessThan("int1", PredicateDataType::LONG,
+                                                 Literal(static_cast<int64_t>(0)))
+                                       .end()
+                                       .build());
+      auto rowReader = reader->createRowReader(rowReaderOpts);
+      auto readBatch = rowReader->createRowBatch(3500);
+      rowReader->seekToRow(2500);
+      EXPECT_TRUE(rowReader->next(*readBatch));
+      EXPECT_EQ(2500, rowReader->getRowNumber());
+      EXPECT_EQ(1000, readBatch->numElements);
+      auto& readLongs =
+          dynamic_cast<LongVectorBatch&>(*dynamic_cast<StructVectorBatch&>(*readBatch).fields[0]);
+      EXPECT_EQ(2500 * 300, readLongs.data[0]);
+      EXPECT_FALSE(rowReader->next(*readBatch));
+    }
+    EXPECT_EQ(bloomFilterBytes, seekMetrics.SkippedIndexBytes.load());
+
+    // The bloom filter of string1 narrows the row groups down to the one
+    // holding row 1234, while the bloom filter of int1 is not needed.
+    ReaderMetrics someMetrics;
+    EXPECT_EQ(1000, readRows(SearchArgumentFactory::newBuilder()
+                                 ->equals("string1", PredicateDataType::STRING,
+                                          Literal("12340", 5))
+                                 .build(),
+                             someMetrics, firstRow));
+    EXPECT_EQ(1000, firstRow);
+    EXPECT_EQ(1, someMetrics.SelectedRowGroupCount.load());
+    EXPECT_GT(someMetrics.SkippedIndexBytes.load(), 0);
+    EXPECT_LT(someMetrics.SkippedIndexBytes.load(), bloomFilterBytes);
+  }
+
 }  // namespace orc
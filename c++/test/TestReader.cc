@@ -757,4 +757,195 @@ namespace orc {
       }
     }
   }
+
+  TEST(TestRowReader, sharedDictionaries) {
+    MemoryOutputStream memStream(DEFAULT_MEM_STREAM_SIZE);
+    auto type = std::unique_ptr<Type>(
+        Type::buildTypeFromString("struct<a:array<varchar(4)>,b:map<char(2),string>>"));
+    const uint64_t rowsPerStripe = 100;
+    // the first two stripes have the same dictionaries
+    std::vector<std::vector<std::string>> stripeValues = {{"x", "y", "z"}, {"z", "x", "y"}, {"p"}};
+    {
+      WriterOptions options;
+      // write a stripe for each batch
+      options.setStripeSize(1).setDictionaryKeySizeThreshold(1.0);
+      auto writer = createWriter(*type, &memStream, options);
+      for (const std::vector<std::string>& values : stripeValues) {
+        auto batch = writer->createRowBatch(rowsPerStripe);
+        auto& structBatch = dynamic_cast<StructVectorBatch&>(*batch);
+        auto& lists = dynamic_cast<ListVectorBatch&>(*structBatch.fields[0]);
+        auto& maps = dynamic_cast<MapVectorBatch&>(*structBatch.fields[1]);
+        auto& elements = dynamic_cast<StringVectorBatch&>(*lists.elements);
+        auto& keys = dynamic_cast<StringVectorBatch&>(*maps.keys);
+        auto& items = dynamic_cast<StringVectorBatch&>(*maps.elements);
+        for (uint64_t i = 0; i < rowsPerStripe; ++i) {
+          const std::string& value = values[i % values.size()];
+          for (StringVectorBatch* strings : {&elements, &keys, &items}) {
+            strings->data[i] = const_cast<char*>(value.c_str());
+            strings->length[i] = static_cast<int64_t>(value.size());
+          }
+          lists.offsets[i + 1] = maps.offsets[i + 1] = static_cast<int64_t>(i + 1);
+        }
+        structBatch.numElements = lists.numElements = maps.numElements = rowsPerStripe;
+        elements.numElements = keys.numElements = items.numElements = rowsPerStripe;
+        writer->add(*batch);
+      }
+      writer->close();
+    }
+
+    auto inStream = std::make_unique<MemoryInputStream>(memStream.getData(), memStream.getLength());
+    auto reader = createReader(std::move(inStream), ReaderOptions());
+    ASSERT_EQ(stripeValues.size(), reader->getNumberOfStripes());
+    RowReaderOptions rowReaderOptions;
+    rowReaderOptions.setEnableLazyDecoding(true);
+    auto rowReader = reader->createRowReader(rowReaderOptions);
+    auto batch = rowReader->createRowBatch(rowsPerStripe);
+    std::vector<std::vector<std::shared_ptr<StringDictionary>>> dictionaries;
+    while (rowReader->next(*batch)) {
+      auto& structBatch = dynamic_cast<StructVectorBatch&>(*batch);
+      auto& lists = dynamic_cast<ListVectorBatch&>(*structBatch.fields[0]);
+      auto& maps = dynamic_cast<MapVectorBatch&>(*structBatch.fields[1]);
+      std::vector<std::shared_ptr<StringDictionary>> stripeDictionaries;
+      for (ColumnVectorBatch* column :
+           {lists.elements.get(), maps.keys.get(), maps.elements.get()}) {
+        auto* encoded = dynamic_cast<EncodedStringVectorBatch*>(column);
+        ASSERT_NE(nullptr, encoded);
+        ASSERT_TRUE(encoded->isEncoded);
+        const std::vector<std::string>& values = stripeValues[dictionaries.size()];
+        for (uint64_t i = 0; i < encoded->numElements; ++i) {
+          char* value;
+          int64_t length;
+          encoded->dictionary->getValueByIndex(encoded->index[i], value, length);
+          std::string expected = values[i % values.size()];
+          if (column == maps.keys.get()) {
+            // chars are padded
+            expected.resize(2, ' ');
+          }
+          EXPECT_EQ(expected, std::string(value, static_cast<size_t>(length)));
+        }
+        stripeDictionaries.push_back(encoded->dictionary);
+      }
+      dictionaries.push_back(stripeDictionaries);
+    }
+    ASSERT_EQ(stripeValues.size(), dictionaries.size());
+    for (uint64_t column = 0; column < 3; ++column) {
+      EXPECT_EQ(dictionaries[0][column], dictionaries[1][column]);
+      EXPECT_NE(dictionaries[1][column], dictionaries[2][column]);
+    }
+  }
+
+  static void writeLongFile(MemoryOutputStream& memStream, uint64_t rowCount) {
+    auto type = std::unique_ptr<Type>(Type::buildTypeFromString("struct<a:bigint>"));
+    auto writer = createWriter(*type, &memStream, WriterOptions());
+    auto batch = writer->createRowBatch(rowCount);
+    auto& structBatch = dynamic_cast<StructVectorBatch&>(*batch);
+    auto& longBatch = dynamic_cast<LongVectorBatch&>(*structBatch.fields[0]);
+    for (uint64_t i = 0; i < rowCount; ++i) {
+      longBatch.data[i] = static_cast<int64_t>(i);
+    }
+    structBatch.numElements = longBatch.numElements = rowCount;
+    writer->add(*batch);
+    writer->close();
+  }
+
+  TEST(TestReader, fileTailCache) {
+    MemoryOutputStream memStream1(DEFAULT_MEM_STREAM_SIZE);
+    MemoryOutputStream memStream2(DEFAULT_MEM_STREAM_SIZE);
+    writeLongFile(memStream1, 10);
+    writeLongFile(memStream2, 1000);
+    ASSERT_NE(memStream1.getLength(), memStream2.getLength());
+    auto open = [](const MemoryOutputStream& memStream, const ReaderOptions& options) {
+      return createReader(
+          std::make_unique<MemoryInputStream>(memStream.getData(), memStream.getLength()),
+          options);
+    };
+
+    std::shared_ptr<FileTailCache> cache = createFileTailCache(1024 * 1024);
+    ReaderOptions options;
+    options.setFileTailCache(cache);
+    auto reader1 = open(memStream1, options);
+    EXPECT_EQ(0, cache->getNumberOfHits());
+    EXPECT_EQ(1, cache->getNumberOfMisses());
+    EXPECT_EQ(1, cache->getNumberOfEntries());
+    uint64_t footerUsage = cache->getMemoryUsage();
+    EXPECT_LT(0, footerUsage);
+
+    // reading the stripe statistics adds them to the cached tail
+    EXPECT_EQ(1, reader1->getNumberOfStripeStatistics());
+    EXPECT_LT(footerUsage, cache->getMemoryUsage());
+
+    auto reader2 = open(memStream1, options);
+    EXPECT_EQ(1, cache->getNumberOfHits());
+    EXPECT_EQ(1, cache->getNumberOfMisses());
+    EXPECT_EQ(10, reader2->getNumberOfRows());
+    EXPECT_EQ(reader1->getFileLength(), reader2->getFileLength());
+    EXPECT_EQ(reader1->getFilePostscriptLength(), reader2->getFilePostscriptLength());
+    EXPECT_EQ(reader1->getSerializedFileTail(), reader2->getSerializedFileTail());
+    EXPECT_EQ(1, reader2->getNumberOfStripeStatistics());
+    EXPECT_EQ(9, dynamic_cast<const IntegerColumnStatistics&>(
+                     *reader2->getStripeStatistics(0)->getColumnStatistics(1))
+                     .getMaximum());
+    auto rowReader = reader2->createRowReader();
+    auto batch = rowReader->createRowBatch(100);
+    EXPECT_TRUE(rowReader->next(*batch));
+    EXPECT_EQ(10, batch->numElements);
+
+    // files with another length or version are cached separately
+    auto reader3 = open(memStream2, options);
+    EXPECT_EQ(1000, reader3->getNumberOfRows());
+    options.setFileTailCacheVersion("2");
+    auto reader4 = open(memStream1, options);
+    EXPECT_EQ(10, reader4->getNumberOfRows());
+    EXPECT_EQ(1, cache->getNumberOfHits());
+    EXPECT_EQ(3, cache->getNumberOfMisses());
+    EXPECT_EQ(3, cache->getNumberOfEntries());
+    EXPECT_EQ(0, cache->getNumberOfEvictions());
+
+    // a serialized file tail bypasses the cache
+    ReaderOptions tailOptions;
+    tailOptions.setFileTailCache(cache).setSerializedFileTail(reader1->getSerializedFileTail());
+    open(memStream1, tailOptions);
+    EXPECT_EQ(1, cache->getNumberOfHits());
+    EXPECT_EQ(3, cache->getNumberOfMisses());
+
+    cache->clear();
+    EXPECT_EQ(0, cache->getNumberOfEntries());
+    EXPECT_EQ(0, cache->getMemoryUsage());
+  }
+
+  TEST(TestReader, fileTailCacheEviction) {
+    MemoryOutputStream memStream1(DEFAULT_MEM_STREAM_SIZE);
+    MemoryOutputStream memStream2(DEFAULT_MEM_STREAM_SIZE);
+    writeLongFile(memStream1, 10);
+    writeLongFile(memStream2, 1000);
+    auto open = [](const MemoryOutputStream& memStream, const ReaderOptions& options) {
+      return createReader(
+          std::make_unique<MemoryInputStream>(memStream.getData(), memStream.getLength()),
+          options);
+    };
+
+    uint64_t footerUsage;
+    {
+      std::shared_ptr<FileTailCache> cache = createFileTailCache(1024 * 1024);
+      open(memStream2, ReaderOptions().setFileTailCache(cache));
+      footerUsage = cache->getMemoryUsage();
+    }
+
+    // room for a single tail
+    std::shared_ptr<FileTailCache> cache = createFileTailCache(footerUsage + 1);
+    ReaderOptions options;
+    options.setFileTailCache(cache);
+    open(memStream1, options);
+    open(memStream2, options);
+    EXPECT_EQ(1, cache->getNumberOfEntries());
+    EXPECT_EQ(1, cache->getNumberOfEvictions());
+    open(memStream2, options);
+    EXPECT_EQ(1, cache->getNumberOfHits());
+    open(memStream1, options);
+    EXPECT_EQ(3, cache->getNumberOfMisses());
+    EXPECT_EQ(2, cache->getNumberOfEvictions());
+    EXPECT_LE(cache->getMemoryUsage(), cache->getMemoryLimit());
+
+    EXPECT_THROW(createFileTailCache(0), InvalidArgument);
+  }
 }  // namespace orc
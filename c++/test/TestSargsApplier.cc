@@ -16,6 +16,7 @@
  * limitations under the License.
  */
 
+#include "BloomFilter.hh"
 #include "sargs/SargsApplier.hh"
 #include "wrap/gtest-wrapper.h"
 
@@ -105,6 +106,100 @@ namespace orc {
     EXPECT_EQ(metrics.EvaluatedRowGroupCount.load(), 4);
   }
 
+  TEST(TestSargsApplier, testPickRowGroupsAcrossStripes) {
+    auto type = std::unique_ptr<Type>(Type::buildTypeFromString("struct<x:int,y:int>"));
+    auto sarg = SearchArgumentFactory::newBuilder()
+                    ->startAnd()
+                    .equals("x", PredicateDataType::LONG, Literal(static_cast<int64_t>(100)))
+                    .equals("y", PredicateDataType::LONG, Literal(static_cast<int64_t>(10)))
+                    .end()
+                    .build();
+
+    ReaderMetrics metrics;
+    SargsApplier applier(*type, sarg.get(), 1000, WriterVersion_ORC_135, &metrics);
+
+    // first stripe has row indexes for both columns
+    {
+      std::unordered_map<uint64_t, proto::RowIndex> rowIndexes;
+      *rowIndexes[1].add_entry()->mutable_statistics() = createIntStats(0L, 10L);
+      *rowIndexes[1].add_entry()->mutable_statistics() = createIntStats(100L, 100L);
+      *rowIndexes[2].add_entry()->mutable_statistics() = createIntStats(10L, 10L);
+      *rowIndexes[2].add_entry()->mutable_statistics() = createIntStats(0L, 5L);
+      EXPECT_FALSE(applier.pickRowGroups(2000, rowIndexes, {}));
+      EXPECT_EQ(0, applier.getNextSkippedRows()[0]);
+      EXPECT_EQ(0, applier.getNextSkippedRows()[1]);
+    }
+
+    // second stripe only has a row index for x, so y must not be evaluated
+    // with the statistics left over from the first stripe
+    {
+      std::unordered_map<uint64_t, proto::RowIndex> rowIndexes;
+      *rowIndexes[1].add_entry()->mutable_statistics() = createIntStats(0L, 10L);
+      *rowIndexes[1].add_entry()->mutable_statistics() = createIntStats(100L, 100L);
+      EXPECT_TRUE(applier.pickRowGroups(2000, rowIndexes, {}));
+      EXPECT_EQ(0, applier.getNextSkippedRows()[0]);
+      EXPECT_EQ(2000, applier.getNextSkippedRows()[1]);
+    }
+    EXPECT_EQ(metrics.SelectedRowGroupCount.load(), 1);
+    EXPECT_EQ(metrics.EvaluatedRowGroupCount.load(), 4);
+  }
+
+  TEST(TestSargsApplier, testPickRowGroupsWithBloomFilters) {
+    auto type = std::unique_ptr<Type>(Type::buildTypeFromString("struct<x:int,y:int>"));
+    auto sarg = SearchArgumentFactory::newBuilder()
+                    ->startAnd()
+                    .equals("x", PredicateDataType::LONG, Literal(static_cast<int64_t>(100)))
+                    .lessThan("y", PredicateDataType::LONG, Literal(static_cast<int64_t>(10)))
+                    .end()
+                    .build();
+
+    std::unordered_map<uint64_t, proto::RowIndex> rowIndexes;
+    *rowIndexes[1].add_entry()->mutable_statistics() = createIntStats(0L, 10L);
+    *rowIndexes[1].add_entry()->mutable_statistics() = createIntStats(50L, 150L);
+    *rowIndexes[1].add_entry()->mutable_statistics() = createIntStats(50L, 150L);
+    *rowIndexes[1].add_entry()->mutable_statistics() = createIntStats(50L, 150L);
+    *rowIndexes[2].add_entry()->mutable_statistics() = createIntStats(0L, 5L);
+    *rowIndexes[2].add_entry()->mutable_statistics() = createIntStats(0L, 5L);
+    *rowIndexes[2].add_entry()->mutable_statistics() = createIntStats(20L, 30L);
+    *rowIndexes[2].add_entry()->mutable_statistics() = createIntStats(0L, 5L);
+
+    // every bloom filter of x but the one of row group 3 has 100
+    std::map<uint32_t, BloomFilterIndex> bloomFilters;
+    for (int64_t rowGroup = 0; rowGroup != 4; ++rowGroup) {
+      auto bloomFilter = std::make_shared<BloomFilterImpl>(100);
+      bloomFilter->addLong(rowGroup == 3 ? 101 : 100);
+      bloomFilters[1].entries.push_back(bloomFilter);
+    }
+
+    ReaderMetrics metrics;
+    SargsApplier applier(*type, sarg.get(), 1000, WriterVersion_ORC_135, &metrics);
+    EXPECT_TRUE(applier.needsBloomFilter(1));
+    EXPECT_FALSE(applier.needsBloomFilter(2));
+
+    // min/max statistics only select row groups 1 and 3, their result is
+    // reused and the bloom filter of x rejects row group 3
+    for (int stripe = 0; stripe != 2; ++stripe) {
+      if (stripe == 0) {
+        EXPECT_TRUE(applier.needsBloomFilters(4000, rowIndexes));
+      }
+      EXPECT_TRUE(applier.pickRowGroups(4000, rowIndexes, bloomFilters));
+      const auto& nextSkippedRows = applier.getNextSkippedRows();
+      EXPECT_EQ(0, nextSkippedRows[0]);
+      EXPECT_EQ(2000, nextSkippedRows[1]);
+      EXPECT_EQ(0, nextSkippedRows[2]);
+      EXPECT_EQ(0, nextSkippedRows[3]);
+    }
+    EXPECT_EQ(metrics.SelectedRowGroupCount.load(), 2);
+    EXPECT_EQ(metrics.EvaluatedRowGroupCount.load(), 8);
+
+    // min/max statistics reject every row group of a stripe with y >= 20
+    for (auto& entry : *rowIndexes[2].mutable_entry()) {
+      *entry.mutable_statistics() = createIntStats(20L, 30L);
+    }
+    EXPECT_FALSE(applier.needsBloomFilters(4000, rowIndexes));
+    EXPECT_FALSE(applier.pickRowGroups(4000, rowIndexes, {}));
+  }
+
   TEST(TestSargsApplier, testStripeAndFileStats) {
     auto type = std::unique_ptr<Type>(Type::buildTypeFromString("struct<x:int,y:int>"));
     auto sarg = SearchArgumentFactory::newBuilder()
@@ -113,6 +113,14 @@ namespace orc {
       }
     }
 
+    // conversion from string/char/varchar to numeric
+    for (size_t i = 7; i <= 11; i++) {
+      for (size_t j = 0; j <= 6; j++) {
+        canConvert[i][j] = true;
+        needConvert[i][j] = true;
+      }
+    }
+
     // conversion from decimal to numeric
     for (size_t i = 12; i <= 13; i++) {
       for (size_t j = 0; j <= 6; j++) {
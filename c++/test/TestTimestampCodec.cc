@@ -0,0 +1,112 @@
+/**
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "TimestampCodec.hh"
+
+#include "wrap/gtest-wrapper.h"
+
+#include <vector>
+
+namespace orc {
+
+  static const int64_t EPOCH = 1420070400;
+
+  // the nanoseconds of the values of the tests, with all numbers of trailing
+  // zeros
+  static std::vector<int64_t> sampleNanos(uint64_t numValues) {
+    std::vector<int64_t> nanos(numValues);
+    for (uint64_t i = 0; i < numValues; ++i) {
+      int64_t nano = static_cast<int64_t>((i * 7919 + 13) % 1000000000);
+      int64_t scale = 1;
+      for (uint64_t j = 0; j < i % 10; ++j) {
+        scale *= 10;
+      }
+      nanos[i] = nano / scale * scale;
+    }
+    return nanos;
+  }
+
+  TEST(TestTimestampCodec, encodeNanos) {
+    std::vector<int64_t> secs(7, 0);
+    std::vector<int64_t> nanos = {0, 1, 10, 100, 1000, 100000000, 999999990};
+    encodeTimestamps(secs.data(), nanos.data(), 0, nullptr, nanos.size());
+    EXPECT_EQ(0, nanos[0]);
+    EXPECT_EQ(1 << 3, nanos[1]);
+    EXPECT_EQ(10 << 3, nanos[2]);
+    EXPECT_EQ(1 << 3 | 1, nanos[3]);
+    EXPECT_EQ(0x0a, nanos[4]);
+    EXPECT_EQ(1 << 3 | 7, nanos[5]);
+    EXPECT_EQ(int64_t(999999990) << 3, nanos[6]);
+  }
+
+  TEST(TestTimestampCodec, roundTrip) {
+    for (uint64_t numValues : {0, 1, 7, 8, 9, 64, 1027}) {
+      std::vector<int64_t> nanos = sampleNanos(numValues);
+      std::vector<int64_t> secs(numValues);
+      for (uint64_t i = 0; i < numValues; ++i) {
+        secs[i] = (static_cast<int64_t>(i) - 500) * 86399;
+      }
+      std::vector<int64_t> encodedSecs = secs;
+      std::vector<int64_t> encodedNanos = nanos;
+      encodeTimestamps(encodedSecs.data(), encodedNanos.data(), EPOCH, nullptr, numValues);
+
+      std::vector<int64_t> decodedSecs = encodedSecs;
+      std::vector<int64_t> decodedNanos = encodedNanos;
+      decodeTimestamps(decodedSecs.data(), decodedNanos.data(), EPOCH, nullptr, numValues);
+      EXPECT_EQ(secs, decodedSecs);
+      EXPECT_EQ(nanos, decodedNanos);
+
+      decodedNanos = encodedNanos;
+      decodeNanos(decodedNanos.data(), nullptr, numValues);
+      EXPECT_EQ(nanos, decodedNanos);
+
+      decodedSecs = encodedSecs;
+      decodedNanos = encodedNanos;
+      decodeTimestampsDefault(decodedSecs.data(), decodedNanos.data(), EPOCH, nullptr, numValues);
+      EXPECT_EQ(secs, decodedSecs);
+      EXPECT_EQ(nanos, decodedNanos);
+    }
+  }
+
+  TEST(TestTimestampCodec, nulls) {
+    const uint64_t numValues = 1000;
+    std::vector<int64_t> nanos = sampleNanos(numValues);
+    std::vector<int64_t> secs(numValues);
+    std::vector<char> notNull(numValues);
+    for (uint64_t i = 0; i < numValues; ++i) {
+      secs[i] = (static_cast<int64_t>(i) - 300) * 3601;
+      notNull[i] = (i % 3 != 0 && i % 17 != 5);
+    }
+    std::vector<int64_t> encodedSecs = secs;
+    std::vector<int64_t> encodedNanos = nanos;
+    encodeTimestamps(encodedSecs.data(), encodedNanos.data(), EPOCH, notNull.data(), numValues);
+
+    std::vector<int64_t> decodedSecs = encodedSecs;
+    std::vector<int64_t> decodedNanos = encodedNanos;
+    decodeTimestamps(decodedSecs.data(), decodedNanos.data(), EPOCH, notNull.data(), numValues);
+    // null slots are left alone in both directions
+    EXPECT_EQ(secs, decodedSecs);
+    EXPECT_EQ(nanos, decodedNanos);
+    for (uint64_t i = 0; i < numValues; ++i) {
+      if (!notNull[i]) {
+        EXPECT_EQ(secs[i], encodedSecs[i]) << i;
+      }
+    }
+  }
+
+}  // namespace orc
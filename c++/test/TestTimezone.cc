@@ -18,10 +18,12 @@
 
 #include "Adaptor.hh"
 #include "Timezone.hh"
+#include "orc/OrcFile.hh"
 #include "wrap/gmock.h"
 #include "wrap/gtest-wrapper.h"
 
 #include <iostream>
+#include <thread>
 #include <vector>
 
 namespace orc {
@@ -359,6 +361,78 @@ namespace orc {
     EXPECT_EQ("EST", getVariantFromZone(*ny1, "1974-10-27 06:00:00"));
   }
 
+  TEST(TestTimezone, testConcurrentZoneCache) {
+    preloadTimezones({"America/Los_Angeles", "Asia/Shanghai"});
+    const Timezone* la = &getTimezoneByName("America/Los_Angeles");
+    const Timezone* sh = &getTimezoneByName("Asia/Shanghai");
+    std::vector<std::thread> threads;
+    std::vector<int> matches(8, 0);
+    for (size_t t = 0; t < matches.size(); ++t) {
+      threads.emplace_back([&, t]() {
+        for (int i = 0; i < 1000; ++i) {
+          matches[t] += &getTimezoneByName("America/Los_Angeles") == la &&
+                        &getTimezoneByName("Asia/Shanghai") == sh;
+        }
+      });
+    }
+    for (auto& thread : threads) {
+      thread.join();
+    }
+    for (int count : matches) {
+      EXPECT_EQ(1000, count);
+    }
+    EXPECT_THROW(preloadTimezones({"Nowhere/Missing"}), TimezoneError);
+  }
+
+  TEST(TestTimezone, testRegisterTimezone) {
+    const char* tzDir = std::getenv("TZDIR");
+    std::string filename = tzDir != nullptr ? tzDir : "/usr/share/zoneinfo";
+    std::unique_ptr<InputStream> file = readFile(filename + "/America/Los_Angeles");
+    std::vector<unsigned char> data(static_cast<size_t>(file->getLength()));
+    file->read(data.data(), data.size(), 0);
+    file = readFile(filename + "/America/New_York");
+    std::vector<unsigned char> otherData(static_cast<size_t>(file->getLength()));
+    file->read(otherData.data(), otherData.size(), 0);
+
+    EXPECT_THROW(getTimezoneByName("Test/Registered"), TimezoneError);
+    registerTimezone("Test/Registered", data);
+    const Timezone& registered = getTimezoneByName("Test/Registered");
+    EXPECT_EQ(&registered, &getTimezoneByName("Test/Registered"));
+    EXPECT_EQ("PST", getVariantFromZone(registered, "1974-01-06 09:59:59"));
+    EXPECT_EQ("PDT", getVariantFromZone(registered, "1974-01-06 10:00:00"));
+
+    // registering other data replaces the timezone, while the replaced one
+    // stays valid
+    registerTimezone("Test/Registered", otherData);
+    const Timezone& other = getTimezoneByName("Test/Registered");
+    EXPECT_NE(&registered, &other);
+    EXPECT_EQ("EST", getVariantFromZone(other, "1974-01-06 06:59:59"));
+    EXPECT_EQ("PDT", getVariantFromZone(registered, "1974-01-06 10:00:00"));
+
+    // registering the same data again reuses its timezone
+    registerTimezone("Test/Registered", data);
+    EXPECT_EQ(&registered, &getTimezoneByName("Test/Registered"));
+    registerTimezone("Test/Registered", otherData);
+    EXPECT_EQ(&other, &getTimezoneByName("Test/Registered"));
+
+    EXPECT_THROW(registerTimezone("Test/Corrupt", {'T', 'Z', 'i', 'f'}), TimezoneError);
+
+    // a registered timezone replaces the file of the same name only for
+    // lookups by name, whichever lookup comes first on the thread
+    registerTimezone("Pacific/Chatham", data);
+    const Timezone& byName = getTimezoneByName("Pacific/Chatham");
+    const Timezone& byFilename = getTimezoneByFilename(filename + "/Pacific/Chatham");
+    EXPECT_NE(&byName, &byFilename);
+    EXPECT_EQ("PST", getVariantFromZone(byName, "1974-01-06 09:59:59"));
+    EXPECT_NE("PST", getVariantFromZone(byFilename, "1974-01-06 09:59:59"));
+    registerTimezone("Pacific/Chatham", otherData);
+    EXPECT_EQ(&byFilename, &getTimezoneByFilename(filename + "/Pacific/Chatham"));
+    const Timezone& replaced = getTimezoneByName("Pacific/Chatham");
+    EXPECT_NE(&byFilename, &replaced);
+    EXPECT_NE(&byName, &replaced);
+    EXPECT_EQ("EST", getVariantFromZone(replaced, "1974-01-06 06:59:59"));
+  }
+
   TEST(TestTimezone, testGMTv1) {
     const char GMT[] =
         ("VFppZgAAAAAAAAAAAAAAAAAAAAAAAAABAAAAAQAAAA"
@@ -403,6 +477,25 @@ namespace orc {
     EXPECT_EQ(1699164000 + 8 * 3600, la->convertFromUTC(1699164000));
   }
 
+  TEST(TestTimezone, testVariantCache) {
+    for (const char* name : {"America/Los_Angeles", "Asia/Shanghai", "Europe/London", "GMT"}) {
+      const Timezone& zone = getTimezoneByName(name);
+      TimezoneVariantCache cache(zone);
+      // step through the past transitions and many years of the future rule
+      for (int64_t clk = -3000000000; clk < 6000000000; clk += 3600 * 29 + 13) {
+        int64_t start = 0;
+        int64_t end = 0;
+        const TimezoneVariant& variant = zone.getVariant(clk, &start, &end);
+        EXPECT_EQ(&zone.getVariant(clk), &variant) << name << " " << clk;
+        EXPECT_LE(start, clk) << name << " " << clk;
+        EXPECT_LT(clk, end) << name << " " << clk;
+        EXPECT_EQ(&variant, &zone.getVariant(start)) << name << " " << clk;
+        EXPECT_EQ(&variant, &zone.getVariant(end - 1)) << name << " " << clk;
+        EXPECT_EQ(&variant, &cache.getVariant(clk)) << name << " " << clk;
+      }
+    }
+  }
+
 #ifndef _MSC_VER
   TEST(TestTimezone, testMissingTZDB) {
     const char* tzDirBackup = std::getenv("TZDIR");
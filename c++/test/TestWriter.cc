@@ -1903,6 +1903,164 @@ namespace orc {
     testSetOutputBufferCapacity(1024 * 1024);
   }
 
+  // Write rows of doubles in batches of 1000.
+  static void writeDoubles(Writer& writer, uint64_t rows) {
+    std::unique_ptr<ColumnVectorBatch> batch = writer.createRowBatch(1000);
+    auto& structBatch = dynamic_cast<StructVectorBatch&>(*batch);
+    auto& doubleBatch = dynamic_cast<DoubleVectorBatch&>(*structBatch.fields[0]);
+    for (uint64_t i = 0; i < rows; i += 1000) {
+      for (uint64_t j = 0; j < 1000; ++j) {
+        doubleBatch.data[j] = static_cast<double>(i + j) * 1.5;
+      }
+      structBatch.numElements = doubleBatch.numElements = 1000;
+      writer.add(*batch);
+    }
+  }
+
+  static std::unique_ptr<Writer> createManagedWriter(const Type& type, OutputStream* stream,
+                                                     std::shared_ptr<MemoryManager> manager,
+                                                     uint64_t stripeSize,
+                                                     WriterMetrics* metrics) {
+    WriterOptions options;
+    options.setStripeSize(stripeSize);
+    options.setCompression(CompressionKind_NONE);
+    options.setMemoryManager(manager);
+    options.setWriterMetrics(metrics);
+    return createWriter(type, stream, options);
+  }
+
+  TEST(TestMemoryManager, registerWriters) {
+    std::shared_ptr<MemoryManager> manager = createMemoryManager(1024 * 1024);
+    EXPECT_EQ(1024 * 1024, manager->getMemoryBudget());
+    EXPECT_THROW(createMemoryManager(0), InvalidArgument);
+
+    // writers only work with the built-in manager
+    class CustomMemoryManager : public MemoryManager {
+     public:
+      uint64_t getMemoryBudget() const override {
+        return 0;
+      }
+      uint64_t getNumberOfWriters() const override {
+        return 0;
+      }
+      uint64_t getTotalEstimatedSize() const override {
+        return 0;
+      }
+    };
+    WriterOptions customOptions;
+    EXPECT_THROW(customOptions.setMemoryManager(std::make_shared<CustomMemoryManager>()),
+                 InvalidArgument);
+    EXPECT_EQ(nullptr, customOptions.getMemoryManager());
+
+    std::unique_ptr<Type> type(Type::buildTypeFromString("struct<col1:double>"));
+    MemoryOutputStream stream1(DEFAULT_MEM_STREAM_SIZE);
+    MemoryOutputStream stream2(DEFAULT_MEM_STREAM_SIZE);
+    std::unique_ptr<Writer> writer1 =
+        createManagedWriter(*type, &stream1, manager, 1024 * 1024, nullptr);
+    std::unique_ptr<Writer> writer2 =
+        createManagedWriter(*type, &stream2, manager, 1024 * 1024, nullptr);
+    EXPECT_EQ(2, manager->getNumberOfWriters());
+
+    // writers report their stripe sizes every 5000 rows
+    writeDoubles(*writer1, 4000);
+    EXPECT_EQ(0, manager->getTotalEstimatedSize());
+    writeDoubles(*writer1, 1000);
+    EXPECT_GT(manager->getTotalEstimatedSize(), 0);
+
+    writer1->close();
+    EXPECT_EQ(1, manager->getNumberOfWriters());
+    EXPECT_EQ(0, manager->getTotalEstimatedSize());
+
+    // a writer that is never closed unregisters when it is destroyed
+    writeDoubles(*writer2, 10000);
+    writer2.reset();
+    EXPECT_EQ(0, manager->getNumberOfWriters());
+    EXPECT_EQ(0, manager->getTotalEstimatedSize());
+  }
+
+  TEST(TestMemoryManager, scaleStripeSize) {
+    const uint64_t stripeSize = 1024 * 1024;
+    const uint64_t rows = 500000;
+    std::unique_ptr<Type> type(Type::buildTypeFromString("struct<col1:double>"));
+
+    // alone, the writer fills stripes of the configured size
+    MemoryOutputStream alone(DEFAULT_MEM_STREAM_SIZE);
+    WriterMetrics aloneMetrics;
+    std::shared_ptr<MemoryManager> manager = createMemoryManager(stripeSize);
+    std::unique_ptr<Writer> writer =
+        createManagedWriter(*type, &alone, manager, stripeSize, &aloneMetrics);
+    writeDoubles(*writer, rows);
+    writer->close();
+    EXPECT_EQ(0, aloneMetrics.EarlyStripeFlushCount.load());
+    EXPECT_EQ(0, aloneMetrics.ScaledStripeFlushCount.load());
+    std::unique_ptr<Reader> reader = createReader(
+        getDefaultPool(),
+        std::make_unique<MemoryInputStream>(alone.getData(), alone.getLength()));
+    uint64_t stripesAlone = reader->getNumberOfStripes();
+
+    // four writers sharing the same budget write stripes of a quarter of it
+    std::vector<std::unique_ptr<MemoryOutputStream>> streams;
+    std::vector<std::unique_ptr<Writer>> writers;
+    WriterMetrics metrics;
+    for (int i = 0; i < 4; ++i) {
+      streams.push_back(std::make_unique<MemoryOutputStream>(DEFAULT_MEM_STREAM_SIZE));
+      writers.push_back(
+          createManagedWriter(*type, streams.back().get(), manager, stripeSize, &metrics));
+    }
+    EXPECT_EQ(4, manager->getNumberOfWriters());
+    for (auto& w : writers) {
+      writeDoubles(*w, rows);
+    }
+    for (auto& w : writers) {
+      w->close();
+    }
+    EXPECT_GT(metrics.ScaledStripeFlushCount.load(), 0);
+    for (auto& stream : streams) {
+      reader = createReader(getDefaultPool(), std::make_unique<MemoryInputStream>(
+                                                  stream->getData(), stream->getLength()));
+      EXPECT_GE(reader->getNumberOfStripes(), 3 * stripesAlone);
+      EXPECT_EQ(rows, reader->getNumberOfRows());
+    }
+  }
+
+  TEST(TestMemoryManager, flushLargestWriter) {
+    const uint64_t budget = 1024 * 1024;
+    std::unique_ptr<Type> type(Type::buildTypeFromString("struct<col1:double>"));
+    std::shared_ptr<MemoryManager> manager = createMemoryManager(budget);
+
+    // buffer most of the budget in a writer that is alone
+    MemoryOutputStream largeStream(DEFAULT_MEM_STREAM_SIZE);
+    WriterMetrics largeMetrics;
+    std::unique_ptr<Writer> large =
+        createManagedWriter(*type, &largeStream, manager, budget, &largeMetrics);
+    writeDoubles(*large, 80000);
+    EXPECT_EQ(0, largeMetrics.EarlyStripeFlushCount.load());
+
+    // a second writer pushes the total over the budget without reaching its
+    // own scaled stripe size, so the large writer writes its stripe on its
+    // next add
+    MemoryOutputStream smallStream(DEFAULT_MEM_STREAM_SIZE);
+    WriterMetrics smallMetrics;
+    std::unique_ptr<Writer> small =
+        createManagedWriter(*type, &smallStream, manager, budget, &smallMetrics);
+    writeDoubles(*small, 25000);
+    EXPECT_GT(manager->getTotalEstimatedSize(), budget);
+    EXPECT_EQ(0, smallMetrics.EarlyStripeFlushCount.load());
+    writeDoubles(*large, 1000);
+    EXPECT_EQ(1, largeMetrics.EarlyStripeFlushCount.load());
+    EXPECT_EQ(0, largeMetrics.ScaledStripeFlushCount.load());
+    EXPECT_LT(manager->getTotalEstimatedSize(), budget / 2);
+
+    large->close();
+    small->close();
+    std::unique_ptr<Reader> reader = createReader(
+        getDefaultPool(),
+        std::make_unique<MemoryInputStream>(largeStream.getData(), largeStream.getLength()));
+    EXPECT_EQ(1, reader->getNumberOfStripes());
+    EXPECT_EQ(81000, reader->getNumberOfRows());
+  }
+
+
   TEST_P(WriterTest, testWriteFixedWidthNumericVectorBatch) {
     MemoryOutputStream memStream(DEFAULT_MEM_STREAM_SIZE);
     MemoryPool* pool = getDefaultPool();
@@ -2191,6 +2349,399 @@ namespace orc {
     }
   }
 
+  // Write and read back strings through OffsetStringVectorBatch.
+  static void testOffsetStringVector(bool enableDictionary) {
+    MemoryOutputStream memStream(DEFAULT_MEM_STREAM_SIZE);
+    std::unique_ptr<Type> type(
+        Type::buildTypeFromString("struct<a:string,b:varchar(3),c:binary,d:array<char(2)>>"));
+    const uint64_t rows = 3000;
+    auto getValue = [](uint64_t row) { return std::to_string(row % 100); };
+    {
+      WriterOptions options;
+      options.setDictionaryKeySizeThreshold(enableDictionary ? 1.0 : 0.0);
+      options.setRowIndexStride(1000);
+      auto writer = createWriter(*type, &memStream, options);
+      auto batch = type->createRowBatch(rows, *getDefaultPool(), false, false, true);
+      auto& structBatch = dynamic_cast<StructVectorBatch&>(*batch);
+      auto& lists = dynamic_cast<ListVectorBatch&>(*structBatch.fields[3]);
+      lists.elements->resize(rows);
+      std::vector<OffsetStringVectorBatch*> columns = {
+          dynamic_cast<OffsetStringVectorBatch*>(structBatch.fields[0]),
+          dynamic_cast<OffsetStringVectorBatch*>(structBatch.fields[1]),
+          dynamic_cast<OffsetStringVectorBatch*>(structBatch.fields[2]),
+          dynamic_cast<OffsetStringVectorBatch*>(lists.elements.get())};
+      for (OffsetStringVectorBatch* column : columns) {
+        ASSERT_NE(nullptr, column);
+        std::string blob;
+        column->offsets[0] = 0;
+        for (uint64_t i = 0; i < rows; ++i) {
+          column->notNull[i] = i % 7 != 0;
+          if (column->notNull[i]) {
+            blob += getValue(i);
+          }
+          column->offsets[i + 1] = static_cast<int64_t>(blob.size());
+        }
+        column->blob.resize(blob.size());
+        memcpy(column->blob.data(), blob.data(), blob.size());
+        column->hasNulls = true;
+        column->numElements = rows;
+      }
+      for (uint64_t i = 0; i <= rows; ++i) {
+        lists.offsets[i] = static_cast<int64_t>(i);
+      }
+      structBatch.numElements = lists.numElements = rows;
+      writer->add(*batch);
+      writer->close();
+    }
+
+    auto inStream = std::make_unique<MemoryInputStream>(memStream.getData(), memStream.getLength());
+    std::unique_ptr<Reader> reader = createReader(getDefaultPool(), std::move(inStream));
+    EXPECT_EQ(enableDictionary,
+              reader->getStripe(0)->getColumnEncoding(1) == ColumnEncodingKind_DICTIONARY_V2);
+    for (bool lazyDecoding : {false, true}) {
+      RowReaderOptions rowReaderOptions;
+      rowReaderOptions.setUseOffsetStringVector(true);
+      rowReaderOptions.setEnableLazyDecoding(lazyDecoding);
+      std::unique_ptr<RowReader> rowReader = reader->createRowReader(rowReaderOptions);
+      auto batch = rowReader->createRowBatch(700);
+      // skip the first row group to exercise seeking
+      rowReader->seekToRow(1000);
+      uint64_t row = 1000;
+      while (rowReader->next(*batch)) {
+        auto& structBatch = dynamic_cast<StructVectorBatch&>(*batch);
+        auto& lists = dynamic_cast<ListVectorBatch&>(*structBatch.fields[3]);
+        std::vector<const OffsetStringVectorBatch*> columns = {
+            dynamic_cast<OffsetStringVectorBatch*>(structBatch.fields[0]),
+            dynamic_cast<OffsetStringVectorBatch*>(structBatch.fields[1]),
+            dynamic_cast<OffsetStringVectorBatch*>(structBatch.fields[2]),
+            dynamic_cast<OffsetStringVectorBatch*>(lists.elements.get())};
+        for (uint64_t c = 0; c < columns.size(); ++c) {
+          const OffsetStringVectorBatch* column = columns[c];
+          ASSERT_NE(nullptr, column);
+          for (uint64_t i = 0; i < batch->numElements; ++i) {
+            uint64_t listOffset = static_cast<uint64_t>(lists.offsets[0]);
+            uint64_t index = c == 3 ? static_cast<uint64_t>(lists.offsets[i]) - listOffset : i;
+            bool isNull = (row + i) % 7 == 0;
+            EXPECT_EQ(!isNull, column->notNull[index] != 0);
+            std::string expected = isNull ? "" : getValue(row + i);
+            if (c == 3 && !isNull) {
+              // chars are padded
+              expected.resize(2, ' ');
+            }
+            EXPECT_EQ(expected, std::string(column->getValue(index),
+                                            static_cast<size_t>(column->getLength(index))));
+          }
+        }
+        row += batch->numElements;
+      }
+      EXPECT_EQ(rows, row);
+    }
+  }
+
+  TEST(WriterTest, offsetStringVector) {
+    testOffsetStringVector(false);
+    testOffsetStringVector(true);
+  }
+
+  TEST(WriterTest, encodedStringVector) {
+    std::unique_ptr<Type> type(
+        Type::buildTypeFromString("struct<a:string,b:varchar(2),c:array<string>>"));
+    const uint64_t rows = 5000;
+    auto getValue = [](uint64_t row) { return "value" + std::to_string(row % 37); };
+    auto isNull = [](uint64_t row) { return row % 13 == 0; };
+    MemoryOutputStream source(DEFAULT_MEM_STREAM_SIZE);
+    {
+      WriterOptions options;
+      options.setDictionaryKeySizeThreshold(1.0);
+      auto writer = createWriter(*type, &source, options);
+      auto batch = writer->createRowBatch(rows);
+      auto& structBatch = dynamic_cast<StructVectorBatch&>(*batch);
+      auto& lists = dynamic_cast<ListVectorBatch&>(*structBatch.fields[2]);
+      std::vector<StringVectorBatch*> columns = {
+          dynamic_cast<StringVectorBatch*>(structBatch.fields[0]),
+          dynamic_cast<StringVectorBatch*>(structBatch.fields[1]),
+          dynamic_cast<StringVectorBatch*>(lists.elements.get())};
+      std::vector<std::string> values(rows);
+      for (uint64_t i = 0; i < rows; ++i) {
+        values[i] = getValue(i);
+        for (StringVectorBatch* column : columns) {
+          column->notNull[i] = !isNull(i);
+          column->data[i] = const_cast<char*>(values[i].c_str());
+          column->length[i] = static_cast<int64_t>(values[i].size());
+        }
+        lists.offsets[i + 1] = static_cast<int64_t>(i + 1);
+      }
+      for (StringVectorBatch* column : columns) {
+        column->hasNulls = true;
+        column->numElements = rows;
+      }
+      structBatch.numElements = lists.numElements = rows;
+      writer->add(*batch);
+      writer->close();
+    }
+
+    // copy the file through batches that keep the dictionaries
+    MemoryOutputStream copy(DEFAULT_MEM_STREAM_SIZE);
+    {
+      auto inStream = std::make_unique<MemoryInputStream>(source.getData(), source.getLength());
+      std::unique_ptr<Reader> reader = createReader(getDefaultPool(), std::move(inStream));
+      RowReaderOptions rowReaderOptions;
+      rowReaderOptions.setEnableLazyDecoding(true);
+      std::unique_ptr<RowReader> rowReader = reader->createRowReader(rowReaderOptions);
+      WriterOptions options;
+      options.setDictionaryKeySizeThreshold(1.0).setRowIndexStride(1000);
+      auto writer = createWriter(*type, &copy, options);
+      auto batch = rowReader->createRowBatch(1500);
+      while (rowReader->next(*batch)) {
+        auto& structBatch = dynamic_cast<StructVectorBatch&>(*batch);
+        EXPECT_TRUE(structBatch.fields[0]->isEncoded);
+        writer->add(*batch);
+      }
+      writer->close();
+    }
+
+    std::unique_ptr<Reader> expected =
+        createReader(getDefaultPool(),
+                     std::make_unique<MemoryInputStream>(source.getData(), source.getLength()));
+    std::unique_ptr<Reader> actual = createReader(
+        getDefaultPool(), std::make_unique<MemoryInputStream>(copy.getData(), copy.getLength()));
+    EXPECT_EQ(rows, actual->getNumberOfRows());
+    for (uint32_t column = 1; column < 5; ++column) {
+      EXPECT_EQ(expected->getColumnStatistics(column)->toString(),
+                actual->getColumnStatistics(column)->toString());
+    }
+    EXPECT_EQ(ColumnEncodingKind_DICTIONARY_V2, actual->getStripe(0)->getColumnEncoding(1));
+    std::unique_ptr<RowReader> rowReader = actual->createRowReader(RowReaderOptions());
+    auto batch = rowReader->createRowBatch(rows);
+    ASSERT_TRUE(rowReader->next(*batch));
+    auto& structBatch = dynamic_cast<StructVectorBatch&>(*batch);
+    auto& lists = dynamic_cast<ListVectorBatch&>(*structBatch.fields[2]);
+    std::vector<StringVectorBatch*> columns = {
+        dynamic_cast<StringVectorBatch*>(structBatch.fields[0]),
+        dynamic_cast<StringVectorBatch*>(structBatch.fields[1]),
+        dynamic_cast<StringVectorBatch*>(lists.elements.get())};
+    for (uint64_t c = 0; c < columns.size(); ++c) {
+      for (uint64_t i = 0; i < rows; ++i) {
+        ASSERT_EQ(!isNull(i), columns[c]->notNull[i] != 0);
+        if (!isNull(i)) {
+          std::string value = c == 1 ? getValue(i).substr(0, 2) : getValue(i);
+          EXPECT_EQ(value, std::string(columns[c]->data[i],
+                                       static_cast<size_t>(columns[c]->length[i])));
+        }
+      }
+    }
+  }
+
+  // appends the value to the dictionary and returns its id
+  static int32_t appendToDictionary(StringDictionary& dictionary, const std::string& value) {
+    uint64_t count = dictionary.dictionaryOffset.size();
+    uint64_t start = count == 0 ? 0 : static_cast<uint64_t>(dictionary.dictionaryOffset[count - 1]);
+    if (count == 0) {
+      dictionary.dictionaryOffset.resize(1);
+      dictionary.dictionaryOffset[0] = 0;
+      count = 1;
+    }
+    dictionary.dictionaryBlob.resize(start + value.size());
+    memcpy(dictionary.dictionaryBlob.data() + start, value.data(), value.size());
+    dictionary.dictionaryOffset.resize(count + 1);
+    dictionary.dictionaryOffset[count] = static_cast<int64_t>(start + value.size());
+    return static_cast<int32_t>(count - 1);
+  }
+
+  TEST(WriterTest, encodedStringVectorGrowingDictionary) {
+    std::unique_ptr<Type> type(Type::buildTypeFromString("struct<a:string>"));
+    MemoryOutputStream memStream(DEFAULT_MEM_STREAM_SIZE);
+    MemoryPool* pool = getDefaultPool();
+    WriterOptions options;
+    options.setDictionaryKeySizeThreshold(1.0);
+    auto writer = createWriter(*type, &memStream, options);
+
+    StructVectorBatch structBatch(4, *pool);
+    auto* encoded = new EncodedStringVectorBatch(4, *pool);
+    structBatch.fields.push_back(encoded);
+    encoded->isEncoded = true;
+    encoded->dictionary = std::make_shared<StringDictionary>(*pool);
+    StringDictionary& dictionary = *encoded->dictionary;
+
+    std::vector<std::string> expected;
+    appendToDictionary(dictionary, "b");
+    appendToDictionary(dictionary, "a");
+    for (int32_t id : {0, 1, 1, 0}) {
+      encoded->index[expected.size()] = id;
+      expected.push_back(id == 0 ? "b" : "a");
+    }
+    structBatch.numElements = encoded->numElements = 4;
+    writer->add(structBatch);
+
+    // the second batch uses entries appended to the same dictionary
+    int32_t c = appendToDictionary(dictionary, "c");
+    int32_t d = appendToDictionary(dictionary, "d");
+    const int32_t ids[] = {d, c, 0, d};
+    for (uint64_t i = 0; i < 4; ++i) {
+      encoded->index[i] = ids[i];
+      expected.push_back(ids[i] == c ? "c" : ids[i] == d ? "d" : "b");
+    }
+    writer->add(structBatch);
+    writer->close();
+
+    std::unique_ptr<Reader> reader = createReader(
+        pool, std::make_unique<MemoryInputStream>(memStream.getData(), memStream.getLength()));
+    EXPECT_EQ(ColumnEncodingKind_DICTIONARY_V2, reader->getStripe(0)->getColumnEncoding(1));
+    std::unique_ptr<ColumnStatistics> columnStats = reader->getColumnStatistics(1);
+    auto* stats = dynamic_cast<const StringColumnStatistics*>(columnStats.get());
+    ASSERT_NE(nullptr, stats);
+    EXPECT_EQ("a", stats->getMinimum());
+    EXPECT_EQ("d", stats->getMaximum());
+    std::unique_ptr<RowReader> rowReader = reader->createRowReader(RowReaderOptions());
+    auto batch = rowReader->createRowBatch(expected.size());
+    ASSERT_TRUE(rowReader->next(*batch));
+    auto& strings = dynamic_cast<StringVectorBatch&>(
+        *dynamic_cast<StructVectorBatch&>(*batch).fields[0]);
+    ASSERT_EQ(expected.size(), strings.numElements);
+    for (uint64_t i = 0; i < expected.size(); ++i) {
+      EXPECT_EQ(expected[i],
+                std::string(strings.data[i], static_cast<size_t>(strings.length[i])));
+    }
+  }
+
+  TEST(WriterTest, notNullBitmap) {
+    MemoryOutputStream memStream(DEFAULT_MEM_STREAM_SIZE);
+    std::unique_ptr<Type> type(
+        Type::buildTypeFromString("struct<a:bigint,b:array<string>,c:struct<d:double>>"));
+    const uint64_t rows = 3000;
+    auto aIsNull = [](uint64_t row) { return row % 3 == 0; };
+    auto bIsNull = [](uint64_t row) { return row % 5 == 0; };
+    auto elementIsNull = [](uint64_t row) { return row % 4 == 1; };
+    auto cIsNull = [](uint64_t row) { return row % 11 == 0; };
+    auto dIsNull = [](uint64_t row) { return row % 2 == 0; };
+    auto setNotNull = [](ColumnVectorBatch& batch, uint64_t index, bool notNull) {
+      if (notNull) {
+        batch.notNullBitmap[index / 64] |= uint64_t(1) << (index % 64);
+      } else {
+        batch.notNullBitmap[index / 64] &= ~(uint64_t(1) << (index % 64));
+        batch.hasNulls = true;
+      }
+    };
+    {
+      WriterOptions options;
+      options.setRowIndexStride(1000);
+      auto writer = createWriter(*type, &memStream, options);
+      auto batch = type->createRowBatch(rows, *getDefaultPool());
+      batch->enableNotNullBitmap();
+      EXPECT_EQ(0, batch->notNull.capacity());
+      auto& structBatch = dynamic_cast<StructVectorBatch&>(*batch);
+      auto& longs = dynamic_cast<LongVectorBatch&>(*structBatch.fields[0]);
+      auto& lists = dynamic_cast<ListVectorBatch&>(*structBatch.fields[1]);
+      auto& strings = dynamic_cast<StringVectorBatch&>(*lists.elements);
+      auto& structs = dynamic_cast<StructVectorBatch&>(*structBatch.fields[2]);
+      auto& doubles = dynamic_cast<DoubleVectorBatch&>(*structs.fields[0]);
+      strings.resize(rows);
+      std::vector<std::string> values(rows);
+      lists.offsets[0] = 0;
+      for (uint64_t i = 0; i < rows; ++i) {
+        setNotNull(longs, i, !aIsNull(i));
+        longs.data[i] = static_cast<int64_t>(i);
+        setNotNull(lists, i, !bIsNull(i));
+        lists.offsets[i + 1] = lists.offsets[i] + (bIsNull(i) ? 0 : 1);
+        if (!bIsNull(i)) {
+          uint64_t index = static_cast<uint64_t>(lists.offsets[i]);
+          values[index] = std::to_string(i);
+          setNotNull(strings, index, !elementIsNull(i));
+          strings.data[index] = const_cast<char*>(values[index].c_str());
+          strings.length[index] = static_cast<int64_t>(values[index].size());
+        }
+        setNotNull(structs, i, !cIsNull(i));
+        setNotNull(doubles, i, !cIsNull(i) && !dIsNull(i));
+        doubles.data[i] = static_cast<double>(i);
+      }
+      strings.numElements = static_cast<uint64_t>(lists.offsets[rows]);
+      structBatch.numElements = longs.numElements = lists.numElements = rows;
+      structs.numElements = doubles.numElements = rows;
+      writer->add(*batch);
+      writer->close();
+    }
+
+    auto inStream = std::make_unique<MemoryInputStream>(memStream.getData(), memStream.getLength());
+    std::unique_ptr<Reader> reader = createReader(getDefaultPool(), std::move(inStream));
+    RowReaderOptions rowReaderOptions;
+    rowReaderOptions.setUseNotNullBitmap(true);
+    std::unique_ptr<RowReader> rowReader = reader->createRowReader(rowReaderOptions);
+    auto batch = rowReader->createRowBatch(700);
+    EXPECT_TRUE(batch->useNotNullBitmap);
+    // skip the first row group to exercise seeking
+    rowReader->seekToRow(1000);
+    uint64_t row = 1000;
+    while (rowReader->next(*batch)) {
+      auto& structBatch = dynamic_cast<StructVectorBatch&>(*batch);
+      auto& longs = dynamic_cast<LongVectorBatch&>(*structBatch.fields[0]);
+      auto& lists = dynamic_cast<ListVectorBatch&>(*structBatch.fields[1]);
+      auto& strings = dynamic_cast<StringVectorBatch&>(*lists.elements);
+      auto& structs = dynamic_cast<StructVectorBatch&>(*structBatch.fields[2]);
+      auto& doubles = dynamic_cast<DoubleVectorBatch&>(*structs.fields[0]);
+      EXPECT_EQ(0, longs.notNull.capacity());
+      uint64_t aNulls = 0;
+      for (uint64_t i = 0; i < batch->numElements; ++i) {
+        uint64_t r = row + i;
+        aNulls += aIsNull(r);
+        ASSERT_EQ(!aIsNull(r), longs.isNotNull(i)) << "Wrong null at " << r;
+        if (!aIsNull(r)) {
+          EXPECT_EQ(static_cast<int64_t>(r), longs.data[i]);
+        }
+        ASSERT_EQ(!bIsNull(r), lists.isNotNull(i)) << "Wrong null at " << r;
+        if (!bIsNull(r)) {
+          uint64_t index = static_cast<uint64_t>(lists.offsets[i] - lists.offsets[0]);
+          ASSERT_EQ(!elementIsNull(r), strings.isNotNull(index)) << "Wrong null at " << r;
+          if (!elementIsNull(r)) {
+            EXPECT_EQ(std::to_string(r),
+                      std::string(strings.data[index], static_cast<size_t>(strings.length[index])));
+          }
+        }
+        ASSERT_EQ(!cIsNull(r), structs.isNotNull(i)) << "Wrong null at " << r;
+        ASSERT_EQ(!cIsNull(r) && !dIsNull(r), doubles.isNotNull(i)) << "Wrong null at " << r;
+        if (doubles.isNotNull(i)) {
+          EXPECT_EQ(static_cast<double>(r), doubles.data[i]);
+        }
+      }
+      EXPECT_EQ(aNulls, longs.getNullCount());
+      row += batch->numElements;
+    }
+    EXPECT_EQ(rows, row);
+  }
+
+  TEST(WriterTest, truncatedStringStatistics) {
+    MemoryOutputStream memStream(DEFAULT_MEM_STREAM_SIZE);
+    std::unique_ptr<Type> type(Type::buildTypeFromString("struct<a:string>"));
+    std::vector<std::string> values = {std::string(100, 'm'), "b" + std::string(100, 'x'), "c"};
+    {
+      WriterOptions options;
+      options.setStringStatisticsMaxLength(8);
+      auto writer = createWriter(*type, &memStream, options);
+      auto batch = writer->createRowBatch(values.size());
+      auto& structBatch = dynamic_cast<StructVectorBatch&>(*batch);
+      auto& strings = dynamic_cast<StringVectorBatch&>(*structBatch.fields[0]);
+      for (size_t i = 0; i < values.size(); ++i) {
+        strings.data[i] = const_cast<char*>(values[i].c_str());
+        strings.length[i] = static_cast<int64_t>(values[i].size());
+      }
+      structBatch.numElements = strings.numElements = values.size();
+      writer->add(*batch);
+      writer->close();
+    }
+
+    auto inStream = std::make_unique<MemoryInputStream>(memStream.getData(), memStream.getLength());
+    std::unique_ptr<Reader> reader = createReader(getDefaultPool(), std::move(inStream));
+    std::unique_ptr<const ColumnStatistics> fileStats = reader->getColumnStatistics(1);
+    auto stripeStats = reader->getStripeStatistics(0);
+    for (const ColumnStatistics* stats : {fileStats.get(), stripeStats->getColumnStatistics(1)}) {
+      auto& strStats = dynamic_cast<const StringColumnStatistics&>(*stats);
+      EXPECT_FALSE(strStats.hasMinimum());
+      EXPECT_FALSE(strStats.hasMaximum());
+      EXPECT_EQ("bxxxxxxx", strStats.getLowerBound());
+      EXPECT_EQ("mmmmmmmn", strStats.getUpperBound());
+      EXPECT_EQ(202, strStats.getTotalLength());
+    }
+  }
+
   INSTANTIATE_TEST_SUITE_P(OrcTest, WriterTest,
                            Values(FileVersion::v_0_11(), FileVersion::v_0_12(),
                                   FileVersion::UNSTABLE_PRE_2_0()));
@@ -0,0 +1,73 @@
+/**
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "orc/DatasetIndex.hh"
+#include "orc/Exceptions.hh"
+
+#include <getopt.h>
+#include <iostream>
+#include <memory>
+#include <string>
+
+int main(int argc, char* argv[]) {
+  static struct option longOptions[] = {{"help", no_argument, nullptr, 'h'},
+                                        {nullptr, 0, nullptr, 0}};
+  bool helpFlag = false;
+  int opt;
+  do {
+    opt = getopt_long(argc, argv, "h", longOptions, nullptr);
+    switch (opt) {
+      case '?':
+      case 'h':
+        helpFlag = true;
+        opt = -1;
+        break;
+    }
+  } while (opt != -1);
+  argc -= optind;
+  argv += optind;
+
+  if (argc < 2 || helpFlag) {
+    std::cerr << "Usage: orc-index [-h] [--help] <index filename> <filenames>\n"
+              << "Build a dataset index from the statistics and bloom filters of ORC files\n";
+    exit(1);
+  }
+
+  try {
+    std::unique_ptr<orc::DatasetIndexBuilder> builder = orc::createDatasetIndexBuilder();
+    uint64_t stripes = 0;
+    for (int i = 1; i < argc; ++i) {
+      std::string filename = argv[i];
+      orc::ReaderOptions opts;
+      std::unique_ptr<orc::Reader> reader =
+          orc::createReader(orc::readFile(filename, opts.getReaderMetrics()), opts);
+      builder->addFile(filename, *reader);
+      stripes += reader->getNumberOfStripes();
+    }
+    std::unique_ptr<orc::OutputStream> outStream = orc::writeLocalFile(argv[0]);
+    builder->write(*outStream);
+    outStream->close();
+    std::cout << "Indexed " << builder->getNumberOfFiles() << " files with " << stripes
+              << " stripes into " << argv[0] << std::endl;
+  } catch (std::exception& ex) {
+    std::cerr << "Caught exception: " << ex.what() << "\n";
+    return 1;
+  }
+
+  return 0;
+}
@@ -112,5 +112,7 @@ void printReaderMetrics(std::ostream& out, const orc::ReaderMetrics* metrics) {
     out << "IOCount: " << metrics->IOCount << std::endl;
     out << "PPD SelectedRowGroupCount: " << metrics->SelectedRowGroupCount << std::endl;
     out << "PPD EvaluatedRowGroupCount: " << metrics->EvaluatedRowGroupCount << std::endl;
+    out << "PPD SkippedIndexBytes: " << metrics->SkippedIndexBytes << std::endl;
+    out << "PeakMemoryBytes: " << metrics->PeakMemoryBytes << std::endl;
   }
 }
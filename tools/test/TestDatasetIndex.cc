@@ -0,0 +1,85 @@
+/**
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "orc/DatasetIndex.hh"
+#include "orc/OrcFile.hh"
+#include "orc/sargs/SearchArgument.hh"
+
+#include "ToolTest.hh"
+
+#include "wrap/gtest-wrapper.h"
+
+TEST(TestDatasetIndex, testBuildAndFindStripes) {
+  const std::string pgm = findProgram("tools/src/orc-index");
+  const std::string file1 = findExample("orc_split_elim.orc");
+  const std::string file2 = findExample("orc_index_int_string.orc");
+  const std::string indexFile = "/tmp/test_dataset_index.idx";
+  std::string output;
+  std::string error;
+
+  EXPECT_EQ(0, runProgram({pgm, indexFile, file1, file2}, output, error));
+  EXPECT_EQ("Indexed 2 files with 6 stripes into " + indexFile + "\n", output);
+  EXPECT_EQ("", error);
+
+  std::unique_ptr<orc::DatasetIndex> index = orc::readDatasetIndex(orc::readLocalFile(indexFile));
+  ASSERT_EQ(2, index->getNumberOfFiles());
+  EXPECT_EQ(file1, index->getFileName(0));
+  EXPECT_EQ(file2, index->getFileName(1));
+
+  // The minimum userid of the stripes of orc_split_elim.orc is 2, 13, 29, 70
+  // and 5. orc_index_int_string.orc has no userid column, so it can not be
+  // skipped.
+  auto sarg = orc::SearchArgumentFactory::newBuilder()
+                  ->lessThanEquals("userid", orc::PredicateDataType::LONG,
+                                   orc::Literal(static_cast<int64_t>(4)))
+                  .build();
+  std::vector<orc::DatasetStripe> stripes = index->findStripes(*sarg);
+  ASSERT_EQ(2, stripes.size());
+  EXPECT_EQ(0, stripes[0].fileIndex);
+  EXPECT_EQ(0, stripes[0].stripeIndex);
+  EXPECT_EQ(5000, stripes[0].numberOfRows);
+  EXPECT_EQ(1, stripes[1].fileIndex);
+  EXPECT_EQ(0, stripes[1].stripeIndex);
+
+  // the stripe can be read without reading the file tail again
+  orc::ReaderOptions readerOpts;
+  readerOpts.setSerializedFileTail(index->getSerializedFileTail(0));
+  std::unique_ptr<orc::Reader> reader =
+      orc::createReader(orc::readLocalFile(index->getFileName(0)), readerOpts);
+  EXPECT_EQ(stripes[0].offset, reader->getStripe(0)->getOffset());
+  EXPECT_EQ(stripes[0].length, reader->getStripe(0)->getLength());
+
+  // no file has userid smaller than 2
+  sarg = orc::SearchArgumentFactory::newBuilder()
+             ->startAnd()
+             .lessThan("userid", orc::PredicateDataType::LONG,
+                       orc::Literal(static_cast<int64_t>(2)))
+             .lessThan("_col0", orc::PredicateDataType::LONG,
+                       orc::Literal(static_cast<int64_t>(0)))
+             .end()
+             .build();
+  EXPECT_TRUE(index->findStripes(*sarg).empty());
+}
+
+TEST(TestDatasetIndex, testUsage) {
+  const std::string pgm = findProgram("tools/src/orc-index");
+  std::string output;
+  std::string error;
+  EXPECT_EQ(1, runProgram({pgm, "/tmp/test_dataset_index_usage.idx"}, output, error));
+  EXPECT_NE(std::string::npos, error.find("Usage: orc-index"));
+}